@@ -0,0 +1,197 @@
+#include "ray.h"
+
+VALUE ray_cAtlas = Qnil;
+
+say_atlas *ray_rb2atlas(VALUE obj) {
+  if (!RAY_IS_A(obj, rb_path2class("Ray::Atlas"))) {
+    rb_raise(rb_eTypeError, "can't convert %s into Ray::Atlas",
+             RAY_OBJ_CLASSNAME(obj));
+  }
+
+  say_atlas *atlas = NULL;
+  Data_Get_Struct(obj, say_atlas, atlas);
+
+  return atlas;
+}
+
+static
+VALUE ray_atlas_alloc(VALUE self) {
+  say_atlas *atlas = say_atlas_create(2048, 2048);
+  VALUE rb = Data_Wrap_Struct(ray_cAtlas, NULL, say_atlas_free, atlas);
+
+  /* Lets images find the object to mark */
+  say_atlas_set_data(atlas, (void*)rb);
+
+  return rb;
+}
+
+/*
+ * @overload initialize(max_size = [2048, 2048])
+ *   @param [Vector2, #to_vector2] max_size Maximal size of a page. It is
+ *     reduced to the maximal size of a texture if needed.
+ */
+static
+VALUE ray_atlas_init(int argc, VALUE *argv, VALUE self) {
+  VALUE max_size = Qnil;
+  rb_scan_args(argc, argv, "01", &max_size);
+
+  if (!NIL_P(max_size)) {
+    say_atlas *atlas = ray_rb2atlas(self);
+    say_vector2 size = ray_convert_to_vector2(max_size);
+
+    if (size.x < 1 || size.y < 1)
+      rb_raise(rb_eArgError, "page size must be positive");
+
+    say_atlas_free(atlas);
+    DATA_PTR(self) = atlas = say_atlas_create(size.x, size.y);
+    say_atlas_set_data(atlas, (void*)self);
+  }
+
+  return self;
+}
+
+/*
+ * @overload add(img)
+ *   Packs an image into one of the pages of the atlas.
+ *
+ *   Sprites using this image are drawn from the page instead, which allows
+ *   sprites using different images to be batched. Changes to the image are
+ *   still taken into account.
+ *
+ *   @param [Ray::Image] img
+ *   @raise [RuntimeError] If the image doesn't fit in a page, or if it is
+ *     mipmapped.
+ */
+static
+VALUE ray_atlas_add(VALUE self, VALUE img) {
+  if (!say_atlas_add(ray_rb2atlas(self), ray_rb2image(img)))
+    rb_raise(rb_eRuntimeError, "%s", say_error_get_last());
+
+  return self;
+}
+
+/*
+ * @overload remove(img)
+ *   Makes an image use its own texture again. The space it used in its page
+ *   isn't reclaimed.
+ *
+ *   @param [Ray::Image] img
+ */
+static
+VALUE ray_atlas_remove(VALUE self, VALUE img) {
+  say_atlas_remove(ray_rb2atlas(self), ray_rb2image(img));
+  return self;
+}
+
+/*
+ * @overload include?(img)
+ *   @param [Ray::Image] img
+ *   @return [true, false] True if the image is packed in this atlas
+ */
+static
+VALUE ray_atlas_contains(VALUE self, VALUE img) {
+  return say_atlas_contains(ray_rb2atlas(self), ray_rb2image(img)) ?
+    Qtrue : Qfalse;
+}
+
+/* @return [Integer] Amount of images packed into this atlas */
+static
+VALUE ray_atlas_size(VALUE self) {
+  return ULONG2NUM(say_atlas_get_size(ray_rb2atlas(self)));
+}
+
+/* @return [Integer] Amount of pages used by this atlas */
+static
+VALUE ray_atlas_page_count(VALUE self) {
+  return ULONG2NUM(say_atlas_get_page_count(ray_rb2atlas(self)));
+}
+
+/*
+ * @overload page(id)
+ *   @param [Integer] id
+ *   @return [Ray::Image, nil] The image containing a page of the atlas. It is
+ *     only valid as long as the atlas is.
+ */
+static
+VALUE ray_atlas_page(VALUE self, VALUE id) {
+  say_image *page = say_atlas_get_page(ray_rb2atlas(self), NUM2ULONG(id));
+  if (!page)
+    return Qnil;
+
+  VALUE rb = Data_Wrap_Struct(ray_cImage, NULL, NULL, page);
+  rb_iv_set(rb, "@atlas", self);
+  rb_obj_freeze(rb);
+
+  return rb;
+}
+
+/* @return [Integer] Space left around each image, in pixels */
+static
+VALUE ray_atlas_padding(VALUE self) {
+  return ULONG2NUM(say_atlas_get_padding(ray_rb2atlas(self)));
+}
+
+/*
+ * @overload padding=(val)
+ *   Sets the space left around images added from now on.
+ *   @param [Integer] val
+ */
+static
+VALUE ray_atlas_set_padding(VALUE self, VALUE val) {
+  say_atlas_set_padding(ray_rb2atlas(self), NUM2ULONG(val));
+  return val;
+}
+
+/* @return [true, false] True if pages use linear filtering */
+static
+VALUE ray_atlas_is_smooth(VALUE self) {
+  return say_atlas_is_smooth(ray_rb2atlas(self)) ? Qtrue : Qfalse;
+}
+
+/*
+ * @overload smooth=(val)
+ *   Enables or disables linear filtering for every page. Packed images use
+ *   this setting instead of their own.
+ *   @param [true, false] val
+ */
+static
+VALUE ray_atlas_set_smooth(VALUE self, VALUE val) {
+  say_atlas_set_smooth(ray_rb2atlas(self), RTEST(val));
+  return val;
+}
+
+/*
+ * Document-class: Ray::Atlas
+ *
+ * An atlas packs several images into a few large textures, called pages.
+ * Sprites using images packed in the same page can then be drawn in a single
+ * draw call.
+ *
+ * Pages grow up to their maximal size as images are added, and new pages are
+ * created once they are full. Texture coordinates of sprites are updated
+ * automatically.
+ *
+ * @example
+ *   atlas = Ray::Atlas.new
+ *   atlas << image_set["player.png"] << image_set["enemy.png"]
+ */
+void Init_ray_atlas() {
+  ray_cAtlas = rb_define_class_under(ray_mRay, "Atlas", rb_cObject);
+  rb_define_alloc_func(ray_cAtlas, ray_atlas_alloc);
+  rb_define_method(ray_cAtlas, "initialize", ray_atlas_init, -1);
+
+  rb_define_method(ray_cAtlas, "add", ray_atlas_add, 1);
+  rb_define_method(ray_cAtlas, "<<", ray_atlas_add, 1);
+  rb_define_method(ray_cAtlas, "remove", ray_atlas_remove, 1);
+  rb_define_method(ray_cAtlas, "include?", ray_atlas_contains, 1);
+
+  rb_define_method(ray_cAtlas, "size", ray_atlas_size, 0);
+  rb_define_method(ray_cAtlas, "page_count", ray_atlas_page_count, 0);
+  rb_define_method(ray_cAtlas, "page", ray_atlas_page, 1);
+
+  rb_define_method(ray_cAtlas, "padding", ray_atlas_padding, 0);
+  rb_define_method(ray_cAtlas, "padding=", ray_atlas_set_padding, 1);
+
+  rb_define_method(ray_cAtlas, "smooth?", ray_atlas_is_smooth, 0);
+  rb_define_method(ray_cAtlas, "smooth=", ray_atlas_set_smooth, 1);
+}
@@ -57,6 +57,31 @@ VALUE ray_audio_set_direction(VALUE self, VALUE dir) {
   return dir;
 }
 
+/*
+ * @see voice_count=
+ */
+VALUE ray_audio_voice_count(VALUE self) {
+  return ULONG2NUM(say_mixer_get_voice_count());
+}
+
+/*
+ * @overload voice_count=(count)
+ *   Sets the maximal amount of sounds that can play at the same time. Musics
+ *   are not included.
+ *   @param [Integer] count
+ */
+VALUE ray_audio_set_voice_count(VALUE self, VALUE count) {
+  say_mixer_set_voice_count(NUM2ULONG(count));
+  return count;
+}
+
+/*
+ * @return [Integer] Amount of voices used by sounds that are playing or paused
+ */
+VALUE ray_audio_active_voice_count(VALUE self) {
+  return ULONG2NUM(say_mixer_get_active_voice_count());
+}
+
 /*
  * Document-class: Ray::Audio
  *
@@ -71,4 +96,9 @@ void Init_ray_audio() {
   rb_define_module_function(ray_mAudio, "pos=", ray_audio_set_pos, 1);
   rb_define_module_function(ray_mAudio, "direction", ray_audio_direction, 0);
   rb_define_module_function(ray_mAudio, "direction=", ray_audio_set_direction, 1);
+  rb_define_module_function(ray_mAudio, "voice_count", ray_audio_voice_count, 0);
+  rb_define_module_function(ray_mAudio, "voice_count=",
+                            ray_audio_set_voice_count, 1);
+  rb_define_module_function(ray_mAudio, "active_voice_count",
+                            ray_audio_active_voice_count, 0);
 }
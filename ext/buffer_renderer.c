@@ -55,6 +55,11 @@ VALUE ray_buffer_renderer_alloc(VALUE self) {
  *   stream once and use it once. Static means you will just push your data once
  *   and use them many times. Dynamic, lastly, means your data will be both
  *   updated and drawn often.
+ *
+ *   When possible, stream buffer renderers write vertices straight into GPU
+ *   memory, cycling through three regions so that filling the next frame
+ *   doesn't wait for the GPU to be done with the previous ones (see
+ *   {#streaming?}).
  */
 static
 VALUE ray_buffer_renderer_init(VALUE self, VALUE type, VALUE vtype) {
@@ -105,6 +110,16 @@ VALUE ray_buffer_renderer_update(VALUE self) {
   return self;
 }
 
+/*
+ * @return [true, false] True if vertices are written directly to mapped GPU
+ *   memory instead of being copied from a CPU-side buffer.
+ */
+static
+VALUE ray_buffer_renderer_is_streaming(VALUE self) {
+  return say_buffer_renderer_is_streaming(ray_rb2buf_renderer(self)) ?
+    Qtrue : Qfalse;
+}
+
 /*
  * Document-class: Ray::BufferRenderer
  *
@@ -127,4 +142,6 @@ void Init_ray_buffer_renderer() {
   rb_define_method(ray_cBufferRenderer, "push", ray_buffer_renderer_push, 1);
   rb_define_method(ray_cBufferRenderer, "update", ray_buffer_renderer_update,
                    0);
+  rb_define_method(ray_cBufferRenderer, "streaming?",
+                   ray_buffer_renderer_is_streaming, 0);
 }
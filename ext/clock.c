@@ -0,0 +1,116 @@
+#include "ray.h"
+
+#ifdef HAVE_RUBY_THREAD_H
+# include <ruby/thread.h>
+#endif
+
+VALUE ray_cClock = Qnil;
+
+say_clock *ray_rb2clock(VALUE obj) {
+  if (!RAY_IS_A(obj, rb_path2class("Ray::Clock"))) {
+    rb_raise(rb_eTypeError, "Can't convert %s into Ray::Clock",
+             RAY_OBJ_CLASSNAME(obj));
+  }
+
+  say_clock *clock;
+  Data_Get_Struct(obj, say_clock, clock);
+
+  return clock;
+}
+
+static
+VALUE ray_clock_alloc(VALUE self) {
+  say_clock *clock = say_clock_create();
+  return Data_Wrap_Struct(self, NULL, say_clock_free, clock);
+}
+
+/* @return [Float] Seconds elapsed since the clock was created or restarted */
+static
+VALUE ray_clock_elapsed(VALUE self) {
+  return rb_float_new(say_clock_get_elapsed(ray_rb2clock(self)));
+}
+
+/*
+ * Restarts the clock.
+ * @return [Float] Seconds elapsed before the clock was restarted
+ */
+static
+VALUE ray_clock_restart(VALUE self) {
+  return rb_float_new(say_clock_restart(ray_rb2clock(self)));
+}
+
+/*
+ * @return [Float] Current time in seconds, measured from an arbitrary point.
+ *   Unlike Time.now, this is never affected by changes to the system time.
+ */
+static
+VALUE ray_clock_now(VALUE self) {
+  return rb_float_new(say_clock_now());
+}
+
+typedef struct {
+  double seconds;
+  double spin;
+} ray_clock_sleep_args;
+
+static
+void *ray_clock_sleep_nogvl(void *data) {
+  ray_clock_sleep_args *args = data;
+  say_clock_sleep(args->seconds, args->spin);
+
+  return NULL;
+}
+
+/*
+ * @overload sleep(seconds, spin = 0.002)
+ *   Sleeps more accurately than Kernel#sleep: the OS is only trusted with all
+ *   but the last spin seconds, which are spent busy-waiting. Other Ruby
+ *   threads keep running in the meantime.
+ *
+ *   @param [Float] seconds Time to sleep for
+ *   @param [Float] spin Time spent busy-waiting
+ */
+static
+VALUE ray_clock_sleep(int argc, VALUE *argv, VALUE self) {
+  VALUE seconds, spin = Qnil;
+  rb_scan_args(argc, argv, "11", &seconds, &spin);
+
+  ray_clock_sleep_args args;
+  args.seconds = NUM2DBL(seconds);
+  args.spin    = NIL_P(spin) ? 0.002 : NUM2DBL(spin);
+
+  if (args.seconds <= 0)
+    return Qnil;
+
+#if defined(HAVE_RB_THREAD_CALL_WITHOUT_GVL)
+  rb_thread_call_without_gvl(ray_clock_sleep_nogvl, &args, RUBY_UBF_IO, NULL);
+#elif defined(HAVE_RB_THREAD_BLOCKING_REGION)
+  rb_thread_blocking_region((rb_blocking_function_t*)ray_clock_sleep_nogvl,
+                            &args, RUBY_UBF_IO, NULL);
+#else
+  ray_clock_sleep_nogvl(&args);
+#endif
+
+  return Qnil;
+}
+
+/*
+ * Document-class: Ray::Clock
+ *
+ * A monotonic, high-resolution clock.
+ *
+ * @example
+ *   clock = Ray::Clock.new
+ *   do_something
+ *   puts "took #{clock.elapsed}s"
+ */
+void Init_ray_clock() {
+  ray_cClock = rb_define_class_under(ray_mRay, "Clock", rb_cObject);
+  rb_define_alloc_func(ray_cClock, ray_clock_alloc);
+
+  rb_define_singleton_method(ray_cClock, "now", ray_clock_now, 0);
+  rb_define_singleton_method(ray_cClock, "sleep", ray_clock_sleep, -1);
+
+  rb_define_method(ray_cClock, "elapsed", ray_clock_elapsed, 0);
+  rb_define_method(ray_cClock, "restart", ray_clock_restart, 0);
+}
@@ -64,6 +64,7 @@ void ray_drawable_render_proc(void *data, size_t first, size_t index) {
 ray_drawable *ray_rb2full_drawable(VALUE obj) {
   if (rb_obj_is_kind_of(obj, rb_path2class("Ray::Text"))    ||
       rb_obj_is_kind_of(obj, rb_path2class("Ray::Sprite"))  ||
+      rb_obj_is_kind_of(obj, rb_path2class("Ray::SpriteBatch")) ||
       rb_obj_is_kind_of(obj, rb_path2class("Ray::Polygon")) ||
       !rb_obj_is_kind_of(obj, rb_path2class("Ray::Drawable"))) {
     rb_raise(rb_eTypeError, "can't get drawable pointer from %s",
@@ -105,6 +106,8 @@ say_drawable *ray_rb2drawable(VALUE obj) {
     return ray_rb2sprite(obj)->drawable;
   else if (RAY_IS_A(obj, rb_path2class("Ray::Text")))
     return ray_rb2text(obj)->drawable;
+  else if (RAY_IS_A(obj, rb_path2class("Ray::SpriteBatch")))
+    return ray_rb2sprite_batch(obj)->drawable;
   else {
     return ray_rb2full_drawable(obj)->drawable;
   }
@@ -535,6 +538,96 @@ VALUE ray_drawable_blend_mode(VALUE self) {
   return Qnil; /* should never happen */
 }
 
+/*
+ * Copies count * n floats from a packed String (native floats, as created by
+ * pack("f*")) or from a flat Array of numbers into a scratch string, so that
+ * the buffer is released by the GC even if a conversion raises.
+ */
+static
+float *ray_drawable_unpack_floats(VALUE buf, size_t count, size_t n,
+                                  const char *name, VALUE *scratch) {
+  if (NIL_P(buf))
+    return NULL;
+
+  size_t size = count * n;
+
+  *scratch = rb_str_buf_new(sizeof(float) * size);
+  float *ret = (float*)RSTRING_PTR(*scratch);
+
+  if (RB_TYPE_P(buf, T_STRING)) {
+    if ((size_t)RSTRING_LEN(buf) < sizeof(float) * size) {
+      rb_raise(rb_eArgError, "%s contain %ld bytes, %zu expected", name,
+               RSTRING_LEN(buf), sizeof(float) * size);
+    }
+
+    memcpy(ret, RSTRING_PTR(buf), sizeof(float) * size);
+  }
+  else {
+    buf = rb_convert_type(buf, T_ARRAY, "Array", "to_ary");
+    if ((size_t)RARRAY_LEN(buf) < size) {
+      rb_raise(rb_eArgError, "%s contain %ld values, %zu expected", name,
+               RARRAY_LEN(buf), size);
+    }
+
+    for (size_t i = 0; i < size; i++)
+      ret[i] = NUM2DBL(RARRAY_AREF(buf, i));
+  }
+
+  return ret;
+}
+
+/*
+  @overload update_many(drawables, positions, angles = nil, scales = nil)
+    Sets the transformations of many drawables at once, and rebuilds their
+    matrices in a single pass.
+
+    Each buffer is either a flat array of numbers or a string of packed native
+    floats (see Array#pack with "f*"). Positions and scales use two floats per
+    drawable, angles only one. Passing nil leaves that attribute unchanged.
+
+    @example
+      Ray::Drawable.update_many(sprites, coords.pack("f*"))
+
+    @param [Array<Ray::Drawable>] drawables
+    @param [String, Array<Float>, nil] positions
+    @param [String, Array<Float>, nil] angles
+    @param [String, Array<Float>, nil] scales
+
+    @return [Array<Ray::Drawable>] drawables
+*/
+static
+VALUE ray_drawable_update_many(int argc, VALUE *argv, VALUE self) {
+  VALUE drawables, rb_pos, rb_angles, rb_scales;
+  rb_scan_args(argc, argv, "22", &drawables, &rb_pos, &rb_angles, &rb_scales);
+
+  drawables = rb_convert_type(drawables, T_ARRAY, "Array", "to_ary");
+  size_t count = RARRAY_LEN(drawables);
+
+  VALUE pos_buf = Qnil, angle_buf = Qnil, scale_buf = Qnil;
+
+  float *pos    = ray_drawable_unpack_floats(rb_pos, count, 2, "positions",
+                                             &pos_buf);
+  float *angles = ray_drawable_unpack_floats(rb_angles, count, 1, "angles",
+                                             &angle_buf);
+  float *scales = ray_drawable_unpack_floats(rb_scales, count, 2, "scales",
+                                             &scale_buf);
+
+  VALUE list_buf = rb_str_buf_new(sizeof(say_drawable*) * count);
+  say_drawable **list = (say_drawable**)RSTRING_PTR(list_buf);
+
+  for (size_t i = 0; i < count; i++)
+    list[i] = ray_rb2drawable(RARRAY_AREF(drawables, i));
+
+  say_drawable_set_transforms(list, count, pos, angles, scales);
+
+  RB_GC_GUARD(pos_buf);
+  RB_GC_GUARD(angle_buf);
+  RB_GC_GUARD(scale_buf);
+  RB_GC_GUARD(list_buf);
+
+  return drawables;
+}
+
 /*
  * Document-class: Ray::Drawable
  *
@@ -571,6 +664,9 @@ void Init_ray_drawable() {
   rb_define_method(ray_cDrawable, "initialize", ray_drawable_init, -1);
   rb_define_method(ray_cDrawable, "initialize_copy", ray_drawable_init_copy, 1);
 
+  rb_define_singleton_method(ray_cDrawable, "update_many",
+                             ray_drawable_update_many, -1);
+
   /* @group Transformations */
   rb_define_method(ray_cDrawable, "origin", ray_drawable_origin, 0);
   rb_define_method(ray_cDrawable, "origin=", ray_drawable_set_origin, 1);
@@ -1,6 +1,7 @@
 #include "ray.h"
 
 VALUE ray_cEvent = Qnil;
+VALUE ray_cEventBuffer = Qnil;
 
 say_event *ray_rb2event(VALUE object) {
   if (!RAY_IS_A(object, rb_path2class("Ray::Event"))) {
@@ -149,6 +150,111 @@ VALUE ray_event_window_size(VALUE self) {
   return Qnil;
 }
 
+ray_event_buffer *ray_rb2event_buffer(VALUE obj) {
+  if (!RAY_IS_A(obj, rb_path2class("Ray::EventBuffer"))) {
+    rb_raise(rb_eTypeError, "Can't convert %s into Ray::EventBuffer",
+             RAY_OBJ_CLASSNAME(obj));
+  }
+
+  ray_event_buffer *ret = NULL;
+  Data_Get_Struct(obj, ray_event_buffer, ret);
+
+  return ret;
+}
+
+static
+void ray_event_buffer_free(ray_event_buffer *buf) {
+  free(buf->events);
+  free(buf);
+}
+
+static
+VALUE ray_event_buffer_alloc(VALUE self) {
+  ray_event_buffer *buf = malloc(sizeof(ray_event_buffer));
+
+  buf->events   = NULL;
+  buf->size     = 0;
+  buf->capacity = 0;
+
+  return Data_Wrap_Struct(self, NULL, ray_event_buffer_free, buf);
+}
+
+/*
+  @overload initialize(capacity = 256)
+    @param [Integer] capacity Maximal amount of events retrieved at once
+*/
+static
+VALUE ray_event_buffer_init(int argc, VALUE *argv, VALUE self) {
+  ray_event_buffer *buf = ray_rb2event_buffer(self);
+
+  VALUE rb_capacity = Qnil;
+  rb_scan_args(argc, argv, "01", &rb_capacity);
+
+  size_t capacity = NIL_P(rb_capacity) ? 256 : NUM2ULONG(rb_capacity);
+  if (capacity == 0)
+    rb_raise(rb_eArgError, "capacity must be positive");
+
+  buf->events   = realloc(buf->events, sizeof(say_event) * capacity);
+  buf->capacity = capacity;
+  buf->size     = 0;
+
+  return self;
+}
+
+/* @return [Integer] Amount of events in the buffer */
+static
+VALUE ray_event_buffer_size(VALUE self) {
+  return ULONG2NUM(ray_rb2event_buffer(self)->size);
+}
+
+/* @return [Integer] Maximal amount of events in the buffer */
+static
+VALUE ray_event_buffer_capacity(VALUE self) {
+  return ULONG2NUM(ray_rb2event_buffer(self)->capacity);
+}
+
+/* Removes every event from the buffer */
+static
+VALUE ray_event_buffer_clear(VALUE self) {
+  ray_rb2event_buffer(self)->size = 0;
+  return self;
+}
+
+/*
+  @overload type_at(id)
+    @return [Integer, nil] Type of the event at the given index
+*/
+static
+VALUE ray_event_buffer_type_at(VALUE self, VALUE rb_id) {
+  ray_event_buffer *buf = ray_rb2event_buffer(self);
+  size_t id = NUM2ULONG(rb_id);
+
+  if (id >= buf->size)
+    return Qnil;
+
+  return INT2FIX(buf->events[id].type);
+}
+
+/*
+  @overload event_at(id, ev)
+    Copies an event of the buffer into an existing event object, so that no
+    object needs to be allocated per event.
+
+    @param [Integer] id Index of the event
+    @param [Ray::Event] ev Event object to store the result into
+    @return [Ray::Event, nil] ev, or nil if id is out of bounds
+*/
+static
+VALUE ray_event_buffer_event_at(VALUE self, VALUE rb_id, VALUE ev) {
+  ray_event_buffer *buf = ray_rb2event_buffer(self);
+  size_t id = NUM2ULONG(rb_id);
+
+  if (id >= buf->size)
+    return Qnil;
+
+  *ray_rb2event(ev) = buf->events[id];
+  return ev;
+}
 
 void Init_ray_event() {
   ray_cEvent = rb_define_class_under(ray_mRay, "Event", rb_cObject);
@@ -334,4 +440,21 @@ void Init_ray_event() {
   rb_define_const(ray_cEvent, "ModControl", INT2FIX(SAY_MOD_CONTROL));
   rb_define_const(ray_cEvent, "ModShift", INT2FIX(SAY_MOD_SHIFT));
   rb_define_const(ray_cEvent, "ModSuper", INT2FIX(SAY_MOD_SUPER));
+
+  /*
+   * Document-class: Ray::EventBuffer
+   *
+   * A packed array of events, filled by {Ray::Window#poll_events}.
+   */
+  ray_cEventBuffer = rb_define_class_under(ray_mRay, "EventBuffer", rb_cObject);
+
+  rb_define_alloc_func(ray_cEventBuffer, ray_event_buffer_alloc);
+  rb_define_method(ray_cEventBuffer, "initialize", ray_event_buffer_init, -1);
+
+  rb_define_method(ray_cEventBuffer, "size", ray_event_buffer_size, 0);
+  rb_define_method(ray_cEventBuffer, "capacity", ray_event_buffer_capacity, 0);
+  rb_define_method(ray_cEventBuffer, "clear", ray_event_buffer_clear, 0);
+
+  rb_define_method(ray_cEventBuffer, "type_at", ray_event_buffer_type_at, 1);
+  rb_define_method(ray_cEventBuffer, "event_at", ray_event_buffer_event_at, 2);
 }
@@ -2,6 +2,11 @@ require 'mkmf'
 
 $CFLAGS  << " -Wextra -Wall -Wno-unused-parameter -std=gnu99 "
 
+# Used to wait for background image loading without blocking other threads
+have_header "ruby/thread.h"
+have_func "rb_thread_call_without_gvl", "ruby/thread.h"
+have_func "rb_thread_blocking_region"
+
 unless RUBY_PLATFORM =~ /mingw/
   $CFLAGS  << " " << `freetype-config --cflags`.chomp
   $LDFLAGS << " " << `freetype-config --libs`.chomp
@@ -79,6 +84,9 @@ else
   have_header "X11/extensions/Xrandr.h"
   have_library "Xrandr"
 
+  # clock_gettime lives in librt with older versions of glibc
+  have_library "rt", "clock_gettime"
+
   deps = %w[X11 GL GLEW openal sndfile]
 
   if deps.all? { |dep| have_library dep }
@@ -85,6 +85,60 @@ VALUE ray_font_line_height(VALUE self, VALUE size) {
   return INT2FIX(say_font_get_line_height(ray_rb2font(self), NUM2ULONG(size)));
 }
 
+/*
+  @overload page_count(size)
+    @param [Integer] size Size of the font
+    @return [Integer] Amount of images holding the glyphs loaded at this size.
+      New images are created as needed; glyphs never move once loaded.
+*/
+static
+VALUE ray_font_page_count(VALUE self, VALUE size) {
+  return ULONG2NUM(say_font_get_page_count(ray_rb2font(self),
+                                           NUM2ULONG(size)));
+}
+
+/*
+  @overload preload_ranges(size, ranges, bold)
+    @param [Integer] size Size of the font
+    @param [Array<Array<Integer>>] ranges First and last codepoints of each
+      range of characters to load.
+    @param [true, false] bold
+    @return [Integer] Amount of glyphs that were loaded
+*/
+static
+VALUE ray_font_preload_ranges(VALUE self, VALUE size, VALUE ranges,
+                              VALUE bold) {
+  ranges = rb_convert_type(ranges, T_ARRAY, "Array", "to_ary");
+  long count = RARRAY_LEN(ranges);
+
+  /* Checked first so that nothing can raise once the buffer is allocated */
+  for (long i = 0; i < count; i++) {
+    VALUE range = rb_convert_type(RARRAY_PTR(ranges)[i], T_ARRAY, "Array",
+                                  "to_ary");
+    if (RARRAY_LEN(range) != 2)
+      rb_raise(rb_eArgError, "ranges must have two elements");
+
+    NUM2ULONG(RARRAY_PTR(range)[0]);
+    NUM2ULONG(RARRAY_PTR(range)[1]);
+
+    rb_ary_store(ranges, i, range);
+  }
+
+  uint32_t *c_ranges = malloc(sizeof(uint32_t) * 2 * count);
+  for (long i = 0; i < count; i++) {
+    VALUE range = RARRAY_PTR(ranges)[i];
+
+    c_ranges[2 * i]     = NUM2ULONG(RARRAY_PTR(range)[0]);
+    c_ranges[2 * i + 1] = NUM2ULONG(RARRAY_PTR(range)[1]);
+  }
+
+  size_t loaded = say_font_preload(ray_rb2font(self), NUM2ULONG(size),
+                                   c_ranges, count, RTEST(bold));
+  free(c_ranges);
+
+  return ULONG2NUM(loaded);
+}
+
 void Init_ray_font() {
   ray_cFont = rb_define_class_under(ray_mRay, "Font", rb_cObject);
   rb_define_alloc_func(ray_cFont, ray_font_alloc);
@@ -94,4 +148,8 @@ void Init_ray_font() {
 
   rb_define_method(ray_cFont, "kerning", ray_font_kerning, 3);
   rb_define_method(ray_cFont, "line_height", ray_font_line_height, 1);
+  rb_define_method(ray_cFont, "page_count", ray_font_page_count, 1);
+
+  rb_define_private_method(ray_cFont, "preload_ranges",
+                           ray_font_preload_ranges, 3);
 }
@@ -314,6 +314,47 @@ VALUE ray_gl_set_callback(VALUE self, VALUE proc) {
   return proc;
 }
 
+/*
+ * @overload buffer_stats(vertex_class = Ray::Vertex)
+ *   Statistics about the global buffers drawables store their vertices in
+ *
+ *   Those buffers are split into blocks whose size is a power of two, so
+ *   :allocated may be greater than :used. :fragmentation is the part of the
+ *   free vertices that aren't in the largest free block of their buffer (0
+ *   meaning the free vertices of each buffer are contiguous).
+ *
+ *   @param [Class] vertex_class Class of the vertices stored in the buffers
+ *
+ *   @return [Hash] Values for :buffers, :capacity, :used, :allocated,
+ *     :free_blocks, :largest_free_block and :fragmentation.
+ */
+static
+VALUE ray_gl_buffer_stats(int argc, VALUE *argv, VALUE self) {
+  VALUE vtype = Qnil;
+  rb_scan_args(argc, argv, "01", &vtype);
+
+  say_buffer_slice_stats stats;
+  say_buffer_slice_get_stats(NIL_P(vtype) ? 0 : ray_get_vtype(vtype), &stats);
+
+  size_t free_size = stats.capacity - stats.allocated;
+
+  VALUE hash = rb_hash_new();
+  rb_hash_aset(hash, RAY_SYM("buffers"), ULONG2NUM(stats.buffer_count));
+  rb_hash_aset(hash, RAY_SYM("capacity"), ULONG2NUM(stats.capacity));
+  rb_hash_aset(hash, RAY_SYM("used"), ULONG2NUM(stats.used));
+  rb_hash_aset(hash, RAY_SYM("allocated"), ULONG2NUM(stats.allocated));
+  rb_hash_aset(hash, RAY_SYM("free_blocks"),
+               ULONG2NUM(stats.free_block_count));
+  rb_hash_aset(hash, RAY_SYM("largest_free_block"),
+               ULONG2NUM(stats.largest_free_block));
+  rb_hash_aset(hash, RAY_SYM("fragmentation"),
+               rb_float_new(free_size == 0 ? 0.0 :
+                            1.0 - (double)stats.largest_free_block_total /
+                            free_size));
+
+  return hash;
+}
+
 /*
  * Ensures an OpenGL context is active for the current thread
  */
@@ -386,6 +427,8 @@ void Init_ray_gl() {
                             ray_gl_multi_draw_elements, 3);
   /* @endgroup */
 
+  rb_define_module_function(ray_mGL, "buffer_stats", ray_gl_buffer_stats, -1);
+
   rb_define_module_function(ray_mGL, "has_callback?", ray_gl_has_callback, 0);
   rb_define_module_function(ray_mGL, "callback=", ray_gl_set_callback, 1);
 
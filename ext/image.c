@@ -14,10 +14,17 @@ say_image *ray_rb2image(VALUE obj) {
   return img;
 }
 
+/* Images packed in an atlas keep it alive, as their pixels are stored there */
+static
+void ray_image_mark(say_image *img) {
+  if (img->atlas)
+    rb_gc_mark((VALUE)say_atlas_get_data(img->atlas));
+}
+
 static
 VALUE ray_image_alloc(VALUE self) {
   say_image *img = say_image_create();
-  return Data_Wrap_Struct(ray_cImage, NULL, say_image_free, img);
+  return Data_Wrap_Struct(ray_cImage, ray_image_mark, say_image_free, img);
 }
 
 /*
@@ -68,10 +75,10 @@ static
 VALUE ray_image_init_copy(VALUE self, VALUE other) {
   say_image *orig = ray_rb2image(other);
 
-  say_image_load_flipped_raw(ray_rb2image(self),
-                             say_image_get_width(orig),
-                             say_image_get_height(orig),
-                             say_image_get_buffer(orig));
+  say_image_load_raw(ray_rb2image(self),
+                     say_image_get_width(orig),
+                     say_image_get_height(orig),
+                     say_image_get_buffer(orig));
 
   return self;
 }
@@ -209,6 +216,56 @@ VALUE ray_image_set(VALUE self, VALUE rb_x, VALUE rb_y, VALUE color) {
   return color;
 }
 
+/*
+ * @overload fill_rect(rect, color)
+ *   Sets the color of every pixel in a rect
+ *
+ *   Much faster than setting pixels one by one: only the rect is uploaded to
+ *   the texture afterwards.
+ *
+ *   @param [Rect, #to_rect] rect Rect to fill. It is clipped to the image.
+ *   @param [Color] color New color of the pixels
+ */
+static
+VALUE ray_image_fill_rect(VALUE self, VALUE rect, VALUE color) {
+  rb_check_frozen(self);
+
+  say_image_fill_rect(ray_rb2image(self), ray_convert_to_rect(rect),
+                      ray_rb2col(color));
+  return self;
+}
+
+/*
+ * @overload blit(src, at = [0, 0], rect = nil)
+ *   Copies the pixels of another image into this one
+ *
+ *   Pixels are copied as they are, without blending.
+ *
+ *   @param [Ray::Image] src Image to copy pixels from
+ *   @param [Vector2, #to_vector2] at Position of the copy in this image
+ *   @param [Rect, #to_rect, nil] rect Part of src to copy. Defaults to the
+ *     whole image.
+ */
+static
+VALUE ray_image_blit(int argc, VALUE *argv, VALUE self) {
+  rb_check_frozen(self);
+
+  VALUE src, at = Qnil, rect = Qnil;
+  rb_scan_args(argc, argv, "12", &src, &at, &rect);
+
+  say_image *c_src = ray_rb2image(src);
+
+  say_vector2 c_at = NIL_P(at) ? say_make_vector2(0, 0) :
+    ray_convert_to_vector2(at);
+  say_rect c_rect = NIL_P(rect) ?
+    say_make_rect(0, 0, say_image_get_width(c_src),
+                  say_image_get_height(c_src)) :
+    ray_convert_to_rect(rect);
+
+  say_image_blit(ray_rb2image(self), c_src, c_rect, c_at);
+  return self;
+}
+
 /*
  * @overload tex_rect(rect)
  *   Converts a rect of pixel coordinates to a rect of texture coordinates
@@ -216,8 +273,8 @@ VALUE ray_image_set(VALUE self, VALUE rb_x, VALUE rb_y, VALUE color) {
  *   Texture coordinates can be useful when manually generating vertices that
  *   need to be textured.
  *
- *   The returned rect is setup so that (x,y) is the top left corner of the
- *   image. The height of the rect may thus be negative.
+ *   Textures are stored from top to bottom, so (x,y) is the top left corner of
+ *   the returned rect.
  *
  *   @param [Rect] rect Rect in pixel coordinates
  *   @return [Rect] Rect in texture coordinates
@@ -260,6 +317,116 @@ VALUE ray_image_texture(VALUE self) {
   return ULONG2NUM(say_image_get_texture(ray_rb2image(self)));
 }
 
+/*
+ * @see mipmapped=
+ */
+static
+VALUE ray_image_is_mipmapped(VALUE self) {
+  return say_image_is_mipmapped(ray_rb2image(self)) ? Qtrue : Qfalse;
+}
+
+/*
+ * @overload mipmapped=(val)
+ *   Enables or disables mipmapping
+ *
+ *   Mipmapped images are sampled from downscaled copies of themselves when
+ *   they are drawn smaller than they are, which looks better and is faster
+ *   than reading the full-size texture. Combined with smoothing, this enables
+ *   trilinear filtering. The downscaled copies are regenerated the next time
+ *   the image is drawn after being modified.
+ *
+ *   Mipmapping is disabled by default. Images packed in a {Ray::Atlas} are
+ *   drawn from one of its pages, and thus can't be mipmapped.
+ *
+ *   @param [Boolean] val True to enable mipmapping
+ *   @raise [RuntimeError] If the image is packed in an atlas
+ */
+static
+VALUE ray_image_set_mipmapped(VALUE self, VALUE val) {
+  rb_check_frozen(self);
+  if (!say_image_set_mipmapped(ray_rb2image(self), RTEST(val)))
+    rb_raise(rb_eRuntimeError, "%s", say_error_get_last());
+  return val;
+}
+
+/*
+ * @return [true, false] True if anisotropic filtering is supported by the
+ *   driver
+ */
+static
+VALUE ray_image_anisotropy_available(VALUE self) {
+  return say_image_anisotropy_is_available() ? Qtrue : Qfalse;
+}
+
+/*
+ * @see anisotropy=
+ */
+static
+VALUE ray_image_anisotropy(VALUE self) {
+  return rb_float_new(say_image_get_anisotropy(ray_rb2image(self)));
+}
+
+/*
+ * @overload anisotropy=(val)
+ *   Sets the amount of anisotropic filtering
+ *
+ *   This improves the quality of images that are scaled down more along an
+ *   axis than the other. The value is clamped to what the driver supports,
+ *   and ignored when anisotropic filtering isn't available.
+ *
+ *   @see anisotropy_available?
+ *
+ *   @param [Float] val 1 to disable anisotropic filtering (the default), up to
+ *     16 on most hardware.
+ */
+static
+VALUE ray_image_set_anisotropy(VALUE self, VALUE val) {
+  rb_check_frozen(self);
+  say_image_set_anisotropy(ray_rb2image(self), NUM2DBL(val));
+  return val;
+}
+
+/*
+ * @return [true, false] True if the texture is stored using the compressed
+ *   blocks of a DDS or KTX file. This stops being true as soon as the image is
+ *   modified, and the texture is replaced with regular pixels the next time it
+ *   is used.
+ */
+static
+VALUE ray_image_is_compressed(VALUE self) {
+  return say_image_is_compressed(ray_rb2image(self)) ? Qtrue : Qfalse;
+}
+
+/*
+ * @overload compressed_format_supported?(format)
+ *   @param [Symbol] format One of :bc1, :bc2, :bc3, :etc2_rgb, :etc2_rgba
+ *   @return [true, false] True if textures using this format can be uploaded
+ *     without being decompressed first. Other formats are decoded in software
+ *     when possible.
+ */
+static
+VALUE ray_image_compressed_format_supported(VALUE self, VALUE format) {
+  say_compressed_format value;
+
+  if (format == RAY_SYM("bc1"))
+    value = SAY_COMPRESSED_BC1;
+  else if (format == RAY_SYM("bc2"))
+    value = SAY_COMPRESSED_BC2;
+  else if (format == RAY_SYM("bc3"))
+    value = SAY_COMPRESSED_BC3;
+  else if (format == RAY_SYM("etc2_rgb"))
+    value = SAY_COMPRESSED_ETC2_RGB;
+  else if (format == RAY_SYM("etc2_rgba"))
+    value = SAY_COMPRESSED_ETC2_RGBA;
+  else {
+    VALUE str = rb_inspect(format);
+    rb_raise(rb_eArgError, "unknown compressed format %s",
+             StringValuePtr(str));
+  }
+
+  return say_compressed_format_is_supported(value) ? Qtrue : Qfalse;
+}
+
 /*
  * @see smooth=
  */
@@ -326,11 +493,22 @@ void Init_ray_image() {
   /* @group Pixel-level access */
   rb_define_method(ray_cImage, "[]", ray_image_get, 2);
   rb_define_method(ray_cImage, "[]=", ray_image_set, 3);
+  rb_define_method(ray_cImage, "fill_rect", ray_image_fill_rect, 2);
+  rb_define_method(ray_cImage, "blit", ray_image_blit, -1);
   /* @endgroup */
 
   /* @group Texture parameters */
   rb_define_method(ray_cImage, "smooth?", ray_image_is_smooth, 0);
   rb_define_method(ray_cImage, "smooth=", ray_image_set_smooth, 1);
+  rb_define_method(ray_cImage, "mipmapped?", ray_image_is_mipmapped, 0);
+  rb_define_method(ray_cImage, "mipmapped=", ray_image_set_mipmapped, 1);
+  rb_define_method(ray_cImage, "anisotropy", ray_image_anisotropy, 0);
+  rb_define_method(ray_cImage, "anisotropy=", ray_image_set_anisotropy, 1);
+  rb_define_singleton_method(ray_cImage, "anisotropy_available?",
+                             ray_image_anisotropy_available, 0);
+  rb_define_method(ray_cImage, "compressed?", ray_image_is_compressed, 0);
+  rb_define_singleton_method(ray_cImage, "compressed_format_supported?",
+                             ray_image_compressed_format_supported, 1);
   /* @endgroup */
 
   /* @group Coordinate conversions */
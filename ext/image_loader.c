@@ -0,0 +1,160 @@
+#include "ray.h"
+
+#ifdef HAVE_RUBY_THREAD_H
+# include <ruby/thread.h>
+#endif
+
+VALUE ray_cAsyncLoad = Qnil;
+
+static
+say_image_job *ray_rb2image_job(VALUE obj) {
+  if (!RAY_IS_A(obj, rb_path2class("Ray::Image::AsyncLoad"))) {
+    rb_raise(rb_eTypeError, "can't convert %s into Ray::Image::AsyncLoad",
+             RAY_OBJ_CLASSNAME(obj));
+  }
+
+  say_image_job *job = NULL;
+  Data_Get_Struct(obj, say_image_job, job);
+
+  if (!job)
+    rb_raise(rb_eRuntimeError, "image loading hasn't been started");
+
+  return job;
+}
+
+static
+void ray_image_job_free(say_image_job *job) {
+  if (job)
+    say_image_job_release(job);
+}
+
+static
+VALUE ray_async_load_alloc(VALUE self) {
+  return Data_Wrap_Struct(self, NULL, ray_image_job_free, NULL);
+}
+
+/*
+ * @overload initialize(filename)
+ *   Starts decoding an image file in a background thread.
+ *   @param [String] filename Name of the file to load.
+ */
+static
+VALUE ray_async_load_init(VALUE self, VALUE filename) {
+  if (DATA_PTR(self))
+    rb_raise(rb_eRuntimeError, "image loading has already been started");
+
+  DATA_PTR(self) = say_image_loader_push(StringValuePtr(filename));
+  rb_iv_set(self, "@filename", rb_str_dup(filename));
+
+  return self;
+}
+
+/* @return [true, false] True if the file has been decoded (or failed to be) */
+static
+VALUE ray_async_load_is_done(VALUE self) {
+  return say_image_job_get_state(ray_rb2image_job(self)) !=
+    SAY_IMAGE_JOB_PENDING ? Qtrue : Qfalse;
+}
+
+/* @return [true, false] True if the file could not be decoded */
+static
+VALUE ray_async_load_has_failed(VALUE self) {
+  return say_image_job_get_state(ray_rb2image_job(self)) ==
+    SAY_IMAGE_JOB_FAILED ? Qtrue : Qfalse;
+}
+
+/*
+ * @return [Integer] Size of the decoded pixels in bytes (or of the file itself
+ *   for DDS and KTX containers), 0 until the file is decoded.
+ */
+static
+VALUE ray_async_load_byte_size(VALUE self) {
+  say_image_job *job = ray_rb2image_job(self);
+  if (say_image_job_get_state(job) != SAY_IMAGE_JOB_DONE)
+    return INT2FIX(0);
+
+  return ULONG2NUM(say_image_job_get_byte_size(job));
+}
+
+static
+void *ray_async_load_wait_nogvl(void *job) {
+  say_image_job_wait(job);
+  return NULL;
+}
+
+/* Wakes the waiting thread up, e.g. so that Ctrl-C can interrupt it */
+static
+void ray_async_load_wait_ubf(void *job) {
+  say_image_job_interrupt_wait(job);
+}
+
+/*
+ * @overload wait
+ *   Blocks until the file is decoded. Other Ruby threads keep running in the
+ *   meantime.
+ */
+static
+VALUE ray_async_load_wait(VALUE self) {
+  say_image_job *job = ray_rb2image_job(self);
+
+  while (say_image_job_get_state(job) == SAY_IMAGE_JOB_PENDING) {
+#if defined(HAVE_RB_THREAD_CALL_WITHOUT_GVL)
+    rb_thread_call_without_gvl(ray_async_load_wait_nogvl, job,
+                               ray_async_load_wait_ubf, job);
+#elif defined(HAVE_RB_THREAD_BLOCKING_REGION)
+    rb_thread_blocking_region((rb_blocking_function_t*)ray_async_load_wait_nogvl,
+                              job, ray_async_load_wait_ubf, job);
+#else
+    ray_async_load_wait_nogvl(job);
+#endif
+
+    /* Raises the exception that interrupted us, if any */
+    rb_thread_check_ints();
+  }
+
+  return self;
+}
+
+/*
+ * @overload load_into(img)
+ *   Waits for the file to be decoded, then hands its pixels over to an image
+ *   and uploads them to its texture. This can only be done once.
+ *
+ *   @param [Ray::Image] img
+ *   @raise [RuntimeError] If the file couldn't be decoded.
+ */
+static
+VALUE ray_async_load_load_into(VALUE self, VALUE img) {
+  ray_async_load_wait(self);
+
+  if (!say_image_job_load(ray_rb2image_job(self), ray_rb2image(img))) {
+    VALUE filename = rb_iv_get(self, "@filename");
+    rb_raise(rb_eRuntimeError, "could not load image from %s",
+             StringValuePtr(filename));
+  }
+
+  return img;
+}
+
+/*
+ * Document-class: Ray::Image::AsyncLoad
+ *
+ * An image file being decoded by a pool of native threads. Decoding happens
+ * without holding Ruby's global lock; only handing the pixels over to an image
+ * and uploading them has to happen on the thread owning the OpenGL context.
+ *
+ * @see Ray::Image.load_async
+ */
+void Init_ray_image_loader() {
+  ray_cAsyncLoad = rb_define_class_under(ray_cImage, "AsyncLoad", rb_cObject);
+
+  rb_define_alloc_func(ray_cAsyncLoad, ray_async_load_alloc);
+  rb_define_method(ray_cAsyncLoad, "initialize", ray_async_load_init, 1);
+
+  rb_define_method(ray_cAsyncLoad, "done?", ray_async_load_is_done, 0);
+  rb_define_method(ray_cAsyncLoad, "failed?", ray_async_load_has_failed, 0);
+  rb_define_method(ray_cAsyncLoad, "byte_size", ray_async_load_byte_size, 0);
+
+  rb_define_method(ray_cAsyncLoad, "wait", ray_async_load_wait, 0);
+  rb_define_method(ray_cAsyncLoad, "load_into", ray_async_load_load_into, 1);
+}
@@ -168,12 +168,12 @@ void mo_array_reserve(mo_array *ary, size_t size) {
   if (ary->capa > size)
     return;
 
-  ary->buffer = realloc(ary->buffer, size * ary->capa);
+  ary->buffer = realloc(ary->buffer, size * ary->el_size);
   ary->capa   = size;
 }
 
 void mo_array_shrink(mo_array *ary) {
-  ary->buffer = realloc(ary->buffer, ary->size * ary->capa);
+  ary->buffer = realloc(ary->buffer, ary->size * ary->el_size);
   ary->capa   = ary->size;
 }
 
@@ -450,8 +450,19 @@ void mo_hash_grow(mo_hash *hash) {
   }
 
   /*
-   * Release the current hash, and use the copy instead.
+   * Release the current hash, and use the copy instead. Elements have been
+   * copied, so we only need to free the buckets.
    */
+  for (size_t i = 0; i < hash->buffer.size; i++) {
+    mo_hash_list *bucket = mo_array_get_as(&hash->buffer, i, mo_hash_list*);
+
+    while (bucket) {
+      mo_hash_list *next = bucket->next;
+      free(bucket);
+      bucket = next;
+    }
+  }
+
   mo_array_release(&hash->buffer);
 
   *hash = copy;
@@ -510,12 +521,12 @@ void mo_hash_set(mo_hash *hash, void *key, void *data) {
       it   = it->next;
     }
 
-    last = malloc(offsetof(mo_hash_list, data) +
-                  hash->key_size + hash->el_size);
-    last->next = NULL;
-    mo_hash_fill_bucket(hash, last->data, key, data);
+    mo_hash_list *new_bucket = malloc(offsetof(mo_hash_list, data) +
+                                      hash->key_size + hash->el_size);
+    new_bucket->next = NULL;
+    mo_hash_fill_bucket(hash, new_bucket->data, key, data);
 
-    bucket->next = last;
+    last->next = new_bucket;
   }
 }
 
@@ -47,6 +47,48 @@ VALUE ray_music_set_looping(VALUE self, VALUE val) {
   return val;
 }
 
+/* @return [Integer] Amount of buffers queued while streaming */
+static
+VALUE ray_music_buffer_count(VALUE self) {
+  return ULONG2NUM(say_music_get_buffer_count(ray_rb2music(self)));
+}
+
+/*
+ * @overload buffer_count=(count)
+ *   More buffers reduce the risk of running out of data when the streaming
+ *   thread is slow to wake up, at the cost of memory. At least 2 buffers are
+ *   always used.
+ *
+ *   @param [Integer] count
+ */
+static
+VALUE ray_music_set_buffer_count(VALUE self, VALUE count) {
+  say_music_set_buffer_count(ray_rb2music(self), NUM2ULONG(count));
+  return count;
+}
+
+/*
+ * @return [Integer] Amount of frames stored in each buffer. Unless it is
+ *   changed, buffers hold one second of the opened file.
+ */
+static
+VALUE ray_music_buffer_size(VALUE self) {
+  return ULONG2NUM(say_music_get_buffer_size(ray_rb2music(self)));
+}
+
+/*
+ * @overload buffer_size=(frames)
+ *   Smaller buffers make seeking and stopping more responsive, but need to be
+ *   refilled more often.
+ *
+ *   @param [Integer] frames Amount of frames (samples per channel)
+ */
+static
+VALUE ray_music_set_buffer_size(VALUE self, VALUE frames) {
+  say_music_set_buffer_size(ray_rb2music(self), NUM2ULONG(frames));
+  return frames;
+}
+
 /*
  * @overload seek(time)
  *   Seeks to a specific time in the music
@@ -103,6 +145,11 @@ void Init_ray_music() {
   rb_define_method(ray_cMusic, "looping?", ray_music_is_looping, 0);
   rb_define_method(ray_cMusic, "looping=", ray_music_set_looping, 1);
 
+  rb_define_method(ray_cMusic, "buffer_count", ray_music_buffer_count, 0);
+  rb_define_method(ray_cMusic, "buffer_count=", ray_music_set_buffer_count, 1);
+  rb_define_method(ray_cMusic, "buffer_size", ray_music_buffer_size, 0);
+  rb_define_method(ray_cMusic, "buffer_size=", ray_music_set_buffer_size, 1);
+
   rb_define_method(ray_cMusic, "seek", ray_music_seek, 1);
   rb_define_method(ray_cMusic, "time", ray_music_time, 0);
 
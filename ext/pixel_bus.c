@@ -311,8 +311,8 @@ VALUE ray_pixel_bus_pbo(VALUE self) {
  * without having to copy them to client memory, and possibly
  * asynchronously. They may unfortunately not be available on some platforms.
  *
- * Notice that pixels are stored from bottom to top in the buffer. You may have
- * to rely on this when computing offsets manually.
+ * Pixels are stored from top to bottom in the buffer, like they are in
+ * images.
  */
 void Init_ray_pixel_bus() {
   ray_cPixelBus = rb_define_class_under(ray_mRay, "PixelBus", rb_cObject);
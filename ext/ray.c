@@ -39,12 +39,15 @@ void Init_ray_ext() {
   Init_ray_gl_index_buffer();
   Init_ray_pixel_bus();
   Init_ray_image();
+  Init_ray_image_loader();
+  Init_ray_atlas();
   Init_ray_font();
   Init_ray_shader();
   Init_ray_view();
   Init_ray_drawable();
   Init_ray_polygon();
   Init_ray_sprite();
+  Init_ray_sprite_batch();
   Init_ray_text();
   Init_ray_buffer_renderer();
   Init_ray_target();
@@ -52,6 +55,7 @@ void Init_ray_ext() {
   Init_ray_image_target();
   Init_ray_input();
   Init_ray_event();
+  Init_ray_clock();
   Init_ray_audio();
   Init_ray_sound_buffer();
   Init_ray_audio_source();
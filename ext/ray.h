@@ -18,6 +18,13 @@ typedef struct {
   size_t vsize;
 } ray_drawable;
 
+typedef struct {
+  say_event *events;
+
+  size_t size;
+  size_t capacity;
+} ray_event_buffer;
+
 /* Classes and modules */
 extern VALUE ray_mRay;
 
@@ -35,12 +42,15 @@ extern VALUE ray_cGLBuffer;
 extern VALUE ray_cGLIndexBuffer;
 extern VALUE ray_cPixelBus;
 extern VALUE ray_cImage;
+extern VALUE ray_cAsyncLoad;
+extern VALUE ray_cAtlas;
 extern VALUE ray_cFont;
 extern VALUE ray_cShader;
 extern VALUE ray_cView;
 extern VALUE ray_cDrawable;
 extern VALUE ray_cPolygon;
 extern VALUE ray_cSprite;
+extern VALUE ray_cSpriteBatch;
 extern VALUE ray_cText;
 extern VALUE ray_cBufferRenderer;
 extern VALUE ray_cTarget;
@@ -48,6 +58,8 @@ extern VALUE ray_cWindow;
 extern VALUE ray_cImageTarget;
 extern VALUE ray_cInput;
 extern VALUE ray_cEvent;
+extern VALUE ray_cClock;
+extern VALUE ray_cEventBuffer;
 extern VALUE ray_mAudio;
 extern VALUE ray_cSoundBuffer;
 extern VALUE ray_cAudioSource;
@@ -90,12 +102,15 @@ void Init_ray_gl_buffer();
 void Init_ray_gl_index_buffer();
 void Init_ray_pixel_bus();
 void Init_ray_image();
+void Init_ray_image_loader();
+void Init_ray_atlas();
 void Init_ray_font();
 void Init_ray_shader();
 void Init_ray_view();
 void Init_ray_drawable();
 void Init_ray_polygon();
 void Init_ray_sprite();
+void Init_ray_sprite_batch();
 void Init_ray_text();
 void Init_ray_buffer_renderer();
 void Init_ray_target();
@@ -103,6 +118,7 @@ void Init_ray_window();
 void Init_ray_image_target();
 void Init_ray_input();
 void Init_ray_event();
+void Init_ray_clock();
 void Init_ray_audio();
 void Init_ray_sound_buffer();
 void Init_ray_audio_source();
@@ -138,6 +154,7 @@ VALUE ray_col2rb(say_color color);
 say_vertex *ray_rb2vertex(VALUE obj);
 
 say_image *ray_rb2image(VALUE obj);
+say_atlas *ray_rb2atlas(VALUE obj);
 say_font *ray_rb2font(VALUE obj);
 
 VALUE ray_shader2rb(say_shader *shader, VALUE owner);
@@ -149,6 +166,7 @@ void ray_drawable_shader_proc(void *data, say_shader *shader);
 say_drawable *ray_rb2drawable(VALUE obj);
 say_polygon *ray_rb2polygon(VALUE obj);
 say_sprite *ray_rb2sprite(VALUE obj);
+say_sprite_batch *ray_rb2sprite_batch(VALUE obj);
 say_text *ray_rb2text(VALUE obj);
 
 say_target *ray_rb2target(VALUE obj);
@@ -156,6 +174,9 @@ say_window *ray_rb2window(VALUE obj);
 say_image_target *ray_rb2image_target(VALUE obj);
 
 say_event *ray_rb2event(VALUE obj);
+ray_event_buffer *ray_rb2event_buffer(VALUE obj);
+
+say_clock *ray_rb2clock(VALUE obj);
 
 say_input *ray_rb2input(VALUE obj);
 VALUE ray_input2rb(say_input *input, VALUE owner);
@@ -3,8 +3,13 @@
 
 #include "say_basic_type.h"
 #include "say_thread.h"
+#include "say_clock.h"
 #include "say_matrix.h"
+#include "say_affine.h"
+#include "say_compressed_image.h"
 #include "say_image.h"
+#include "say_atlas.h"
+#include "say_image_loader.h"
 #include "say_shader.h"
 #include "say_context.h"
 #include "say_vertex_type.h"
@@ -17,6 +22,7 @@
 #include "say_view.h"
 #include "say_buffer_renderer.h"
 #include "say_renderer.h"
+#include "say_render_queue.h"
 #include "say_target.h"
 #include "say_event.h"
 #include "say_window.h"
@@ -24,6 +30,7 @@
 #include "say_audio.h"
 #include "say_polygon.h"
 #include "say_sprite.h"
+#include "say_sprite_batch.h"
 #include "say_font.h"
 #include "say_text.h"
 
@@ -0,0 +1,126 @@
+#include "say.h"
+
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+
+void say_affine_reset(say_affine *affine) {
+  static const float identity[6] = {1, 0, 0, 0, 1, 0};
+  memcpy(affine->content, identity, sizeof(identity));
+}
+
+void say_affine_set_transformation(say_affine *affine,
+                                   say_vector2 origin, say_vector2 pos,
+                                   say_vector2 scale, float c, float s) {
+  float sx_cos = scale.x * c;
+  float sy_cos = scale.y * c;
+  float sx_sin = scale.x * s;
+  float sy_sin = scale.y * s;
+
+  affine->content[0] = +sx_cos;
+  affine->content[1] = +sy_sin;
+  affine->content[2] = -origin.x * sx_cos - origin.y * sy_sin + pos.x;
+  affine->content[3] = -sx_sin;
+  affine->content[4] = +sy_cos;
+  affine->content[5] = +origin.x * sx_sin - origin.y * sy_cos + pos.y;
+}
+
+bool say_affine_from_matrix(say_affine *affine, say_matrix *matrix) {
+  float *m = matrix->content;
+
+  /*
+   * Points are 2D, so the third column doesn't matter. The matrix mustn't make
+   * z or w depend on x and y though.
+   */
+  if (m[8] != 0 || m[9] != 0 ||
+      m[12] != 0 || m[13] != 0 || m[14] != 0 || m[15] != 1)
+    return false;
+
+  affine->content[0] = m[0];
+  affine->content[1] = m[1];
+  affine->content[2] = m[3];
+  affine->content[3] = m[4];
+  affine->content[4] = m[5];
+  affine->content[5] = m[7];
+
+  return true;
+}
+
+void say_affine_to_matrix(say_affine *affine, float z, say_matrix *matrix) {
+  float *a = affine->content;
+
+  float content[16] = {
+    a[0], a[1], 0, a[2],
+    a[3], a[4], 0, a[5],
+    0,    0,    1, z,
+    0,    0,    0, 1
+  };
+
+  say_matrix_set_content(matrix, content);
+}
+
+say_vector2 say_affine_transform(say_affine *affine, say_vector2 point) {
+  float *a = affine->content;
+  return say_make_vector2(a[0] * point.x + a[1] * point.y + a[2],
+                          a[3] * point.x + a[4] * point.y + a[5]);
+}
+
+/*
+ * Operations are done in the same order as in say_affine_set_transformation,
+ * so that both paths give the same results.
+ */
+void say_affine_batch_compute(say_affine_batch *batch) {
+  size_t i = 0;
+
+#ifdef __SSE2__
+  const __m128 sign = _mm_set1_ps(-0.0f);
+
+  for (; i + 4 <= batch->count; i += 4) {
+    __m128 ox = _mm_loadu_ps(batch->origin_x + i);
+    __m128 oy = _mm_loadu_ps(batch->origin_y + i);
+    __m128 sx = _mm_loadu_ps(batch->scale_x + i);
+    __m128 sy = _mm_loadu_ps(batch->scale_y + i);
+    __m128 c  = _mm_loadu_ps(batch->cos + i);
+    __m128 s  = _mm_loadu_ps(batch->sin + i);
+
+    __m128 sx_cos = _mm_mul_ps(sx, c);
+    __m128 sy_cos = _mm_mul_ps(sy, c);
+    __m128 sx_sin = _mm_mul_ps(sx, s);
+    __m128 sy_sin = _mm_mul_ps(sy, s);
+
+    __m128 tx = _mm_sub_ps(_mm_mul_ps(_mm_xor_ps(ox, sign), sx_cos),
+                           _mm_mul_ps(oy, sy_sin));
+    __m128 ty = _mm_sub_ps(_mm_mul_ps(ox, sx_sin), _mm_mul_ps(oy, sy_cos));
+
+    _mm_storeu_ps(batch->out[0] + i, sx_cos);
+    _mm_storeu_ps(batch->out[1] + i, sy_sin);
+    _mm_storeu_ps(batch->out[2] + i,
+                  _mm_add_ps(tx, _mm_loadu_ps(batch->pos_x + i)));
+    _mm_storeu_ps(batch->out[3] + i, _mm_xor_ps(sx_sin, sign));
+    _mm_storeu_ps(batch->out[4] + i, sy_cos);
+    _mm_storeu_ps(batch->out[5] + i,
+                  _mm_add_ps(ty, _mm_loadu_ps(batch->pos_y + i)));
+  }
+#endif
+
+  for (; i < batch->count; i++) {
+    say_affine affine;
+    say_affine_set_transformation(&affine,
+                                  say_make_vector2(batch->origin_x[i],
+                                                   batch->origin_y[i]),
+                                  say_make_vector2(batch->pos_x[i],
+                                                   batch->pos_y[i]),
+                                  say_make_vector2(batch->scale_x[i],
+                                                   batch->scale_y[i]),
+                                  batch->cos[i], batch->sin[i]);
+
+    for (size_t j = 0; j < 6; j++)
+      batch->out[j][i] = affine.content[j];
+  }
+}
+
+void say_affine_batch_get(say_affine_batch *batch, size_t i,
+                          say_affine *affine) {
+  for (size_t j = 0; j < 6; j++)
+    affine->content[j] = batch->out[j][i];
+}
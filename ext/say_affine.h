@@ -0,0 +1,48 @@
+#ifndef SAY_AFFINE_H_
+#define SAY_AFFINE_H_
+
+#include "say_matrix.h"
+
+/*
+ * A 2D affine transformation, stored as the two first rows of a 3x3 matrix:
+ *   | content[0] content[1] content[2] |
+ *   | content[3] content[4] content[5] |
+ */
+typedef struct {
+  float content[6];
+} say_affine;
+
+#define SAY_AFFINE_BATCH_SIZE 64
+
+/*
+ * Parameters of up to SAY_AFFINE_BATCH_SIZE transformations, laid out so that
+ * they can be computed several at a time. Rotations are given through their
+ * cosine and sine, so that they can be cached by the caller.
+ */
+typedef struct {
+  size_t count;
+
+  float origin_x[SAY_AFFINE_BATCH_SIZE], origin_y[SAY_AFFINE_BATCH_SIZE];
+  float pos_x[SAY_AFFINE_BATCH_SIZE], pos_y[SAY_AFFINE_BATCH_SIZE];
+  float scale_x[SAY_AFFINE_BATCH_SIZE], scale_y[SAY_AFFINE_BATCH_SIZE];
+  float cos[SAY_AFFINE_BATCH_SIZE], sin[SAY_AFFINE_BATCH_SIZE];
+
+  float out[6][SAY_AFFINE_BATCH_SIZE];
+} say_affine_batch;
+
+void say_affine_reset(say_affine *affine);
+
+void say_affine_set_transformation(say_affine *affine,
+                                   say_vector2 origin, say_vector2 pos,
+                                   say_vector2 scale, float c, float s);
+
+bool say_affine_from_matrix(say_affine *affine, say_matrix *matrix);
+void say_affine_to_matrix(say_affine *affine, float z, say_matrix *matrix);
+
+say_vector2 say_affine_transform(say_affine *affine, say_vector2 point);
+
+void say_affine_batch_compute(say_affine_batch *batch);
+void say_affine_batch_get(say_affine_batch *batch, size_t i,
+                          say_affine *affine);
+
+#endif
@@ -0,0 +1,377 @@
+#include "say.h"
+
+#define SAY_ATLAS_MIN_PAGE_SIZE 256
+
+void say_skyline_init(say_skyline *skyline, size_t w, size_t h) {
+  mo_array_init(&skyline->nodes, sizeof(say_skyline_node));
+
+  say_skyline_node node = {0, 0, w};
+  mo_array_push(&skyline->nodes, &node);
+
+  skyline->width  = w;
+  skyline->height = h;
+}
+
+void say_skyline_release(say_skyline *skyline) {
+  mo_array_release(&skyline->nodes);
+}
+
+void say_skyline_grow(say_skyline *skyline, size_t w, size_t h) {
+  if (w > skyline->width) {
+    say_skyline_node node = {skyline->width, 0, w - skyline->width};
+    mo_array_push(&skyline->nodes, &node);
+
+    skyline->width = w;
+  }
+
+  if (h > skyline->height)
+    skyline->height = h;
+}
+
+/*
+ * Returns the lowest y at which a w-wide rect starting at node i fits, or
+ * SIZE_MAX if it doesn't fit at all.
+ */
+static size_t say_skyline_fit(say_skyline *skyline, size_t i, size_t w,
+                              size_t h) {
+  say_skyline_node *node = mo_array_at(&skyline->nodes, i);
+  if (node->x + w > skyline->width)
+    return SIZE_MAX;
+
+  size_t y = 0, left = w;
+  for (; left > 0 && i < skyline->nodes.size; i++) {
+    node = mo_array_at(&skyline->nodes, i);
+
+    if (node->y > y)
+      y = node->y;
+
+    if (y + h > skyline->height)
+      return SIZE_MAX;
+
+    left = node->width >= left ? 0 : left - node->width;
+  }
+
+  return y;
+}
+
+bool say_skyline_insert(say_skyline *skyline, size_t w, size_t h,
+                        size_t *x, size_t *y) {
+  size_t best_id = SIZE_MAX, best_y = SIZE_MAX, best_width = SIZE_MAX;
+
+  /* Bottom-left heuristic: lowest top edge, then narrowest node */
+  for (size_t i = 0; i < skyline->nodes.size; i++) {
+    size_t fit_y = say_skyline_fit(skyline, i, w, h);
+    if (fit_y == SIZE_MAX)
+      continue;
+
+    say_skyline_node *node = mo_array_at(&skyline->nodes, i);
+    if (fit_y + h < best_y || (fit_y + h == best_y && node->width < best_width)) {
+      best_id    = i;
+      best_y     = fit_y + h;
+      best_width = node->width;
+    }
+  }
+
+  if (best_id == SIZE_MAX)
+    return false;
+
+  say_skyline_node *best = mo_array_at(&skyline->nodes, best_id);
+
+  *x = best->x;
+  *y = best_y - h;
+
+  say_skyline_node node = {best->x, best_y, w};
+  mo_array_insert(&skyline->nodes, best_id, &node);
+
+  /* Shrink or remove the nodes covered by the new one */
+  for (size_t i = best_id + 1; i < skyline->nodes.size;) {
+    say_skyline_node *prev = mo_array_at(&skyline->nodes, i - 1);
+    say_skyline_node *cur  = mo_array_at(&skyline->nodes, i);
+
+    if (cur->x >= prev->x + prev->width)
+      break;
+
+    size_t shrink = prev->x + prev->width - cur->x;
+    if (shrink >= cur->width) {
+      mo_array_delete(&skyline->nodes, i);
+    }
+    else {
+      cur->x     += shrink;
+      cur->width -= shrink;
+      break;
+    }
+  }
+
+  /* Merge neighbours at the same height */
+  for (size_t i = 0; i + 1 < skyline->nodes.size;) {
+    say_skyline_node *cur  = mo_array_at(&skyline->nodes, i);
+    say_skyline_node *next = mo_array_at(&skyline->nodes, i + 1);
+
+    if (cur->y == next->y) {
+      cur->width += next->width;
+      mo_array_delete(&skyline->nodes, i + 1);
+    }
+    else
+      i++;
+  }
+
+  return true;
+}
+
+static void say_atlas_page_release(say_atlas_page *page) {
+  say_image_free(page->image);
+  say_skyline_release(&page->skyline);
+}
+
+static size_t say_atlas_size_for(size_t size, size_t max) {
+  size_t ret = SAY_ATLAS_MIN_PAGE_SIZE;
+  while (ret < size)
+    ret *= 2;
+
+  return ret > max ? max : ret;
+}
+
+static bool say_atlas_page_init(say_atlas *atlas, say_atlas_page *page,
+                                size_t w, size_t h) {
+  page->image = say_image_create();
+  if (!say_image_create_with_size(page->image, w, h)) {
+    say_image_free(page->image);
+    return false;
+  }
+
+  memset(page->image->pixels, 0, sizeof(say_color) * w * h);
+  say_image_mark_texture_out_of_date(page->image);
+
+  say_image_set_smooth(page->image, atlas->smooth);
+  say_skyline_init(&page->skyline, w, h);
+
+  return true;
+}
+
+/*
+ * Doubles the size of a page. The pixels of every image stored in it are copied
+ * back into the new page, and their texture coordinates become invalid.
+ */
+static bool say_atlas_page_grow(say_atlas *atlas, say_atlas_page *page) {
+  size_t w = page->skyline.width, h = page->skyline.height;
+
+  if (w <= h && w < atlas->max_width)
+    w *= 2;
+  else if (h < atlas->max_height)
+    h *= 2;
+  else if (w < atlas->max_width)
+    w *= 2;
+  else
+    return false;
+
+  if (w > atlas->max_width)  w = atlas->max_width;
+  if (h > atlas->max_height) h = atlas->max_height;
+
+  if (!say_image_create_with_size(page->image, w, h))
+    return false;
+
+  memset(page->image->pixels, 0, sizeof(say_color) * w * h);
+  say_image_mark_texture_out_of_date(page->image);
+
+  say_skyline_grow(&page->skyline, w, h);
+
+  for (size_t i = 0; i < atlas->images.size; i++) {
+    say_image *img = mo_array_get_as(&atlas->images, i, say_image*);
+    if (img->atlas_page == page->image) {
+      say_image_set_atlas(img, atlas, page->image, img->atlas_x, img->atlas_y);
+      say_image_get_texture_image(img);
+    }
+  }
+
+  return true;
+}
+
+say_atlas *say_atlas_create(size_t max_width, size_t max_height) {
+  say_context_ensure();
+
+  say_atlas *atlas = malloc(sizeof(say_atlas));
+
+  mo_array_init(&atlas->pages, sizeof(say_atlas_page));
+  atlas->pages.release = (say_destructor)say_atlas_page_release;
+
+  mo_array_init(&atlas->images, sizeof(say_image*));
+
+  GLint max_size = 0;
+  glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_size);
+
+  if (max_size > 0) {
+    if (max_width  > (size_t)max_size) max_width  = max_size;
+    if (max_height > (size_t)max_size) max_height = max_size;
+  }
+
+  atlas->max_width  = max_width;
+  atlas->max_height = max_height;
+
+  atlas->padding = 1;
+  atlas->smooth  = false;
+
+  atlas->data = NULL;
+
+  return atlas;
+}
+
+void say_atlas_free(say_atlas *atlas) {
+  for (size_t i = 0; i < atlas->images.size; i++) {
+    say_image *img = mo_array_get_as(&atlas->images, i, say_image*);
+    say_image_set_atlas(img, NULL, NULL, 0, 0);
+  }
+
+  mo_array_release(&atlas->images);
+  mo_array_release(&atlas->pages);
+
+  free(atlas);
+}
+
+bool say_atlas_add(say_atlas *atlas, say_image *img) {
+  if (img->atlas == atlas)
+    return true;
+
+  if (img->width == 0 || img->height == 0) {
+    say_error_set("can't add an empty image to an atlas");
+    return false;
+  }
+
+  if (img->mipmapped) {
+    say_error_set("can't add a mipmapped image to an atlas");
+    return false;
+  }
+
+  size_t w = img->width  + 2 * atlas->padding;
+  size_t h = img->height + 2 * atlas->padding;
+
+  if (w > atlas->max_width || h > atlas->max_height) {
+    say_error_set("image is too large to fit in an atlas page");
+    return false;
+  }
+
+  /* Read back anything rendered to the image before dropping its texture */
+  say_image_get_buffer(img);
+
+  if (img->atlas)
+    say_atlas_remove(img->atlas, img);
+
+  say_atlas_page *page = NULL;
+  size_t x = 0, y = 0;
+
+  for (size_t i = 0; i < atlas->pages.size && !page; i++) {
+    say_atlas_page *cur = mo_array_at(&atlas->pages, i);
+
+    do {
+      if (say_skyline_insert(&cur->skyline, w, h, &x, &y)) {
+        page = cur;
+        break;
+      }
+    } while (say_atlas_page_grow(atlas, cur));
+  }
+
+  if (!page) {
+    say_atlas_page new_page;
+    if (!say_atlas_page_init(atlas, &new_page,
+                             say_atlas_size_for(w, atlas->max_width),
+                             say_atlas_size_for(h, atlas->max_height)))
+      return false;
+
+    mo_array_push(&atlas->pages, &new_page);
+    page = mo_array_at(&atlas->pages, atlas->pages.size - 1);
+
+    say_skyline_insert(&page->skyline, w, h, &x, &y);
+  }
+
+  mo_array_push(&atlas->images, &img);
+  say_image_set_atlas(img, atlas, page->image,
+                      x + atlas->padding, y + atlas->padding);
+
+  return true;
+}
+
+void say_atlas_remove(say_atlas *atlas, say_image *img) {
+  if (img->atlas != atlas)
+    return;
+
+  for (size_t i = 0; i < atlas->images.size; i++) {
+    if (mo_array_get_as(&atlas->images, i, say_image*) == img) {
+      mo_array_delete(&atlas->images, i);
+      break;
+    }
+  }
+
+  say_image_set_atlas(img, NULL, NULL, 0, 0);
+}
+
+bool say_atlas_contains(say_atlas *atlas, say_image *img) {
+  return img->atlas == atlas;
+}
+
+size_t say_atlas_get_size(say_atlas *atlas) {
+  return atlas->images.size;
+}
+
+size_t say_atlas_get_page_count(say_atlas *atlas) {
+  return atlas->pages.size;
+}
+
+say_image *say_atlas_get_page(say_atlas *atlas, size_t id) {
+  if (id >= atlas->pages.size)
+    return NULL;
+
+  return ((say_atlas_page*)mo_array_at(&atlas->pages, id))->image;
+}
+
+size_t say_atlas_get_padding(say_atlas *atlas) {
+  return atlas->padding;
+}
+
+void say_atlas_set_padding(say_atlas *atlas, size_t padding) {
+  atlas->padding = padding;
+}
+
+bool say_atlas_is_smooth(say_atlas *atlas) {
+  return atlas->smooth;
+}
+
+void say_atlas_set_smooth(say_atlas *atlas, bool val) {
+  atlas->smooth = val;
+
+  for (size_t i = 0; i < atlas->pages.size; i++) {
+    say_atlas_page *page = mo_array_at(&atlas->pages, i);
+    say_image_set_smooth(page->image, val);
+  }
+}
+
+void say_atlas_blit(say_atlas *atlas, say_image *img) {
+  say_image *page = img->atlas_page;
+  if (!page)
+    return;
+
+  /* Only the modified parts of the image are copied */
+  for (size_t i = 0; i < img->dirty_count; i++) {
+    say_dirty_rect *rect = &img->dirty[i];
+
+    size_t x = rect->x0, w = rect->x1 - rect->x0;
+    size_t y = rect->y0, h = rect->y1 - rect->y0;
+
+    size_t dst_row = img->atlas_y + y;
+
+    for (size_t j = 0; j < h; j++) {
+      memcpy(&page->pixels[(dst_row + j) * page->width + img->atlas_x + x],
+             &img->pixels[(y + j) * img->width + x],
+             sizeof(say_color) * w);
+    }
+
+    say_image_mark_rect_out_of_date(page, img->atlas_x + x, img->atlas_y + y,
+                                    w, h);
+  }
+}
+
+void say_atlas_set_data(say_atlas *atlas, void *data) {
+  atlas->data = data;
+}
+
+void *say_atlas_get_data(say_atlas *atlas) {
+  return atlas->data;
+}
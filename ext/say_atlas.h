@@ -0,0 +1,61 @@
+#ifndef SAY_ATLAS_H_
+#define SAY_ATLAS_H_
+
+#include "say_image.h"
+
+typedef struct {
+  size_t x, y, width;
+} say_skyline_node;
+
+typedef struct {
+  mo_array nodes;
+  size_t width, height;
+} say_skyline;
+
+void say_skyline_init(say_skyline *skyline, size_t w, size_t h);
+void say_skyline_release(say_skyline *skyline);
+
+void say_skyline_grow(say_skyline *skyline, size_t w, size_t h);
+bool say_skyline_insert(say_skyline *skyline, size_t w, size_t h,
+                        size_t *x, size_t *y);
+
+typedef struct {
+  say_image   *image;
+  say_skyline  skyline;
+} say_atlas_page;
+
+typedef struct say_atlas {
+  mo_array pages;  /* say_atlas_page */
+  mo_array images; /* say_image*     */
+
+  size_t max_width, max_height;
+  size_t padding;
+
+  bool smooth;
+
+  void *data;
+} say_atlas;
+
+say_atlas *say_atlas_create(size_t max_width, size_t max_height);
+void say_atlas_free(say_atlas *atlas);
+
+bool say_atlas_add(say_atlas *atlas, say_image *img);
+void say_atlas_remove(say_atlas *atlas, say_image *img);
+bool say_atlas_contains(say_atlas *atlas, say_image *img);
+
+size_t say_atlas_get_size(say_atlas *atlas);
+size_t say_atlas_get_page_count(say_atlas *atlas);
+say_image *say_atlas_get_page(say_atlas *atlas, size_t id);
+
+size_t say_atlas_get_padding(say_atlas *atlas);
+void say_atlas_set_padding(say_atlas *atlas, size_t padding);
+
+bool say_atlas_is_smooth(say_atlas *atlas);
+void say_atlas_set_smooth(say_atlas *atlas, bool val);
+
+void say_atlas_blit(say_atlas *atlas, say_image *img);
+
+void say_atlas_set_data(say_atlas *atlas, void *data);
+void *say_atlas_get_data(say_atlas *atlas);
+
+#endif
@@ -4,13 +4,62 @@
 #include "say_basic_type.h"
 #include "say_thread.h"
 
+/* Largest channel layout OpenAL can play (7.1) */
+#define SAY_AUDIO_MAX_CHANNELS 8
+
+/*
+ * Converts decoded samples to the layout that is sent to OpenAL: channels are
+ * mixed down, gain is applied, and the sample rate is converted to the one of
+ * the device so that OpenAL doesn't need to resample while mixing.
+ *
+ * Resampling keeps state between calls, so that streams can be converted one
+ * chunk at a time.
+ */
+typedef struct {
+  size_t in_channels,  in_rate;
+  size_t out_channels, out_rate;
+
+  float gain;
+
+  double pos;     /* position of the next output frame in the input */
+  float last[SAY_AUDIO_MAX_CHANNELS]; /* last input frame of the previous chunk */
+
+  float *scratch;
+  size_t scratch_size;
+} say_audio_converter;
+
+/*
+ * Identifies a sound file (by its contents when loaded from memory, by its path
+ * and modification time otherwise), so that buffers loaded from identical files
+ * can share their OpenAL buffer.
+ */
+typedef struct {
+  uint64_t hash;
+  size_t   size;
+} say_sound_key;
+
 typedef struct {
   ALuint buf;
 
   short *samples;
   size_t sample_count;
 
+  size_t channel_count;
+  size_t sample_rate;
+
   float duration;
+
+  /* Samples are freed once uploaded unless this is set (the default) */
+  bool keep_samples;
+
+  /* Conversion applied when loading */
+  size_t target_channels; /* 0 to keep the channels of the file */
+  bool   resample;
+  float  gain;
+
+  bool          cached;
+  say_sound_key key;
+  size_t        cache_generation;
 } say_sound_buffer;
 
 typedef enum {
@@ -19,25 +68,64 @@ typedef enum {
   SAY_STATUS_PLAYING
 } say_audio_status;
 
+/*
+ * Source properties are kept on the CPU side, so that pooled sources can lose
+ * their OpenAL source and have it restored when they get a voice back.
+ */
 typedef struct {
-  ALuint src;
+  ALuint src; /* 0 while a pooled source has no voice */
+  bool pooled;
+
+  float pitch;
+  float gain;
+
+  say_vector3 pos;
+  uint8_t relative;
+
+  float min_distance;
+  float attenuation;
 } say_audio_source;
 
 typedef struct {
   say_audio_source *src;
   say_sound_buffer *buf;
+
+  bool looping;
+  float offset; /* position to start from when a voice is acquired */
+
+  int priority;
 } say_sound;
 
-#define SAY_MUSIC_BUF_COUNT 3
+#define SAY_MIXER_DEFAULT_VOICE_COUNT 32
 
+#define SAY_MUSIC_DEFAULT_BUF_COUNT 3
+
+/* Used until a file is opened, at which point buffers hold one second */
+#define SAY_MUSIC_DEFAULT_BUF_SIZE  44100
+
+/*
+ * Musics are streamed by a single thread shared by all of them. Every field
+ * below is protected by a global lock.
+ */
 typedef struct {
   say_audio_source *src;
-  say_thread *thread;
 
-  ALuint buffers[SAY_MUSIC_BUF_COUNT];
+  ALuint *buffers;
+  size_t buffer_count;
+  size_t buffer_size; /* in frames */
+  bool   custom_buffer_size;
+
+  /* Preallocated storage for one buffer worth of samples */
+  short *chunk;
+  size_t chunk_capacity;
+
+  say_audio_converter converter;
+
+  short *converted;
+  size_t converted_capacity;
+
   ALuint last_buffer;
 
-  bool continue_running;
   bool streaming;
 
   bool looping;
@@ -82,6 +170,27 @@ say_vector3 say_audio_get_pos();
 say_vector3 say_audio_get_direction();
 
 ALenum say_audio_get_format(size_t channel_count);
+size_t say_audio_get_device_rate();
+
+/* Format conversion */
+
+void say_audio_s16_to_float(const short *in, float *out, size_t count);
+void say_audio_float_to_s16(const float *in, short *out, size_t count);
+
+void say_audio_converter_init(say_audio_converter *conv,
+                              size_t in_channels, size_t in_rate,
+                              size_t out_channels, size_t out_rate,
+                              float gain);
+void say_audio_converter_release(say_audio_converter *conv);
+
+void say_audio_converter_reset(say_audio_converter *conv);
+
+bool say_audio_converter_is_identity(say_audio_converter *conv);
+size_t say_audio_converter_get_max_output(say_audio_converter *conv,
+                                          size_t in_frames);
+
+size_t say_audio_converter_run(say_audio_converter *conv, const short *in,
+                               size_t in_frames, short *out);
 
 /* Sound buffers */
 
@@ -92,6 +201,18 @@ int say_sound_buffer_load_from_memory(say_sound_buffer *buf, size_t len,
                                        const char *str);
 int say_sound_buffer_load_from_file(say_sound_buffer *buf, const char *filename);
 
+void say_sound_buffer_set_keep_samples(say_sound_buffer *buf, bool val);
+
+void say_sound_buffer_set_conversion(say_sound_buffer *buf, size_t channels,
+                                     bool resample, float gain);
+bool say_sound_buffer_keeps_samples(say_sound_buffer *buf);
+
+bool say_sound_buffer_is_shared(say_sound_buffer *buf);
+size_t say_sound_buffer_get_cache_size();
+void say_sound_buffer_clean_up();
+
+float say_sound_file_get_duration(const char *filename);
+
 short *say_sound_buffer_get_samples(say_sound_buffer *buf);
 size_t say_sound_buffer_get_sample_count(say_sound_buffer *buf);
 size_t say_sound_buffer_get_channel_count(say_sound_buffer *buf);
@@ -101,8 +222,11 @@ float say_sound_buffer_get_duration(say_sound_buffer *buf);
 /* Audio sources */
 
 say_audio_source *say_audio_source_create();
+say_audio_source *say_audio_source_create_pooled();
 void say_audio_source_free(say_audio_source *src);
 
+void say_audio_source_apply(say_audio_source *src);
+
 void say_audio_source_set_pitch(say_audio_source *src, float pitch);
 float say_audio_source_get_pitch(say_audio_source *src);
 
@@ -143,6 +267,22 @@ void say_sound_play(say_sound *snd);
 void say_sound_pause(say_sound *snd);
 void say_sound_stop(say_sound *snd);
 
+void say_sound_set_priority(say_sound *snd, int priority);
+int say_sound_get_priority(say_sound *snd);
+
+bool say_sound_has_voice(say_sound *snd);
+
+/* Voice pool */
+
+bool say_mixer_acquire(say_sound *snd);
+void say_mixer_release(say_sound *snd);
+
+void say_mixer_set_voice_count(size_t count);
+size_t say_mixer_get_voice_count();
+size_t say_mixer_get_active_voice_count();
+
+void say_mixer_clean_up();
+
 /* Virtual files */
 
 sf_count_t say_vfile_get_size(say_vfile *file);
@@ -158,6 +298,12 @@ void say_music_free(say_music *music);
 
 bool say_music_open(say_music *music, const char *filename);
 
+void say_music_set_buffer_count(say_music *music, size_t count);
+size_t say_music_get_buffer_count(say_music *music);
+
+void say_music_set_buffer_size(say_music *music, size_t frames);
+size_t say_music_get_buffer_size(say_music *music);
+
 void say_music_set_looping(say_music *music, bool val);
 bool say_music_is_looping(say_music *music);
 
@@ -170,4 +316,6 @@ void say_music_play(say_music *music);
 void say_music_pause(say_music *music);
 void say_music_stop(say_music *music);
 
+void say_music_clean_up();
+
 #endif
@@ -23,7 +23,21 @@ void say_audio_context_ensure() {
   }
 }
 
+size_t say_audio_get_device_rate() {
+  say_audio_context_ensure();
+
+  ALCint rate = 0;
+  if (say_audio_device)
+    alcGetIntegerv(say_audio_device, ALC_FREQUENCY, 1, &rate);
+
+  return rate > 0 ? rate : 44100;
+}
+
 void say_audio_context_clean_up() {
+  say_music_clean_up();
+  say_mixer_clean_up();
+  say_sound_buffer_clean_up();
+
   alcMakeContextCurrent(NULL);
 
   if (say_audio_context)
@@ -0,0 +1,213 @@
+#include "say.h"
+
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+
+void say_audio_s16_to_float(const short *in, float *out, size_t count) {
+  size_t i = 0;
+
+#ifdef __SSE2__
+  const __m128 scale = _mm_set1_ps(1.0f / 32768.0f);
+
+  for (; i + 8 <= count; i += 8) {
+    __m128i s16 = _mm_loadu_si128((const __m128i*)(in + i));
+
+    /* Sign-extend by unpacking into the high half and shifting back */
+    __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s16, s16), 16);
+    __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s16, s16), 16);
+
+    _mm_storeu_ps(out + i,     _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+    _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+  }
+#endif
+
+  for (; i < count; i++)
+    out[i] = in[i] * (1.0f / 32768.0f);
+}
+
+void say_audio_float_to_s16(const float *in, short *out, size_t count) {
+  size_t i = 0;
+
+#ifdef __SSE2__
+  const __m128 scale = _mm_set1_ps(32767.0f);
+
+  for (; i + 8 <= count; i += 8) {
+    __m128i lo = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(in + i), scale));
+    __m128i hi = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(in + i + 4), scale));
+
+    /* Packing saturates, which takes care of clipping */
+    _mm_storeu_si128((__m128i*)(out + i), _mm_packs_epi32(lo, hi));
+  }
+#endif
+
+  for (; i < count; i++) {
+    float val = in[i] * 32767.0f;
+
+    if (val > 32767.0f)       out[i] = 32767;
+    else if (val < -32768.0f) out[i] = -32768;
+    else                      out[i] = (short)lrintf(val);
+  }
+}
+
+void say_audio_converter_init(say_audio_converter *conv,
+                              size_t in_channels, size_t in_rate,
+                              size_t out_channels, size_t out_rate,
+                              float gain) {
+  conv->in_channels  = in_channels;
+  conv->in_rate      = in_rate;
+  conv->out_channels = out_channels;
+  conv->out_rate     = out_rate;
+
+  conv->gain = gain;
+
+  conv->scratch      = NULL;
+  conv->scratch_size = 0;
+
+  say_audio_converter_reset(conv);
+}
+
+void say_audio_converter_release(say_audio_converter *conv) {
+  free(conv->scratch);
+
+  conv->scratch      = NULL;
+  conv->scratch_size = 0;
+}
+
+void say_audio_converter_reset(say_audio_converter *conv) {
+  conv->pos = 0;
+  memset(conv->last, 0, sizeof(conv->last));
+}
+
+bool say_audio_converter_is_identity(say_audio_converter *conv) {
+  return conv->in_channels == conv->out_channels &&
+    conv->in_rate == conv->out_rate &&
+    conv->gain == 1;
+}
+
+size_t say_audio_converter_get_max_output(say_audio_converter *conv,
+                                          size_t in_frames) {
+  if (conv->in_rate == conv->out_rate)
+    return in_frames;
+
+  return (size_t)((double)(in_frames + 1) * conv->out_rate / conv->in_rate) + 2;
+}
+
+/*
+ * Mixes channels down (or duplicates a mono channel) and applies gain, in
+ * place. Stereo output gets even channels on the left and odd ones on the
+ * right, which matches the usual interleaving of surround formats.
+ */
+static void say_audio_converter_mix(say_audio_converter *conv, float *samples,
+                                    size_t frames) {
+  size_t in_ch = conv->in_channels, out_ch = conv->out_channels;
+  float gain = conv->gain;
+
+  if (in_ch == out_ch) {
+    if (gain != 1) {
+      for (size_t i = 0; i < frames * in_ch; i++)
+        samples[i] *= gain;
+    }
+  }
+  else if (out_ch == 1) {
+    float scale = gain / in_ch;
+
+    for (size_t i = 0; i < frames; i++) {
+      float sum = 0;
+      for (size_t c = 0; c < in_ch; c++)
+        sum += samples[i * in_ch + c];
+
+      samples[i] = sum * scale;
+    }
+  }
+  else if (in_ch == 1) {
+    /* Going backwards, so that no sample is overwritten before it is read */
+    for (size_t i = frames; i-- > 0;)
+      samples[2 * i] = samples[2 * i + 1] = samples[i] * gain;
+  }
+  else {
+    float left_scale  = gain / ((in_ch + 1) / 2);
+    float right_scale = gain / (in_ch / 2);
+
+    for (size_t i = 0; i < frames; i++) {
+      float left = 0, right = 0;
+
+      for (size_t c = 0; c < in_ch; c += 2) left  += samples[i * in_ch + c];
+      for (size_t c = 1; c < in_ch; c += 2) right += samples[i * in_ch + c];
+
+      samples[2 * i]     = left  * left_scale;
+      samples[2 * i + 1] = right * right_scale;
+    }
+  }
+}
+
+/* Linear interpolation; the last frame of each chunk is kept for the next one */
+static size_t say_audio_converter_resample(say_audio_converter *conv,
+                                           const float *in, size_t in_frames,
+                                           float *out) {
+  size_t ch = conv->out_channels;
+  double step = (double)conv->in_rate / conv->out_rate;
+
+  double pos = conv->pos;
+  size_t count = 0;
+
+  while (in_frames > 0 && pos + 1 < in_frames) {
+    long   i    = (long)floor(pos);
+    float  frac = (float)(pos - i);
+
+    for (size_t c = 0; c < ch; c++) {
+      float a = i < 0 ? conv->last[c] : in[i * ch + c];
+      float b = in[(i + 1) * ch + c];
+
+      out[count * ch + c] = a + (b - a) * frac;
+    }
+
+    count++;
+    pos += step;
+  }
+
+  if (in_frames > 0) {
+    for (size_t c = 0; c < ch; c++)
+      conv->last[c] = in[(in_frames - 1) * ch + c];
+
+    conv->pos = pos - in_frames;
+  }
+
+  return count;
+}
+
+size_t say_audio_converter_run(say_audio_converter *conv, const short *in,
+                               size_t in_frames, short *out) {
+  size_t in_ch = conv->in_channels, out_ch = conv->out_channels;
+
+  if (say_audio_converter_is_identity(conv)) {
+    memcpy(out, in, sizeof(short) * in_frames * in_ch);
+    return in_frames;
+  }
+
+  size_t max_ch  = in_ch > out_ch ? in_ch : out_ch;
+  size_t mix_len = in_frames * max_ch;
+  size_t out_len = say_audio_converter_get_max_output(conv, in_frames) * out_ch;
+
+  if (mix_len + out_len > conv->scratch_size) {
+    conv->scratch_size = mix_len + out_len;
+    conv->scratch = realloc(conv->scratch, sizeof(float) * conv->scratch_size);
+  }
+
+  float *mixed     = conv->scratch;
+  float *resampled = conv->scratch + mix_len;
+
+  say_audio_s16_to_float(in, mixed, in_frames * in_ch);
+  say_audio_converter_mix(conv, mixed, in_frames);
+
+  size_t out_frames = in_frames;
+  if (conv->in_rate != conv->out_rate) {
+    out_frames = say_audio_converter_resample(conv, mixed, in_frames,
+                                              resampled);
+    mixed = resampled;
+  }
+
+  say_audio_float_to_s16(mixed, out, out_frames * out_ch);
+
+  return out_frames;
+}
@@ -1,88 +1,118 @@
 #include "say.h"
 
-say_audio_source *say_audio_source_create() {
+static say_audio_source *say_audio_source_alloc() {
   say_audio_context_ensure();
 
   say_audio_source *src = malloc(sizeof(say_audio_source));
+
+  src->src    = 0;
+  src->pooled = false;
+
+  src->pitch = 1;
+  src->gain  = 1;
+
+  src->pos      = say_make_vector3(0, 0, 0);
+  src->relative = 0;
+
+  src->min_distance = 1;
+  src->attenuation  = 1;
+
+  return src;
+}
+
+say_audio_source *say_audio_source_create() {
+  say_audio_source *src = say_audio_source_alloc();
   alGenSources(1, &src->src);
 
   return src;
 }
 
+say_audio_source *say_audio_source_create_pooled() {
+  say_audio_source *src = say_audio_source_alloc();
+  src->pooled = true;
+
+  return src;
+}
+
 void say_audio_source_free(say_audio_source *src) {
-  alSourcei(src->src, AL_BUFFER, 0);
-  alDeleteSources(1, &src->src);
+  if (!src->pooled) {
+    alSourcei(src->src, AL_BUFFER, 0);
+    alDeleteSources(1, &src->src);
+  }
+
   free(src);
 }
 
+void say_audio_source_apply(say_audio_source *src) {
+  if (!src->src)
+    return;
+
+  alSourcef(src->src, AL_PITCH, src->pitch);
+  alSourcef(src->src, AL_GAIN, src->gain);
+  alSource3f(src->src, AL_POSITION, src->pos.x, src->pos.y, src->pos.z);
+  alSourcei(src->src, AL_SOURCE_RELATIVE, src->relative);
+  alSourcef(src->src, AL_REFERENCE_DISTANCE, src->min_distance);
+  alSourcef(src->src, AL_ROLLOFF_FACTOR, src->attenuation);
+}
+
 void say_audio_source_set_pitch(say_audio_source *src, float pitch) {
-  alSourcef(src->src, AL_PITCH, pitch);
+  src->pitch = pitch;
+  if (src->src) alSourcef(src->src, AL_PITCH, pitch);
 }
 
 float say_audio_source_get_pitch(say_audio_source *src) {
-  float pitch;
-  alGetSourcef(src->src, AL_PITCH, &pitch);
-
-  return pitch;
+  return src->pitch;
 }
 
 void say_audio_source_set_volume(say_audio_source *src, float vol) {
-  alSourcef(src->src, AL_GAIN, vol / 100);
+  src->gain = vol / 100;
+  if (src->src) alSourcef(src->src, AL_GAIN, src->gain);
 }
 
 float say_audio_source_get_volume(say_audio_source *src) {
-  float vol;
-  alGetSourcef(src->src, AL_GAIN, &vol);
-
-  return vol * 100;
+  return src->gain * 100;
 }
 
 void say_audio_source_set_pos(say_audio_source *src, say_vector3 pos) {
-  alSource3f(src->src, AL_POSITION, pos.x, pos.y, pos.z);
+  src->pos = pos;
+  if (src->src) alSource3f(src->src, AL_POSITION, pos.x, pos.y, pos.z);
 }
 
 say_vector3 say_audio_source_get_pos(say_audio_source *src) {
-  say_vector3 pos;
-  alGetSource3f(src->src, AL_POSITION, &pos.x, &pos.y, &pos.z);
-
-  return pos;
+  return src->pos;
 }
 
 void say_audio_source_set_relative(say_audio_source *src, uint8_t rel) {
-  alSourcei(src->src, AL_SOURCE_RELATIVE, rel);
+  src->relative = rel;
+  if (src->src) alSourcei(src->src, AL_SOURCE_RELATIVE, rel);
 }
 
 uint8_t say_audio_source_get_relative(say_audio_source *src) {
-  ALint rel;
-  alGetSourcei(src->src, AL_SOURCE_RELATIVE, &rel);
-
-  return rel;
+  return src->relative;
 }
 
 void say_audio_source_set_min_distance(say_audio_source *src, float dist) {
-  alSourcef(src->src, AL_REFERENCE_DISTANCE, dist);
+  src->min_distance = dist;
+  if (src->src) alSourcef(src->src, AL_REFERENCE_DISTANCE, dist);
 }
 
-
 float say_audio_source_get_min_distance(say_audio_source *src) {
-  ALfloat dist;
-  alGetSourcef(src->src, AL_REFERENCE_DISTANCE, &dist);
-
-  return dist;
+  return src->min_distance;
 }
 
 void say_audio_source_set_attenuation(say_audio_source *src, float att) {
-  alSourcef(src->src, AL_ROLLOFF_FACTOR, att);
+  src->attenuation = att;
+  if (src->src) alSourcef(src->src, AL_ROLLOFF_FACTOR, att);
 }
 
 float say_audio_source_get_attenuation(say_audio_source *src) {
-  ALfloat att;
-  alGetSourcef(src->src, AL_ROLLOFF_FACTOR, &att);
-
-  return att;
+  return src->attenuation;
 }
 
 say_audio_status say_audio_source_get_status(say_audio_source *src) {
+  if (!src->src)
+    return SAY_STATUS_STOPPED;
+
   ALint status;
   alGetSourcei(src->src, AL_SOURCE_STATE, &status);
 
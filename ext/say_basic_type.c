@@ -16,17 +16,6 @@ bool say_color_eq(say_color a, say_color b) {
   return a.r == b.r && a.g == b.g  && a.b == b.b && a.a == b.a;
 }
 
-say_color *say_flip_color_buffer_copy(say_color *buf, size_t width,
-                                      size_t height) {
-  size_t     line_size = sizeof(say_color) * width;
-  say_color *ret       = malloc(line_size * height);
-
-  for (size_t y = 0; y < height; y++)
-    memcpy(&ret[y * width], &buf[(height - y - 1) * width], line_size);
-
-  return ret;
-}
-
 void say_flip_color_buffer(say_color *buffer, size_t width, size_t height) {
   size_t     line_size = sizeof(say_color) * width;
   say_color *temp_line = malloc(line_size);
@@ -353,6 +353,28 @@ void say_buffer_resize(say_buffer *buf, size_t size) {
                buf->type);
 }
 
+void say_buffer_resize_storage(say_buffer *buf, size_t size) {
+  say_context_ensure();
+  say_vbo_make_current(buf->vbo);
+  glBufferData(GL_ARRAY_BUFFER, size * buf->buffer.el_size, NULL, buf->type);
+}
+
+void *say_buffer_map_range(say_buffer *buf, size_t id, size_t size,
+                           GLbitfield access) {
+  say_context_ensure();
+
+  size_t byte_size = buf->buffer.el_size;
+  say_vbo_make_current(buf->vbo);
+  return glMapBufferRange(GL_ARRAY_BUFFER, byte_size * id, byte_size * size,
+                          access);
+}
+
+void say_buffer_unmap(say_buffer *buf) {
+  say_context_ensure();
+  say_vbo_make_current(buf->vbo);
+  glUnmapBuffer(GL_ARRAY_BUFFER);
+}
+
 void say_buffer_update_instance_part(say_buffer *buf, size_t id,
                                      size_t size) {
   if (size == 0) return;
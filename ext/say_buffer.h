@@ -39,6 +39,11 @@ void say_buffer_update(say_buffer *buf);
 size_t say_buffer_get_size(say_buffer *buf);
 void say_buffer_resize(say_buffer *buf, size_t size);
 
+void say_buffer_resize_storage(say_buffer *buf, size_t size);
+void *say_buffer_map_range(say_buffer *buf, size_t id, size_t size,
+                           GLbitfield access);
+void say_buffer_unmap(say_buffer *buf);
+
 void say_buffer_update_instance_part(say_buffer *buf, size_t index,
                                      size_t size);
 void say_buffer_update_instance(say_buffer *buf);
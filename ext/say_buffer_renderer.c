@@ -1,10 +1,187 @@
 #include "say.h"
 
+#define SAY_FENCE_TIMEOUT 1000000000 /* 1s, in nanoseconds */
+
+static bool say_has_map_buffer_range() {
+  return GLEW_ARB_map_buffer_range || GLEW_VERSION_3_0;
+}
+
+static bool say_has_sync() {
+  return GLEW_ARB_sync || GLEW_VERSION_3_2;
+}
+
 static void say_buffer_renderer_resize_buffer(say_buffer_renderer *renderer,
                                               size_t size) {
   say_buffer_resize(renderer->buffer, size);
 }
 
+static void say_buffer_renderer_delete_fence(say_buffer_renderer *renderer,
+                                             size_t region) {
+  if (renderer->fences[region]) {
+    glDeleteSync(renderer->fences[region]);
+    renderer->fences[region] = NULL;
+  }
+}
+
+static void say_buffer_renderer_wait_fence(say_buffer_renderer *renderer,
+                                           size_t region) {
+  GLsync fence = renderer->fences[region];
+  if (!fence)
+    return;
+
+  while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                          SAY_FENCE_TIMEOUT) == GL_TIMEOUT_EXPIRED);
+
+  say_buffer_renderer_delete_fence(renderer, region);
+}
+
+static void say_buffer_renderer_unmap(say_buffer_renderer *renderer) {
+  if (!renderer->mapped)
+    return;
+
+  if (renderer->vertices)
+    say_buffer_unmap(renderer->buffer);
+
+  if (renderer->indices)
+    say_index_buffer_unmap(renderer->index_buffer);
+
+  renderer->vertices = NULL;
+  renderer->indices  = NULL;
+  renderer->mapped   = false;
+}
+
+static void say_buffer_renderer_fill(say_buffer_renderer *renderer,
+                                     say_drawable *drawable,
+                                     size_t vertex, size_t index) {
+  void *vertices;
+  GLuint *indices;
+  size_t from = vertex;
+
+  if (renderer->streaming) {
+    vertices = renderer->vertices + (vertex - renderer->mapped_vertex) *
+      renderer->buffer->buffer.el_size;
+    indices  = renderer->indices + (index - renderer->mapped_index);
+    from    += renderer->region * renderer->vertex_capa;
+  }
+  else {
+    vertices = say_buffer_get_vertex(renderer->buffer, vertex);
+    indices  = say_index_buffer_get(renderer->index_buffer, index);
+  }
+
+  say_drawable_fill_buffer(drawable, vertices);
+  say_drawable_fill_index_buffer(drawable, indices, from);
+}
+
+static void say_buffer_renderer_refill(say_buffer_renderer *renderer) {
+  size_t vertex = 0, index = 0;
+  for (size_t i = 0; i < renderer->drawables.size; i++) {
+    say_drawable *drawable = mo_array_get_as(&renderer->drawables, i,
+                                             say_drawable*);
+    say_buffer_renderer_fill(renderer, drawable, vertex, index);
+
+    vertex += say_drawable_get_vertex_count(drawable);
+    index  += say_drawable_get_index_count(drawable);
+  }
+}
+
+static void say_buffer_renderer_stop_streaming(say_buffer_renderer *renderer) {
+  say_buffer_renderer_unmap(renderer);
+
+  for (size_t i = 0; i < SAY_STREAM_REGION_COUNT; i++)
+    say_buffer_renderer_delete_fence(renderer, i);
+
+  renderer->streaming = false;
+
+  say_buffer_resize(renderer->buffer, renderer->vertex_capa);
+  say_index_buffer_resize(renderer->index_buffer, renderer->index_capa);
+
+  say_buffer_renderer_refill(renderer);
+}
+
+static void say_buffer_renderer_map(say_buffer_renderer *renderer,
+                                    size_t vertex, size_t index) {
+  GLbitfield access = GL_MAP_WRITE_BIT;
+
+  if (vertex != 0 || index != 0) {
+    /*
+     * Only the end of the region, which nothing is reading from yet, is
+     * mapped when more drawables are pushed after rendering.
+     */
+    if (say_has_sync())
+      access |= GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+  }
+  else if (say_has_sync()) {
+    /*
+     * The fence tells us when the GPU is done reading the region, so the
+     * driver doesn't need to synchronize anything.
+     */
+    say_buffer_renderer_wait_fence(renderer, renderer->region);
+    access |= GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+  }
+  else {
+    /* Without fences, let the driver orphan the whole storage instead. */
+    renderer->region = 0;
+    access |= GL_MAP_INVALIDATE_BUFFER_BIT;
+  }
+
+  renderer->mapped        = true;
+  renderer->mapped_vertex = vertex;
+  renderer->mapped_index  = index;
+
+  renderer->vertices = say_buffer_map_range(renderer->buffer,
+                                            renderer->region *
+                                            renderer->vertex_capa + vertex,
+                                            renderer->vertex_capa - vertex,
+                                            access);
+  renderer->indices = say_index_buffer_map_range(renderer->index_buffer,
+                                                 renderer->region *
+                                                 renderer->index_capa + index,
+                                                 renderer->index_capa - index,
+                                                 access);
+
+  if (!renderer->vertices || !renderer->indices)
+    say_buffer_renderer_stop_streaming(renderer);
+}
+
+static void say_buffer_renderer_reserve_stream(say_buffer_renderer *renderer,
+                                               size_t vertex_count,
+                                               size_t index_count) {
+  /* One element is always kept free so that there's something to map. */
+  if (vertex_count < renderer->vertex_capa &&
+      index_count < renderer->index_capa) {
+    if (!renderer->mapped) {
+      say_buffer_renderer_map(renderer, renderer->current_vertex,
+                              renderer->current_index);
+    }
+
+    return;
+  }
+
+  say_buffer_renderer_unmap(renderer);
+
+  while (renderer->vertex_capa <= vertex_count)
+    renderer->vertex_capa *= 2;
+  while (renderer->index_capa <= index_count)
+    renderer->index_capa *= 2;
+
+  say_buffer_resize_storage(renderer->buffer,
+                            renderer->vertex_capa * SAY_STREAM_REGION_COUNT);
+  say_index_buffer_resize_storage(renderer->index_buffer,
+                                  renderer->index_capa *
+                                  SAY_STREAM_REGION_COUNT);
+
+  /*
+   * The old storage was orphaned: the GPU can't be reading from the new one,
+   * but what was already pushed this frame has to be written again.
+   */
+  for (size_t i = 0; i < SAY_STREAM_REGION_COUNT; i++)
+    say_buffer_renderer_delete_fence(renderer, i);
+
+  say_buffer_renderer_map(renderer, 0, 0);
+  if (renderer->streaming)
+    say_buffer_renderer_refill(renderer);
+}
+
 say_buffer_renderer *say_buffer_renderer_create(GLenum type,
                                                 size_t vtype) {
   say_buffer_renderer *renderer = malloc(sizeof(say_buffer_renderer));
@@ -19,10 +196,42 @@ say_buffer_renderer *say_buffer_renderer_create(GLenum type,
   renderer->current_vertex = 0;
   renderer->current_index  = 0;
 
+  renderer->streaming = type == SAY_STREAM && say_has_map_buffer_range() &&
+    !say_buffer_has_instance(renderer->buffer);
+  renderer->mapped   = false;
+  renderer->region   = 0;
+  renderer->vertices = NULL;
+  renderer->indices  = NULL;
+
+  renderer->mapped_vertex = 0;
+  renderer->mapped_index  = 0;
+
+  renderer->vertex_capa = 256;
+  renderer->index_capa  = 128;
+
+  for (size_t i = 0; i < SAY_STREAM_REGION_COUNT; i++)
+    renderer->fences[i] = NULL;
+
+  if (renderer->streaming) {
+    /* Vertices never go through the CPU-side copy when streaming. */
+    say_buffer_resize(renderer->buffer, 0);
+    say_index_buffer_resize(renderer->index_buffer, 0);
+
+    say_buffer_resize_storage(renderer->buffer,
+                              renderer->vertex_capa * SAY_STREAM_REGION_COUNT);
+    say_index_buffer_resize_storage(renderer->index_buffer,
+                                    renderer->index_capa *
+                                    SAY_STREAM_REGION_COUNT);
+  }
+
   return renderer;
 }
 
 void say_buffer_renderer_free(say_buffer_renderer *renderer) {
+  say_buffer_renderer_unmap(renderer);
+  for (size_t i = 0; i < SAY_STREAM_REGION_COUNT; i++)
+    say_buffer_renderer_delete_fence(renderer, i);
+
   say_buffer_free(renderer->buffer);
   say_index_buffer_free(renderer->index_buffer);
   mo_array_release(&renderer->drawables);
@@ -30,6 +239,11 @@ void say_buffer_renderer_free(say_buffer_renderer *renderer) {
 }
 
 void say_buffer_renderer_clear(say_buffer_renderer *renderer) {
+  if (renderer->streaming) {
+    say_buffer_renderer_unmap(renderer);
+    renderer->region = (renderer->region + 1) % SAY_STREAM_REGION_COUNT;
+  }
+
   renderer->current_vertex = 0;
   renderer->current_index  = 0;
   mo_array_resize(&renderer->drawables, 0);
@@ -44,32 +258,33 @@ bool say_buffer_renderer_push(say_buffer_renderer *renderer,
 
   size_t new_size = renderer->current_vertex +
     say_drawable_get_vertex_count(drawable);
-  size_t current_size = say_buffer_get_size(renderer->buffer);
-
-  if (current_size * 2 < new_size)
-    say_buffer_renderer_resize_buffer(renderer, new_size);
-  else if (current_size < new_size)
-    say_buffer_renderer_resize_buffer(renderer, current_size * 2);
-
   size_t index_new_size = renderer->current_index +
     say_drawable_get_index_count(drawable);
-  current_size = say_index_buffer_get_size(renderer->index_buffer);
 
-  if (current_size * 2 < index_new_size)
-    say_index_buffer_resize(renderer->index_buffer, index_new_size);
-  else if (current_size < index_new_size)
-    say_index_buffer_resize(renderer->index_buffer, current_size * 2);
+  if (renderer->streaming)
+    say_buffer_renderer_reserve_stream(renderer, new_size, index_new_size);
 
-  mo_array_push(&renderer->drawables, &drawable);
+  if (!renderer->streaming) {
+    size_t current_size = say_buffer_get_size(renderer->buffer);
 
-  say_drawable_fill_buffer(drawable,
-                           say_buffer_get_vertex(renderer->buffer,
-                                                 renderer->current_vertex));
+    if (current_size * 2 < new_size)
+      say_buffer_renderer_resize_buffer(renderer, new_size);
+    else if (current_size < new_size)
+      say_buffer_renderer_resize_buffer(renderer, current_size * 2);
 
-  say_drawable_fill_index_buffer(drawable,
-                                 say_index_buffer_get(renderer->index_buffer,
-                                                      renderer->current_index),
-                                 renderer->current_vertex);
+    current_size = say_index_buffer_get_size(renderer->index_buffer);
+
+    if (current_size * 2 < index_new_size)
+      say_index_buffer_resize(renderer->index_buffer, index_new_size);
+    else if (current_size < index_new_size)
+      say_index_buffer_resize(renderer->index_buffer, current_size * 2);
+  }
+
+  mo_array_push(&renderer->drawables, &drawable);
+
+  say_buffer_renderer_fill(renderer, drawable,
+                           renderer->current_vertex,
+                           renderer->current_index);
 
   renderer->current_vertex = new_size;
   renderer->current_index  = index_new_size;
@@ -78,12 +293,38 @@ bool say_buffer_renderer_push(say_buffer_renderer *renderer,
 }
 
 void say_buffer_renderer_update(say_buffer_renderer *renderer) {
+  if (renderer->streaming) {
+    say_buffer_renderer_unmap(renderer);
+    return;
+  }
+
   say_buffer_update(renderer->buffer);
   say_index_buffer_update(renderer->index_buffer);
 }
 
+bool say_buffer_renderer_is_streaming(say_buffer_renderer *renderer) {
+  return renderer->streaming;
+}
+
 void say_buffer_renderer_render(say_buffer_renderer *renderer,
                                 say_shader *shader) {
+  size_t base_vertex = 0, base_index = 0;
+  size_t vertex_limit, index_limit;
+
+  if (renderer->streaming) {
+    /* A buffer can't be drawn from while it is mapped */
+    say_buffer_renderer_unmap(renderer);
+
+    base_vertex  = renderer->region * renderer->vertex_capa;
+    base_index   = renderer->region * renderer->index_capa;
+    vertex_limit = renderer->vertex_capa;
+    index_limit  = renderer->index_capa;
+  }
+  else {
+    vertex_limit = say_buffer_get_size(renderer->buffer);
+    index_limit  = say_index_buffer_get_size(renderer->index_buffer);
+  }
+
   say_buffer_bind(renderer->buffer);
   say_index_buffer_bind(renderer->index_buffer);
 
@@ -109,16 +350,23 @@ void say_buffer_renderer_render(say_buffer_renderer *renderer,
 
     size_t next_vertex = current_vertex +
       say_drawable_get_vertex_count(drawable);
-    if (next_vertex > say_buffer_get_size(renderer->buffer))
-      return;
+    if (next_vertex > vertex_limit)
+      break;
 
     size_t next_index = current_index + say_drawable_get_index_count(drawable);
-    if (next_index > say_index_buffer_get_size(renderer->index_buffer))
-      return;
+    if (next_index > index_limit)
+      break;
 
-    say_drawable_draw_at(drawable, current_vertex, current_index, shader);
+    say_drawable_draw_at(drawable, base_vertex + current_vertex,
+                         base_index + current_index, shader);
 
     current_vertex = next_vertex;
     current_index  = next_index;
   }
+
+  if (renderer->streaming && say_has_sync()) {
+    say_buffer_renderer_delete_fence(renderer, renderer->region);
+    renderer->fences[renderer->region] =
+      glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  }
 }
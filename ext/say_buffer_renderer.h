@@ -5,6 +5,8 @@
 #include "say_buffer.h"
 #include "say_index_buffer.h"
 
+#define SAY_STREAM_REGION_COUNT 3
+
 typedef struct {
   say_buffer       *buffer;
   say_index_buffer *index_buffer;
@@ -16,6 +18,19 @@ typedef struct {
   size_t current_index;
 
   say_matrix *matrix;
+
+  /*
+   * In streaming mode, vertices are written directly into one of several
+   * regions of the GPU buffers, which are used in turn.
+   */
+  bool    streaming;
+  bool    mapped;
+  size_t  region;
+  size_t  vertex_capa, index_capa;
+  size_t  mapped_vertex, mapped_index;
+  uint8_t *vertices;
+  GLuint  *indices;
+  GLsync   fences[SAY_STREAM_REGION_COUNT];
 } say_buffer_renderer;
 
 say_buffer_renderer *say_buffer_renderer_create(GLenum type,
@@ -27,6 +42,8 @@ bool say_buffer_renderer_push(say_buffer_renderer *renderer,
                               say_drawable *drawable);
 void say_buffer_renderer_update(say_buffer_renderer *renderer);
 
+bool say_buffer_renderer_is_streaming(say_buffer_renderer *renderer);
+
 void say_buffer_renderer_render(say_buffer_renderer *renderer,
                                 say_shader *shader);
 
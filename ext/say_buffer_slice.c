@@ -5,6 +5,32 @@
 /* 4 MB of vertices per buffer */
 #define SAY_BUFFER_BYTE_SIZE ((4 * 1024 * 1024))
 
+/*
+ * Dirty ranges separated by less than this amount of vertices are uploaded
+ * together: sending a few unchanged vertices is cheaper than another call.
+ */
+#define SAY_DIRTY_RANGE_MAX_GAP 64
+
+/*
+ * Past this amount of dirty ranges, the whole buffer is uploaded instead. This
+ * also bounds the memory used when many slices are updated before a draw.
+ */
+#define SAY_DIRTY_RANGE_MAX_COUNT 32
+
+/*
+ * Vertices are distributed using a buddy allocator. Each global buffer holds
+ * 2^max_order vertices, and each slice is given a block of 2^order vertices
+ * (the smallest one that's big enough). Free blocks are stored in one list per
+ * order, so that finding room only requires to look at non-empty lists, and
+ * are indexed by location, so that a block that gets freed can find out if its
+ * buddy is free too and merge with it.
+ */
+
+typedef struct {
+  size_t      order;
+  mo_list_it *it;
+} say_free_block;
+
 typedef struct {
   size_t loc, size;
 } say_range;
@@ -13,26 +39,87 @@ typedef struct {
 
 typedef struct {
   say_buffer *buf;
-  mo_list     ranges;
+
+  size_t  max_order;
+  mo_list free_lists[SAY_BUFFER_SLICE_MAX_ORDER];
+  mo_hash free_blocks;
+
+  size_t used, allocated;
+
+  /*
+   * Parts of the buffer that were modified since the last upload. They are
+   * only sent to the GPU before the buffer gets used for drawing.
+   */
+  mo_array dirty_ranges;
 } say_global_buffer;
 
 static mo_array *say_global_buffers = NULL;
 
+static size_t say_order_floor(size_t n) {
+  size_t order = 0;
+  while (n >>= 1)
+    order++;
+
+  return order;
+}
+
+static size_t say_order_for(size_t n) {
+  return n <= 1 ? 0 : say_order_floor(n - 1) + 1;
+}
+
+#define say_order_size(order) ((size_t)1 << (order))
+
 static void say_global_buffer_free(say_global_buffer *buf) {
   say_buffer_free(buf->buf);
-  mo_list_release(&buf->ranges);
+
+  for (size_t i = 0; i < SAY_BUFFER_SLICE_MAX_ORDER; i++)
+    mo_list_release(&buf->free_lists[i]);
+  mo_hash_release(&buf->free_blocks);
+
+  mo_array_release(&buf->dirty_ranges);
+}
+
+static void say_global_buffer_push_free(say_global_buffer *buf, size_t loc,
+                                        size_t order) {
+  mo_list *list = &buf->free_lists[order];
+  mo_list_prepend(list, list->head, &loc);
+
+  say_free_block block = {order, list->head};
+  mo_hash_set(&buf->free_blocks, &loc, &block);
+}
+
+static void say_global_buffer_remove_free(say_global_buffer *buf, size_t loc,
+                                          size_t order, mo_list_it *it) {
+  mo_list_delete(&buf->free_lists[order], it);
+  mo_hash_del(&buf->free_blocks, &loc);
 }
 
 static say_global_buffer *say_global_buffer_create(mo_array *bufs,
-                                                   size_t vtype, size_t size) {
+                                                   size_t vtype, size_t order) {
   say_global_buffer buffer;
 
-  buffer.buf = say_buffer_create(vtype, SAY_STREAM, size);
-  mo_list_init(&buffer.ranges, sizeof(say_range));
+  buffer.buf = say_buffer_create(vtype, SAY_STREAM, say_order_size(order));
+
+  buffer.max_order = order;
+
+  for (size_t i = 0; i < SAY_BUFFER_SLICE_MAX_ORDER; i++)
+    mo_list_init(&buffer.free_lists[i], sizeof(size_t));
+
+  mo_hash_init(&buffer.free_blocks, sizeof(size_t), sizeof(say_free_block));
+  buffer.free_blocks.hash_of = mo_hash_of_size;
+  buffer.free_blocks.key_cmp = mo_hash_size_cmp;
+
+  buffer.used      = 0;
+  buffer.allocated = 0;
+
+  mo_array_init(&buffer.dirty_ranges, sizeof(say_range));
 
   mo_array_push(bufs, &buffer);
 
-  return mo_array_at(bufs, bufs->size - 1);
+  say_global_buffer *ret = mo_array_at(bufs, bufs->size - 1);
+  say_global_buffer_push_free(ret, 0, order);
+
+  return ret;
 }
 
 static void say_global_buffer_array_alloc(mo_array *ary) {
@@ -44,59 +131,54 @@ static void say_global_buffer_array_free(mo_array *ary) {
   mo_array_release(ary);
 }
 
-static size_t say_global_buffer_prepend(say_global_buffer *buf, size_t n) {
-  say_range range = say_make_range(0, n);
-  mo_list_prepend(&buf->ranges, buf->ranges.head, &range);
-  return 0;
-}
-
-static size_t say_global_buffer_insert(mo_list *list, mo_list_it *it,
-                                       size_t n) {
-  say_range *previous = mo_list_it_data_ptr(it, say_range);
+static size_t say_global_buffer_find(say_global_buffer *buf, size_t n) {
+  size_t order = say_order_for(n);
 
-  say_range range = say_make_range(previous->loc + previous->size, n);
-  mo_list_insert(list, it, &range);
+  /* Buffer too small for this object */
+  if (order > buf->max_order)
+    return SAY_MAX_SIZE;
 
-  return range.loc;
-}
+  size_t found = order;
+  while (found <= buf->max_order && !buf->free_lists[found].head)
+    found++;
 
-static size_t say_global_buffer_find(say_global_buffer *buf, size_t n) {
-  /* Buffer too small for this object */
-  if (n > say_buffer_get_size(buf->buf))
+  /* Not enough room here */
+  if (found > buf->max_order)
     return SAY_MAX_SIZE;
 
-  if (!buf->ranges.head) {
-    return say_global_buffer_prepend(buf, n);
-  }
+  mo_list_it *it  = buf->free_lists[found].head;
+  size_t      loc = mo_list_it_data_as(it, size_t);
+  say_global_buffer_remove_free(buf, loc, found, it);
 
-  say_range *first = mo_list_it_data_ptr(buf->ranges.head, say_range);
+  /* Split the block until it has the right size, freeing its upper halves */
+  while (found > order) {
+    found--;
+    say_global_buffer_push_free(buf, loc + say_order_size(found), found);
+  }
 
-  /* There's room at the begin of the buffer */
-  if (first->loc >= n)
-    return say_global_buffer_prepend(buf, n);
+  buf->used      += n;
+  buf->allocated += say_order_size(order);
 
-  mo_list_it *it = buf->ranges.head;
-  for (; it->next; it = it->next) { /* stop before last element */
-    say_range *current = mo_list_it_data_ptr(it, say_range);
-    say_range *next    = mo_list_it_data_ptr(it->next, say_range);
+  return loc;
+}
 
-    size_t begin = current->loc + current->size;
-    size_t end   = next->loc;
+static void say_global_buffer_release(say_global_buffer *buf, size_t loc,
+                                      size_t order) {
+  /* Merge with the buddy of this block for as long as it is free */
+  while (order < buf->max_order) {
+    size_t buddy = loc ^ say_order_size(order);
 
-    /* There's enough room between those two elements */
-    if (end - begin >= n)
-      return say_global_buffer_insert(&buf->ranges, it, n);
-  }
+    say_free_block *block = mo_hash_get(&buf->free_blocks, &buddy);
+    if (!block || block->order != order)
+      break;
 
-  say_range *last = mo_list_it_data_ptr(it, say_range);
+    say_global_buffer_remove_free(buf, buddy, order, block->it);
 
-  /* There's enough room at the end of the buffer */
-  if ((last->loc + last->size + n) < say_buffer_get_size(buf->buf)) {
-    return say_global_buffer_insert(&buf->ranges, it, n);
+    loc &= ~say_order_size(order);
+    order++;
   }
 
-  /* Not enough room here */
-  return SAY_MAX_SIZE;
+  say_global_buffer_push_free(buf, loc, order);
 }
 
 static void say_global_buffer_delete_at(say_global_buffer *buf, size_t loc,
@@ -104,24 +186,93 @@ static void say_global_buffer_delete_at(say_global_buffer *buf, size_t loc,
   if (!buf)
     return;
 
-  for (mo_list_it *it = buf->ranges.head; it; it = it->next) {
-    say_range *range = mo_list_it_data_ptr(it, say_range);
-    if (range->loc == loc && range->size == range_size) {
-      mo_list_delete(&buf->ranges, it);
-      return;
-    }
-  }
+  size_t order = say_order_for(range_size);
+
+  buf->used      -= range_size;
+  buf->allocated -= say_order_size(order);
+
+  say_global_buffer_release(buf, loc, order);
 }
 
 static void say_global_buffer_reduce_size(say_global_buffer *buf, size_t loc,
                                           size_t old_size, size_t size) {
-  for (mo_list_it *it = buf->ranges.head; it; it = it->next) {
-    say_range *range = mo_list_it_data_ptr(it, say_range);
-    if (range->loc == loc && range->size == size) {
-      range->size = size;
+  size_t old_order = say_order_for(old_size);
+  size_t order     = say_order_for(size);
+
+  buf->used -= old_size - size;
+
+  /* Give back the upper halves we don't need anymore */
+  for (size_t i = order; i < old_order; i++) {
+    buf->allocated -= say_order_size(i);
+    say_global_buffer_release(buf, loc + say_order_size(i), i);
+  }
+}
+
+static void say_global_buffer_mark_dirty(say_global_buffer *buf, size_t loc,
+                                         size_t size) {
+  if (size == 0)
+    return;
+
+  /* Drawables are often updated in order, extend the last range if we can */
+  if (buf->dirty_ranges.size != 0) {
+    say_range *last = mo_array_at(&buf->dirty_ranges,
+                                  buf->dirty_ranges.size - 1);
+
+    if (loc <= last->loc + last->size && last->loc <= loc + size) {
+      size_t end      = loc + size;
+      size_t last_end = last->loc + last->size;
+
+      if (loc < last->loc)
+        last->loc = loc;
+      last->size = (end > last_end ? end : last_end) - last->loc;
+
       return;
     }
   }
+
+  if (buf->dirty_ranges.size >= SAY_DIRTY_RANGE_MAX_COUNT) {
+    mo_array_resize(&buf->dirty_ranges, 1);
+    mo_array_get_as(&buf->dirty_ranges, 0, say_range) =
+      say_make_range(0, say_order_size(buf->max_order));
+    return;
+  }
+
+  say_range range = say_make_range(loc, size);
+  mo_array_push(&buf->dirty_ranges, &range);
+}
+
+static int say_range_cmp(const void *a, const void *b) {
+  size_t first = ((say_range*)a)->loc, sec = ((say_range*)b)->loc;
+
+  if (first > sec)      return +1;
+  else if (sec > first) return -1;
+  else                  return +0;
+}
+
+static void say_global_buffer_flush(say_global_buffer *buf) {
+  if (buf->dirty_ranges.size == 0)
+    return;
+
+  mo_array_qsort(&buf->dirty_ranges, say_range_cmp);
+
+  say_range current = mo_array_get_as(&buf->dirty_ranges, 0, say_range);
+  for (size_t i = 1; i < buf->dirty_ranges.size; i++) {
+    say_range range = mo_array_get_as(&buf->dirty_ranges, i, say_range);
+
+    size_t end = current.loc + current.size;
+    if (range.loc <= end + SAY_DIRTY_RANGE_MAX_GAP) {
+      if (range.loc + range.size > end)
+        current.size = range.loc + range.size - current.loc;
+    }
+    else {
+      say_buffer_update_part(buf->buf, current.loc, current.size);
+      current = range;
+    }
+  }
+
+  say_buffer_update_part(buf->buf, current.loc, current.size);
+
+  mo_array_resize(&buf->dirty_ranges, 0);
 }
 
 static size_t say_global_buffer_reserve(size_t vtype, size_t size,
@@ -149,15 +300,17 @@ static size_t say_global_buffer_reserve(size_t vtype, size_t size,
 
   /* Existing buffers can't store this object, save it somewhere else */
 
-  say_vertex_type *type        = say_get_vertex_type(vtype);
-  size_t           elem_size   = say_vertex_type_get_size(type);
-  size_t           normal_size = SAY_BUFFER_BYTE_SIZE /
-    (elem_size == 0 ? 1 : elem_size);
-  size_t           buf_size    = normal_size > size ? normal_size : size;
+  say_vertex_type *type         = say_get_vertex_type(vtype);
+  size_t           elem_size    = say_vertex_type_get_size(type);
+  size_t           normal_order = say_order_floor(SAY_BUFFER_BYTE_SIZE /
+                                                  (elem_size == 0 ? 1 :
+                                                   elem_size));
+  size_t           order        = say_order_for(size);
 
   say_global_buffer *buf = say_global_buffer_create(global_bufs,
                                                     vtype,
-                                                    buf_size);
+                                                    normal_order > order ?
+                                                    normal_order : order);
   *ret_id = global_bufs->size - 1;
   return say_global_buffer_find(buf, size);
 }
@@ -184,22 +337,21 @@ void say_buffer_slice_free(say_buffer_slice *slice) {
 }
 
 void say_buffer_slice_use(say_buffer_slice *slice) {
-  say_buffer_bind(say_global_buffer_at(slice->vtype, slice->buf_id)->buf);
+  say_buffer_slice_bind(slice);
 }
 
 void say_buffer_slice_recreate(say_buffer_slice *slice, size_t size) {
-  if (size > slice->size) {
-    say_global_buffer_delete_at(say_global_buffer_at(slice->vtype,
-                                                     slice->buf_id),
-                                slice->loc, slice->size);
+  say_global_buffer *buf = say_global_buffer_at(slice->vtype, slice->buf_id);
 
+  if (say_order_for(size) > say_order_for(slice->size)) {
+    say_global_buffer_delete_at(buf, slice->loc, slice->size);
     slice->loc = say_global_buffer_reserve(slice->vtype, size, &slice->buf_id);
   }
-  else {
-    say_global_buffer_reduce_size(say_global_buffer_at(slice->vtype,
-                                                       slice->buf_id),
-                                  slice->loc, slice->size, size);
+  else if (size < slice->size) {
+    say_global_buffer_reduce_size(buf, slice->loc, slice->size, size);
   }
+  else /* still fits in the same block */
+    buf->used += size - slice->size;
 
   slice->size = size;
 }
@@ -219,12 +371,45 @@ void *say_buffer_slice_get_vertex(say_buffer_slice *slice, size_t id) {
 }
 
 void say_buffer_slice_update(say_buffer_slice *slice) {
-  say_buffer_update_part(say_global_buffer_at(slice->vtype, slice->buf_id)->buf,
-                         slice->loc, slice->size);
+  say_global_buffer_mark_dirty(say_global_buffer_at(slice->vtype,
+                                                    slice->buf_id),
+                               slice->loc, slice->size);
 }
 
 void say_buffer_slice_bind(say_buffer_slice *slice) {
-  say_buffer_bind(say_global_buffer_at(slice->vtype, slice->buf_id)->buf);
+  say_global_buffer *buf = say_global_buffer_at(slice->vtype, slice->buf_id);
+
+  say_global_buffer_flush(buf);
+  say_buffer_bind(buf->buf);
+}
+
+void say_buffer_slice_get_stats(size_t vtype, say_buffer_slice_stats *stats) {
+  memset(stats, 0, sizeof(*stats));
+
+  if (!say_global_buffers || vtype >= say_global_buffers->size)
+    return;
+
+  mo_array *global_bufs = mo_array_get_ptr(say_global_buffers, vtype, mo_array);
+
+  stats->buffer_count = global_bufs->size;
+
+  for (size_t i = 0; i < global_bufs->size; i++) {
+    say_global_buffer *buf = mo_array_at(global_bufs, i);
+
+    stats->capacity         += say_order_size(buf->max_order);
+    stats->used             += buf->used;
+    stats->allocated        += buf->allocated;
+    stats->free_block_count += buf->free_blocks.size;
+
+    for (size_t order = buf->max_order + 1; order-- > 0;) {
+      if (buf->free_lists[order].head) {
+        if (say_order_size(order) > stats->largest_free_block)
+          stats->largest_free_block = say_order_size(order);
+        stats->largest_free_block_total += say_order_size(order);
+        break;
+      }
+    }
+  }
 }
 
 void say_buffer_slice_clean_up() {
@@ -3,6 +3,9 @@
 
 #include "say_basic_type.h"
 
+/* Enough orders to address any amount of vertices */
+#define SAY_BUFFER_SLICE_MAX_ORDER (sizeof(size_t) * 8)
+
 typedef struct {
   size_t buf_id;
   size_t loc;
@@ -11,6 +14,20 @@ typedef struct {
   size_t size;
 } say_buffer_slice;
 
+typedef struct {
+  size_t buffer_count;
+
+  size_t capacity;  /* vertices in all the buffers */
+  size_t used;      /* vertices actually used by slices */
+  size_t allocated; /* vertices reserved for slices */
+
+  size_t free_block_count;
+  size_t largest_free_block;
+
+  /* sum of the size of the largest free block of each buffer */
+  size_t largest_free_block_total;
+} say_buffer_slice_stats;
+
 say_buffer_slice *say_buffer_slice_create(size_t vtype, size_t size);
 void say_buffer_slice_free(say_buffer_slice *slice);
 
@@ -24,6 +41,8 @@ void *say_buffer_slice_get_vertex(say_buffer_slice *slice, size_t id);
 void say_buffer_slice_update(say_buffer_slice *slice);
 void say_buffer_slice_bind(say_buffer_slice *slice);
 
+void say_buffer_slice_get_stats(size_t vtype, say_buffer_slice_stats *stats);
+
 void say_buffer_slice_clean_up();
 
 #endif
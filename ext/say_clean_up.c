@@ -1,11 +1,13 @@
 #include "say.h"
 
 void say_clean_up() {
+  say_image_loader_clean_up();
   say_audio_context_clean_up();
   say_buffer_slice_clean_up();
   say_index_buffer_slice_clean_up();
   say_error_clean_up();
   say_font_clean_up();
+  say_sprite_batch_clean_up();
 
   say_vertex_type_clean_up(); /* NB: Buffers may be using this */
 
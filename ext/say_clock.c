@@ -0,0 +1,80 @@
+#include "say.h"
+
+#if defined(SAY_OSX)
+# include <mach/mach_time.h>
+#elif !defined(SAY_WIN)
+# include <time.h>
+#endif
+
+/* Seconds elapsed since an arbitrary point, never going backwards */
+double say_clock_now() {
+#if defined(SAY_WIN)
+  static LARGE_INTEGER freq = {{0, 0}};
+  if (!freq.QuadPart)
+    QueryPerformanceFrequency(&freq);
+
+  LARGE_INTEGER count;
+  QueryPerformanceCounter(&count);
+
+  return (double)count.QuadPart / freq.QuadPart;
+#elif defined(SAY_OSX)
+  static mach_timebase_info_data_t info = {0, 0};
+  if (!info.denom)
+    mach_timebase_info(&info);
+
+  return (double)mach_absolute_time() * info.numer / info.denom / 1e9;
+#else
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+
+  return time.tv_sec + time.tv_nsec / 1e9;
+#endif
+}
+
+/*
+ * Lets the OS sleep for most of the given time, but busy-waits through the
+ * last spin seconds, since OS timers commonly overshoot by a millisecond or
+ * more.
+ */
+void say_clock_sleep(double seconds, double spin) {
+  double target = say_clock_now() + seconds;
+
+  if (seconds > spin) {
+    double os_time = seconds - spin;
+
+#ifdef SAY_WIN
+    Sleep((DWORD)(os_time * 1000));
+#else
+    struct timespec req;
+    req.tv_sec  = (time_t)os_time;
+    req.tv_nsec = (long)((os_time - req.tv_sec) * 1e9);
+
+    nanosleep(&req, NULL);
+#endif
+  }
+
+  while (say_clock_now() < target);
+}
+
+say_clock *say_clock_create() {
+  say_clock *clock = malloc(sizeof(say_clock));
+  clock->start = say_clock_now();
+
+  return clock;
+}
+
+void say_clock_free(say_clock *clock) {
+  free(clock);
+}
+
+double say_clock_get_elapsed(say_clock *clock) {
+  return say_clock_now() - clock->start;
+}
+
+double say_clock_restart(say_clock *clock) {
+  double now = say_clock_now();
+  double elapsed = now - clock->start;
+
+  clock->start = now;
+  return elapsed;
+}
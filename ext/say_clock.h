@@ -0,0 +1,19 @@
+#ifndef SAY_CLOCK_H_
+#define SAY_CLOCK_H_
+
+#include "say_basic_type.h"
+
+typedef struct {
+  double start;
+} say_clock;
+
+double say_clock_now();
+void say_clock_sleep(double seconds, double spin);
+
+say_clock *say_clock_create();
+void say_clock_free(say_clock *clock);
+
+double say_clock_get_elapsed(say_clock *clock);
+double say_clock_restart(say_clock *clock);
+
+#endif
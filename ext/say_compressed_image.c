@@ -0,0 +1,409 @@
+#include "say.h"
+
+#ifndef GL_COMPRESSED_RGB8_ETC2
+# define GL_COMPRESSED_RGB8_ETC2 0x9274
+#endif
+
+#ifndef GL_COMPRESSED_RGBA8_ETC2_EAC
+# define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#endif
+
+#define SAY_DDS_HEADER_SIZE       128
+#define SAY_DDS_DX10_HEADER_SIZE  20
+#define SAY_KTX_HEADER_SIZE       64
+#define SAY_KTX_ENDIANNESS        0x04030201
+
+/*
+ * Dimensions are read from untrusted headers. Bounding them keeps every size
+ * computed from them well within the range of size_t.
+ */
+#define SAY_COMPRESSED_MAX_DIMENSION 16384
+
+static const uint8_t say_ktx_identifier[12] = {
+  0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'
+};
+
+static uint32_t say_read_u32(const uint8_t *data) {
+  return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static uint32_t say_read_u32_swapped(const uint8_t *data) {
+  return data[3] | (data[2] << 8) | (data[1] << 16) | ((uint32_t)data[0] << 24);
+}
+
+static size_t say_compressed_block_size(say_compressed_format format) {
+  switch (format) {
+  case SAY_COMPRESSED_BC1:
+  case SAY_COMPRESSED_ETC2_RGB:
+    return 8;
+  default:
+    return 16;
+  }
+}
+
+static size_t say_compressed_level_size(say_compressed_format format,
+                                        size_t w, size_t h) {
+  return ((w + 3) / 4) * ((h + 3) / 4) * say_compressed_block_size(format);
+}
+
+static bool say_compressed_image_check_size(say_compressed_image *img) {
+  if (img->width > SAY_COMPRESSED_MAX_DIMENSION ||
+      img->height > SAY_COMPRESSED_MAX_DIMENSION) {
+    say_error_set("compressed image is too large");
+    return false;
+  }
+
+  return true;
+}
+
+bool say_compressed_image_is_container(const uint8_t *data, size_t size) {
+  if (size >= 4 && memcmp(data, "DDS ", 4) == 0)
+    return true;
+
+  return size >= sizeof(say_ktx_identifier) &&
+    memcmp(data, say_ktx_identifier, sizeof(say_ktx_identifier)) == 0;
+}
+
+/*
+ * DDS files store each level one after the other, with no size prefix, from
+ * the top row of blocks to the bottom one.
+ */
+static bool say_compressed_image_parse_dds(say_compressed_image *img,
+                                           const uint8_t *data, size_t size) {
+  if (size < SAY_DDS_HEADER_SIZE || say_read_u32(data + 4) != 124) {
+    say_error_set("invalid DDS header");
+    return false;
+  }
+
+  img->height = say_read_u32(data + 12);
+  img->width  = say_read_u32(data + 16);
+
+  if (!say_compressed_image_check_size(img))
+    return false;
+
+  size_t level_count = say_read_u32(data + 28);
+  if (level_count == 0)
+    level_count = 1;
+
+  const uint8_t *four_cc = data + 84;
+  size_t offset = SAY_DDS_HEADER_SIZE;
+
+  if (memcmp(four_cc, "DXT1", 4) == 0)
+    img->format = SAY_COMPRESSED_BC1;
+  else if (memcmp(four_cc, "DXT3", 4) == 0)
+    img->format = SAY_COMPRESSED_BC2;
+  else if (memcmp(four_cc, "DXT5", 4) == 0)
+    img->format = SAY_COMPRESSED_BC3;
+  else if (memcmp(four_cc, "DX10", 4) == 0) {
+    if (size < SAY_DDS_HEADER_SIZE + SAY_DDS_DX10_HEADER_SIZE) {
+      say_error_set("invalid DDS header");
+      return false;
+    }
+
+    switch (say_read_u32(data + SAY_DDS_HEADER_SIZE)) {
+    case 71: case 72: img->format = SAY_COMPRESSED_BC1; break;
+    case 74: case 75: img->format = SAY_COMPRESSED_BC2; break;
+    case 77: case 78: img->format = SAY_COMPRESSED_BC3; break;
+    default:
+      say_error_set("unsupported DXGI format in DDS file");
+      return false;
+    }
+
+    offset += SAY_DDS_DX10_HEADER_SIZE;
+  }
+  else {
+    say_error_set("unsupported DDS pixel format");
+    return false;
+  }
+
+  size_t w = img->width, h = img->height;
+
+  img->level_count = 0;
+  for (size_t i = 0; i < level_count && i < SAY_COMPRESSED_MAX_LEVELS; i++) {
+    size_t level_size = say_compressed_level_size(img->format, w, h);
+    if (level_size > size - offset)
+      break;
+
+    img->levels[i]      = data + offset;
+    img->level_sizes[i] = level_size;
+    img->level_count++;
+
+    offset += level_size;
+
+    if (w > 1) w /= 2;
+    if (h > 1) h /= 2;
+  }
+
+  return true;
+}
+
+/*
+ * KTX files prefix each level with its size, and pad it to 4 bytes. Rows are
+ * expected to go from top to bottom, which is what tools write unless asked
+ * to map the lower left corner to (0, 0).
+ */
+static bool say_compressed_image_parse_ktx(say_compressed_image *img,
+                                           const uint8_t *data, size_t size) {
+  if (size < SAY_KTX_HEADER_SIZE) {
+    say_error_set("invalid KTX header");
+    return false;
+  }
+
+  uint32_t (*read)(const uint8_t *) = say_read_u32;
+  if (read(data + 12) != SAY_KTX_ENDIANNESS) {
+    read = say_read_u32_swapped;
+    if (read(data + 12) != SAY_KTX_ENDIANNESS) {
+      say_error_set("invalid KTX header");
+      return false;
+    }
+  }
+
+  uint32_t gl_type         = read(data + 16);
+  uint32_t internal_format = read(data + 28);
+  uint32_t depth           = read(data + 44);
+  uint32_t array_size      = read(data + 48);
+  uint32_t face_count      = read(data + 52);
+  uint32_t level_count     = read(data + 56);
+  uint32_t key_value_size  = read(data + 60);
+
+  if (gl_type != 0) {
+    say_error_set("KTX file doesn't contain compressed pixels");
+    return false;
+  }
+
+  if (depth > 1 || array_size > 0 || face_count != 1) {
+    say_error_set("only 2D KTX textures are supported");
+    return false;
+  }
+
+  switch (internal_format) {
+  case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+  case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+    img->format = SAY_COMPRESSED_BC1; break;
+  case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+    img->format = SAY_COMPRESSED_BC2; break;
+  case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+    img->format = SAY_COMPRESSED_BC3; break;
+  case GL_COMPRESSED_RGB8_ETC2:
+    img->format = SAY_COMPRESSED_ETC2_RGB; break;
+  case GL_COMPRESSED_RGBA8_ETC2_EAC:
+    img->format = SAY_COMPRESSED_ETC2_RGBA; break;
+  default:
+    say_error_set("unsupported KTX pixel format");
+    return false;
+  }
+
+  img->width  = read(data + 36);
+  img->height = read(data + 40);
+
+  if (!say_compressed_image_check_size(img))
+    return false;
+
+  if (level_count == 0)
+    level_count = 1;
+
+  if (key_value_size > size - SAY_KTX_HEADER_SIZE) {
+    say_error_set("compressed image is truncated");
+    return false;
+  }
+
+  size_t offset = SAY_KTX_HEADER_SIZE + key_value_size;
+
+  img->level_count = 0;
+  for (size_t i = 0; i < level_count && i < SAY_COMPRESSED_MAX_LEVELS; i++) {
+    /* Padding may have moved the offset past the end of the buffer */
+    if (offset > size || size - offset < 4)
+      break;
+
+    size_t level_size = read(data + offset);
+    offset += 4;
+
+    if (level_size > size - offset)
+      break;
+
+    img->levels[i]      = data + offset;
+    img->level_sizes[i] = level_size;
+    img->level_count++;
+
+    offset += (level_size + 3) & ~(size_t)3;
+  }
+
+  return true;
+}
+
+bool say_compressed_image_parse(say_compressed_image *img,
+                                const uint8_t *data, size_t size) {
+  bool ret;
+
+  if (size >= 4 && memcmp(data, "DDS ", 4) == 0)
+    ret = say_compressed_image_parse_dds(img, data, size);
+  else if (say_compressed_image_is_container(data, size))
+    ret = say_compressed_image_parse_ktx(img, data, size);
+  else {
+    say_error_set("not a DDS or KTX file");
+    return false;
+  }
+
+  if (!ret)
+    return false;
+
+  if (img->width == 0 || img->height == 0) {
+    say_error_set("can't create empty image");
+    return false;
+  }
+
+  if (img->level_count == 0 ||
+      img->level_sizes[0] < say_compressed_level_size(img->format, img->width,
+                                                       img->height)) {
+    say_error_set("compressed image is truncated");
+    return false;
+  }
+
+  return true;
+}
+
+GLenum say_compressed_format_get_gl_format(say_compressed_format format) {
+  switch (format) {
+  case SAY_COMPRESSED_BC1:       return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+  case SAY_COMPRESSED_BC2:       return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+  case SAY_COMPRESSED_BC3:       return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+  case SAY_COMPRESSED_ETC2_RGB:  return GL_COMPRESSED_RGB8_ETC2;
+  case SAY_COMPRESSED_ETC2_RGBA: return GL_COMPRESSED_RGBA8_ETC2_EAC;
+  }
+
+  return 0;
+}
+
+bool say_compressed_format_is_supported(say_compressed_format format) {
+  say_context_ensure();
+
+  switch (format) {
+  case SAY_COMPRESSED_BC1:
+  case SAY_COMPRESSED_BC2:
+  case SAY_COMPRESSED_BC3:
+    return GLEW_EXT_texture_compression_s3tc;
+  case SAY_COMPRESSED_ETC2_RGB:
+  case SAY_COMPRESSED_ETC2_RGBA:
+#ifdef GLEW_ARB_ES3_compatibility
+    return GLEW_ARB_ES3_compatibility;
+#else
+    return false;
+#endif
+  }
+
+  return false;
+}
+
+bool say_compressed_image_can_decode(say_compressed_image *img) {
+  return img->format == SAY_COMPRESSED_BC1 ||
+    img->format == SAY_COMPRESSED_BC2 ||
+    img->format == SAY_COMPRESSED_BC3;
+}
+
+static say_color say_color_from_565(uint16_t col) {
+  uint8_t r = (col >> 11) & 0x1F, g = (col >> 5) & 0x3F, b = col & 0x1F;
+  return say_make_color((r << 3) | (r >> 2), (g << 2) | (g >> 4),
+                        (b << 3) | (b >> 2), 255);
+}
+
+static say_color say_color_mix(say_color a, say_color b, int wa, int wb) {
+  int total = wa + wb;
+  return say_make_color((a.r * wa + b.r * wb) / total,
+                        (a.g * wa + b.g * wb) / total,
+                        (a.b * wa + b.b * wb) / total,
+                        255);
+}
+
+/* Decodes the color part of a BCn block into 16 texels */
+static void say_decode_bc1_colors(const uint8_t *block, say_color *texels,
+                                  bool allow_alpha) {
+  uint16_t c0 = block[0] | (block[1] << 8);
+  uint16_t c1 = block[2] | (block[3] << 8);
+
+  say_color palette[4];
+  palette[0] = say_color_from_565(c0);
+  palette[1] = say_color_from_565(c1);
+
+  if (c0 > c1 || !allow_alpha) {
+    palette[2] = say_color_mix(palette[0], palette[1], 2, 1);
+    palette[3] = say_color_mix(palette[0], palette[1], 1, 2);
+  }
+  else {
+    palette[2] = say_color_mix(palette[0], palette[1], 1, 1);
+    palette[3] = say_make_color(0, 0, 0, 0);
+  }
+
+  uint32_t indices = say_read_u32(block + 4);
+  for (size_t i = 0; i < 16; i++)
+    texels[i] = palette[(indices >> (2 * i)) & 3];
+}
+
+static void say_decode_bc2_alpha(const uint8_t *block, say_color *texels) {
+  for (size_t i = 0; i < 16; i++) {
+    uint8_t alpha = (block[i / 2] >> (4 * (i % 2))) & 0xF;
+    texels[i].a = alpha * 17;
+  }
+}
+
+static void say_decode_bc3_alpha(const uint8_t *block, say_color *texels) {
+  uint8_t a0 = block[0], a1 = block[1];
+
+  uint8_t palette[8] = {a0, a1};
+  if (a0 > a1) {
+    for (int i = 1; i < 7; i++)
+      palette[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+  }
+  else {
+    for (int i = 1; i < 5; i++)
+      palette[i + 1] = ((5 - i) * a0 + i * a1) / 5;
+    palette[6] = 0;
+    palette[7] = 255;
+  }
+
+  uint64_t indices = 0;
+  for (int i = 0; i < 6; i++)
+    indices |= (uint64_t)block[2 + i] << (8 * i);
+
+  for (size_t i = 0; i < 16; i++)
+    texels[i].a = palette[(indices >> (3 * i)) & 7];
+}
+
+bool say_compressed_image_decode(say_compressed_image *img, say_color *out) {
+  if (!say_compressed_image_can_decode(img)) {
+    say_error_set("compressed format not supported by the driver");
+    return false;
+  }
+
+  size_t block_size = say_compressed_block_size(img->format);
+  const uint8_t *block = img->levels[0];
+
+  for (size_t by = 0; by < img->height; by += 4) {
+    for (size_t bx = 0; bx < img->width; bx += 4) {
+      say_color texels[16];
+
+      switch (img->format) {
+      case SAY_COMPRESSED_BC1:
+        say_decode_bc1_colors(block, texels, true);
+        break;
+      case SAY_COMPRESSED_BC2:
+        say_decode_bc1_colors(block + 8, texels, false);
+        say_decode_bc2_alpha(block, texels);
+        break;
+      default:
+        say_decode_bc1_colors(block + 8, texels, false);
+        say_decode_bc3_alpha(block, texels);
+        break;
+      }
+
+      /* Blocks on the right and bottom edges may be partly outside */
+      for (size_t y = 0; y < 4 && by + y < img->height; y++) {
+        for (size_t x = 0; x < 4 && bx + x < img->width; x++)
+          out[(by + y) * img->width + bx + x] = texels[y * 4 + x];
+      }
+
+      block += block_size;
+    }
+  }
+
+  return true;
+}
@@ -0,0 +1,39 @@
+#ifndef SAY_COMPRESSED_IMAGE_H_
+#define SAY_COMPRESSED_IMAGE_H_
+
+#include "say_basic_type.h"
+
+#define SAY_COMPRESSED_MAX_LEVELS 16
+
+typedef enum {
+  SAY_COMPRESSED_BC1,
+  SAY_COMPRESSED_BC2,
+  SAY_COMPRESSED_BC3,
+  SAY_COMPRESSED_ETC2_RGB,
+  SAY_COMPRESSED_ETC2_RGBA
+} say_compressed_format;
+
+/*
+ * Block-compressed pixels read from a DDS or KTX container. Levels point into
+ * the buffer the image was parsed from, which must outlive this structure.
+ */
+typedef struct {
+  say_compressed_format format;
+  size_t width, height;
+
+  size_t         level_count;
+  const uint8_t *levels[SAY_COMPRESSED_MAX_LEVELS];
+  size_t         level_sizes[SAY_COMPRESSED_MAX_LEVELS];
+} say_compressed_image;
+
+bool say_compressed_image_is_container(const uint8_t *data, size_t size);
+bool say_compressed_image_parse(say_compressed_image *img,
+                                const uint8_t *data, size_t size);
+
+GLenum say_compressed_format_get_gl_format(say_compressed_format format);
+bool say_compressed_format_is_supported(say_compressed_format format);
+
+bool say_compressed_image_can_decode(say_compressed_image *img);
+bool say_compressed_image_decode(say_compressed_image *img, say_color *out);
+
+#endif
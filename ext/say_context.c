@@ -132,6 +132,10 @@ void say_context_update(say_context *context) {
   say_imp_context_update(context->context);
 }
 
+void say_context_set_vsync(say_context *context, bool val) {
+  say_imp_context_set_vsync(context->context, val);
+}
+
 static void say_context_create_initial() {
   say_shared_context = (say_context*)malloc(sizeof(say_context));
 
@@ -58,6 +58,7 @@ void say_context_free(say_context *context);
 
 void say_context_make_current(say_context *context);
 void say_context_update(say_context *context);
+void say_context_set_vsync(say_context *context, bool val);
 
 void say_context_clean_up();
 
@@ -1,24 +1,53 @@
 #include "say.h"
 
+static void say_drawable_sincos(say_drawable *drawable, float *c, float *s) {
+  if (drawable->angle != drawable->trig_angle) {
+    float angle = -drawable->angle * SAY_PI / 180;
+
+    drawable->trig_angle = drawable->angle;
+    drawable->trig_cos   = cosf(angle);
+    drawable->trig_sin   = sinf(angle);
+  }
+
+  *c = drawable->trig_cos;
+  *s = drawable->trig_sin;
+}
+
 static void say_drawable_update_matrix(say_drawable *drawable) {
   if (drawable->custom_matrix)
     return;
 
   if (drawable->matrix_proc) {
-    drawable->matrix_proc(drawable->data, drawable->matrix);
+    drawable->matrix_proc(drawable->data, &drawable->matrix);
+    drawable->matrix_expanded = true;
   }
   else {
-    say_matrix_set_transformation(drawable->matrix,
-                                  drawable->origin,
-                                  drawable->pos, drawable->z_order,
-                                  drawable->scale,
-                                  drawable->angle);
+    float c, s;
+    say_drawable_sincos(drawable, &c, &s);
+
+    say_affine_set_transformation(&drawable->affine,
+                                  drawable->origin, drawable->pos,
+                                  drawable->scale, c, s);
+    drawable->matrix_expanded = false;
   }
 
   drawable->matrix_updated = true;
 }
 
-static void say_drawable_enable_blend_mode(say_blend_mode mode) {
+static say_matrix *say_drawable_expanded_matrix(say_drawable *drawable) {
+  if (!drawable->matrix_updated)
+    say_drawable_update_matrix(drawable);
+
+  if (!drawable->matrix_expanded) {
+    say_affine_to_matrix(&drawable->affine, drawable->z_order,
+                         &drawable->matrix);
+    drawable->matrix_expanded = true;
+  }
+
+  return &drawable->matrix;
+}
+
+void say_drawable_enable_blend_mode(say_blend_mode mode) {
   say_context *context = say_context_current();
 
   bool must_be_enabled = mode != SAY_BLEND_NO;
@@ -74,12 +103,21 @@ say_drawable *say_drawable_create(size_t vtype) {
   drawable->fill_proc       = NULL;
   drawable->render_proc     = NULL;
   drawable->shader_proc     = NULL;
+  drawable->batch_proc      = NULL;
+  drawable->changed_proc    = NULL;
 
   drawable->shader = NULL;
-  drawable->matrix = say_matrix_identity();
 
-  drawable->matrix_updated = false;
-  drawable->custom_matrix  = false;
+  say_affine_reset(&drawable->affine);
+  say_matrix_reset(&drawable->matrix);
+
+  drawable->trig_angle = 0;
+  drawable->trig_cos   = 1;
+  drawable->trig_sin   = 0;
+
+  drawable->matrix_updated  = false;
+  drawable->matrix_expanded = false;
+  drawable->custom_matrix   = false;
   drawable->use_texture    = false;
   drawable->has_changed    = true;
 
@@ -105,6 +143,8 @@ void say_drawable_copy(say_drawable *drawable, say_drawable *other) {
   drawable->shader_proc     = other->shader_proc;
   drawable->render_proc     = other->render_proc;
   drawable->index_fill_proc = other->index_fill_proc;
+  drawable->batch_proc      = other->batch_proc;
+  drawable->changed_proc    = other->changed_proc;
 
   drawable->shader = other->shader;
 
@@ -114,6 +154,10 @@ void say_drawable_copy(say_drawable *drawable, say_drawable *other) {
   drawable->z_order = other->z_order;
   drawable->angle   = other->angle;
 
+  drawable->trig_angle = other->trig_angle;
+  drawable->trig_cos   = other->trig_cos;
+  drawable->trig_sin   = other->trig_sin;
+
   drawable->blend_mode = other->blend_mode;
 
   drawable->use_texture = other->use_texture;
@@ -125,7 +169,6 @@ void say_drawable_copy(say_drawable *drawable, say_drawable *other) {
 void say_drawable_free(say_drawable *drawable) {
   if (drawable->slice)
     say_buffer_slice_free(drawable->slice);
-  say_matrix_free(drawable->matrix);
   free(drawable);
 }
 
@@ -197,6 +240,15 @@ void say_drawable_set_shader_proc(say_drawable *drawable, say_shader_proc proc)
   drawable->shader_proc = proc;
 }
 
+void say_drawable_set_batch_proc(say_drawable *drawable, say_batch_proc proc) {
+  drawable->batch_proc = proc;
+}
+
+void say_drawable_set_changed_proc(say_drawable *drawable,
+                                   say_changed_proc proc) {
+  drawable->changed_proc = proc;
+}
+
 void say_drawable_fill_buffer(say_drawable *drawable, void *vertices) {
   if (drawable->fill_proc && drawable->vertex_count != 0)
     drawable->fill_proc(drawable->data, vertices);
@@ -264,12 +316,9 @@ void say_drawable_draw_at(say_drawable *drawable,
                           say_shader *shader) {
   say_drawable_enable_blend_mode(drawable->blend_mode);
 
-  if (!drawable->matrix_updated)
-    say_drawable_update_matrix(drawable);
-
   say_shader *used_shader = drawable->shader ? drawable->shader : shader;
   say_shader_set_matrix_id(used_shader, SAY_MODEL_VIEW_LOC_ID,
-                           drawable->matrix);
+                           say_drawable_expanded_matrix(drawable));
 
   if (drawable->render_proc) {
     if (drawable->shader) {
@@ -284,10 +333,8 @@ void say_drawable_draw_at(say_drawable *drawable,
   }
 }
 
-void say_drawable_draw(say_drawable *drawable, say_shader *shader) {
-  say_drawable_enable_blend_mode(drawable->blend_mode);
-
-  if (drawable->has_changed) {
+void say_drawable_prepare(say_drawable *drawable) {
+  if (say_drawable_has_changed(drawable)) {
     say_drawable_fill_own_buffer(drawable);
     say_drawable_fill_own_index_buffer(drawable);
 
@@ -296,11 +343,16 @@ void say_drawable_draw(say_drawable *drawable, say_shader *shader) {
 
   if (!drawable->matrix_updated)
     say_drawable_update_matrix(drawable);
+}
+
+void say_drawable_draw(say_drawable *drawable, say_shader *shader) {
+  say_drawable_enable_blend_mode(drawable->blend_mode);
+  say_drawable_prepare(drawable);
 
   /* NB: the current shader is always bound because we set a variable in it. */
   say_shader *used_shader = drawable->shader ? drawable->shader : shader;
   say_shader_set_matrix_id(used_shader, SAY_MODEL_VIEW_LOC_ID,
-                           drawable->matrix);
+                           say_drawable_expanded_matrix(drawable));
 
   if (drawable->render_proc) {
     if (drawable->shader) {
@@ -332,6 +384,11 @@ void say_drawable_set_changed(say_drawable *drawable) {
 }
 
 uint8_t say_drawable_has_changed(say_drawable *drawable) {
+  /* Lets drawables notice changes in the objects they depend on */
+  if (!drawable->has_changed && drawable->changed_proc &&
+      drawable->changed_proc(drawable->data))
+    drawable->has_changed = true;
+
   return drawable->has_changed;
 }
 
@@ -400,11 +457,98 @@ float say_drawable_get_angle(say_drawable *drawable) {
   return drawable->angle;
 }
 
+void say_drawable_set_transforms(say_drawable **drawables, size_t count,
+                                 const float *pos, const float *angles,
+                                 const float *scales) {
+  for (size_t i = 0; i < count; i++) {
+    say_drawable *drawable = drawables[i];
+
+    if (pos)    drawable->pos   = say_make_vector2(pos[2 * i], pos[2 * i + 1]);
+    if (angles) drawable->angle = angles[i];
+    if (scales) {
+      drawable->scale = say_make_vector2(scales[2 * i], scales[2 * i + 1]);
+    }
+
+    drawable->matrix_updated = false;
+  }
+
+  say_drawable_update_matrices(drawables, count);
+}
+
+static void say_drawable_flush_batch(say_affine_batch *batch,
+                                     say_drawable **members) {
+  say_affine_batch_compute(batch);
+
+  for (size_t i = 0; i < batch->count; i++) {
+    say_affine_batch_get(batch, i, &members[i]->affine);
+
+    members[i]->matrix_updated  = true;
+    members[i]->matrix_expanded = false;
+  }
+
+  batch->count = 0;
+}
+
+void say_drawable_update_matrices(say_drawable **drawables, size_t count) {
+  say_affine_batch batch;
+  say_drawable *members[SAY_AFFINE_BATCH_SIZE];
+
+  batch.count = 0;
+
+  for (size_t i = 0; i < count; i++) {
+    say_drawable *drawable = drawables[i];
+    if (drawable->matrix_updated || drawable->custom_matrix)
+      continue;
+
+    if (drawable->matrix_proc) {
+      say_drawable_update_matrix(drawable);
+      continue;
+    }
+
+    size_t id = batch.count++;
+    members[id] = drawable;
+
+    batch.origin_x[id] = drawable->origin.x;
+    batch.origin_y[id] = drawable->origin.y;
+    batch.pos_x[id]    = drawable->pos.x;
+    batch.pos_y[id]    = drawable->pos.y;
+    batch.scale_x[id]  = drawable->scale.x;
+    batch.scale_y[id]  = drawable->scale.y;
+
+    say_drawable_sincos(drawable, &batch.cos[id], &batch.sin[id]);
+
+    if (batch.count == SAY_AFFINE_BATCH_SIZE)
+      say_drawable_flush_batch(&batch, members);
+  }
+
+  if (batch.count != 0)
+    say_drawable_flush_batch(&batch, members);
+}
+
 say_matrix *say_drawable_get_matrix(say_drawable *drawable) {
+  return say_drawable_expanded_matrix(drawable);
+}
+
+bool say_drawable_get_affine(say_drawable *drawable, say_affine *affine) {
   if (!drawable->matrix_updated)
     say_drawable_update_matrix(drawable);
 
-  return drawable->matrix;
+  if (!drawable->matrix_expanded) {
+    *affine = drawable->affine;
+    return true;
+  }
+  else
+    return say_affine_from_matrix(affine, &drawable->matrix);
+}
+
+float say_drawable_get_depth(say_drawable *drawable) {
+  if (!drawable->matrix_updated)
+    say_drawable_update_matrix(drawable);
+
+  if (!drawable->matrix_expanded)
+    return drawable->z_order;
+  else
+    return drawable->matrix.content[11];
 }
 
 say_matrix *say_drawable_get_default_matrix(say_drawable *drawable) {
@@ -420,8 +564,9 @@ say_matrix *say_drawable_get_default_matrix(say_drawable *drawable) {
 
 void say_drawable_set_matrix(say_drawable *drawable, say_matrix *matrix) {
   if (matrix) {
-    drawable->custom_matrix = true;
-    memcpy(drawable->matrix->content, matrix->content, sizeof(float) * 16);
+    drawable->custom_matrix   = true;
+    drawable->matrix_expanded = true;
+    memcpy(drawable->matrix.content, matrix->content, sizeof(float) * 16);
   }
   else {
     drawable->custom_matrix  = false;
@@ -430,10 +575,7 @@ void say_drawable_set_matrix(say_drawable *drawable, say_matrix *matrix) {
 }
 
 say_vector3 say_drawable_transform(say_drawable *drawable, say_vector3 point) {
-  if (!drawable->matrix_updated)
-    say_drawable_update_matrix(drawable);
-
-  return say_matrix_transform(drawable->matrix, point);
+  return say_matrix_transform(say_drawable_expanded_matrix(drawable), point);
 }
 
 say_blend_mode say_drawable_get_blend_mode(say_drawable *drawable) {
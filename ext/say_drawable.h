@@ -6,6 +6,7 @@
 
 #include "say_matrix.h"
 #include "say_shader.h"
+#include "say_image.h"
 
 typedef void (*say_matrix_proc)(void *data, say_matrix *matrix);
 typedef void (*say_fill_proc)(void *data, void *vertices);
@@ -13,6 +14,9 @@ typedef void (*say_index_fill_proc)(void *data, GLuint *indices, size_t from);
 typedef void (*say_render_proc)(void *data, size_t first, size_t index);
 typedef void (*say_shader_proc)(void *data, say_shader *shader);
 
+typedef say_image *(*say_batch_proc)(void *data, size_t *first);
+typedef bool (*say_changed_proc)(void *data);
+
 typedef enum {
   SAY_BLEND_NO,
   SAY_BLEND_ALPHA,
@@ -36,9 +40,22 @@ typedef struct {
   say_index_fill_proc index_fill_proc;
   say_render_proc     render_proc;
   say_shader_proc     shader_proc;
+  say_batch_proc      batch_proc;
+  say_changed_proc    changed_proc;
 
   say_shader *shader;
-  say_matrix *matrix;
+
+  /*
+   * Plain drawables only maintain their 2D transformation, and expand it into
+   * the full matrix when it is needed.
+   */
+  say_affine affine;
+  say_matrix matrix;
+
+  /* Cosine and sine of trig_angle, reused as long as the angle is unchanged */
+  float trig_angle;
+  float trig_cos;
+  float trig_sin;
 
   say_vector2 origin;
   say_vector2 scale;
@@ -48,6 +65,7 @@ typedef struct {
 
   bool use_texture;
   bool matrix_updated;
+  bool matrix_expanded;
   bool custom_matrix;
   bool has_changed;
 
@@ -77,6 +95,9 @@ void say_drawable_set_render_proc(say_drawable *drawable, say_render_proc proc);
 void say_drawable_set_shader_proc(say_drawable *drawable, say_shader_proc proc);
 void say_drawable_set_index_fill_proc(say_drawable *drawable,
                                         say_index_fill_proc proc);
+void say_drawable_set_batch_proc(say_drawable *drawable, say_batch_proc proc);
+void say_drawable_set_changed_proc(say_drawable *drawable,
+                                   say_changed_proc proc);
 
 void say_drawable_fill_buffer(say_drawable *drawable, void *vertices);
 void say_drawable_fill_own_buffer(say_drawable *drawable);
@@ -85,6 +106,8 @@ void say_drawable_fill_index_buffer(say_drawable *drawable, GLuint *indices,
                                     size_t from);
 void say_drawable_fill_own_index_buffer(say_drawable *drawable);
 
+void say_drawable_prepare(say_drawable *drawable);
+
 void say_drawable_draw_at(say_drawable *drawable, size_t vertex, size_t id,
                           say_shader *shader);
 void say_drawable_draw(say_drawable *drawable, say_shader *shader);
@@ -111,7 +134,14 @@ say_vector2 say_drawable_get_pos(say_drawable *drawable);
 float say_drawable_get_z(say_drawable *drawable);
 float say_drawable_get_angle(say_drawable *drawable);
 
+void say_drawable_set_transforms(say_drawable **drawables, size_t count,
+                                 const float *pos, const float *angles,
+                                 const float *scales);
+void say_drawable_update_matrices(say_drawable **drawables, size_t count);
+
 say_matrix *say_drawable_get_matrix(say_drawable *drawable);
+bool say_drawable_get_affine(say_drawable *drawable, say_affine *affine);
+float say_drawable_get_depth(say_drawable *drawable);
 say_matrix *say_drawable_get_default_matrix(say_drawable *drawable);
 void say_drawable_set_matrix(say_drawable *drawable, say_matrix *matrix);
 say_vector3 say_drawable_transform(say_drawable *drawable, say_vector3 point);
@@ -119,4 +149,6 @@ say_vector3 say_drawable_transform(say_drawable *drawable, say_vector3 point);
 say_blend_mode say_drawable_get_blend_mode(say_drawable *drawable);
 void say_drawable_set_blend_mode(say_drawable *drawable, say_blend_mode mode);
 
+void say_drawable_enable_blend_mode(say_blend_mode mode);
+
 #endif
@@ -1,84 +1,88 @@
 #include "say.h"
 
+#define SAY_FONT_PAGE_SIZE 512
+
 static void say_page_init(say_font_page *page) {
   page->glyphs = mo_hash_create(sizeof(uint32_t), sizeof(say_glyph));
   page->glyphs->hash_of = mo_hash_of_u32;
   page->glyphs->key_cmp = mo_hash_u32_cmp;
 
-  mo_array_init(&page->rows, sizeof(say_font_row));
-
-  page->current_height = 2;
-
-  page->image = say_image_create();
-  say_image_set_smooth(page->image, 1);
-  say_image_create_with_size(page->image, 128, 128);
-
-  for (int y = 0; y < 128; y++) {
-    for (int x = 0; x < 128; x++) {
-      say_image_set(page->image, x, y, say_make_color(255, 255, 255, 0));
-    }
-  }
-
-  for (int y = 0; y < 2; y++) {
-    for (int x = 0; x < 2; x++) {
-      say_image_set(page->image, x, y, say_make_color(255, 255, 255, 255));
-    }
-  }
+  mo_array_init(&page->images, sizeof(say_atlas_page));
 }
 
 static void say_page_free(say_font_page *page) {
-  say_image_free(page->image);
+  for (size_t i = 0; i < page->images.size; i++) {
+    say_atlas_page *img = mo_array_at(&page->images, i);
+
+    say_image_free(img->image);
+    say_skyline_release(&img->skyline);
+  }
 
-  mo_array_release(&page->rows);
+  mo_array_release(&page->images);
   mo_hash_free(page->glyphs);
 }
 
-static say_rect say_page_find_rect(say_font_page *page, size_t width, size_t height) {
-  say_font_row *found_row = NULL;
+static say_atlas_page *say_page_add_image(say_font_page *page, size_t width,
+                                          size_t height) {
+  size_t size = SAY_FONT_PAGE_SIZE;
+  while (size < width || size < height + 2)
+    size *= 2;
 
-  float best_ratio = 0;
+  say_atlas_page img;
 
-  say_font_row *end = mo_array_end(&page->rows);
-  for (say_font_row *row = mo_array_at(&page->rows, 0);
-       row && row < end;
-       mo_array_next(&page->rows, (void**)&row)) {
-    float ratio = height / (float)row->height;
+  img.image = say_image_create();
+  say_image_set_smooth(img.image, 1);
+  say_image_create_with_size(img.image, size, size);
 
-    if (ratio < 0.7 || ratio > 1.0 || ratio < best_ratio)
-      continue;
+  say_color *pixels = say_image_get_buffer(img.image);
+  for (size_t i = 0; i < size * size; i++)
+    pixels[i] = say_make_color(255, 255, 255, 0);
 
-    if (width > say_image_get_width(page->image) - row->current_width)
-      continue;
-
-    found_row  = row;
-    best_ratio = ratio;
+  /*
+   * A white square is kept in the top left corner for underlines, followed by
+   * a transparent one for glyphs that couldn't be loaded.
+   */
+  for (int y = 0; y < 2; y++) {
+    for (int x = 0; x < 2; x++)
+      pixels[y * size + x] = say_make_color(255, 255, 255, 255);
   }
 
-  if (!found_row) {
-    int row_height = height + height / 10;
-
-    while (page->current_height + row_height >= say_image_get_height(page->image)) {
-      say_vector2 size = say_image_get_size(page->image);
-      say_image_resize(page->image, size.x * 2, size.y * 2);
-    }
+  say_image_mark_texture_out_of_date(img.image);
 
-    say_font_row row;
+  size_t x, y;
+  say_skyline_init(&img.skyline, size, size);
+  say_skyline_insert(&img.skyline, 4, 2, &x, &y);
 
-    row.current_width = 0;
-    row.y             = page->current_height;
-    row.height        = row_height;
+  mo_array_push(&page->images, &img);
+  return mo_array_at(&page->images, page->images.size - 1);
+}
 
-    mo_array_push(&page->rows, &row);
-    found_row = mo_array_at(&page->rows, page->rows.size - 1);
+static say_rect say_page_find_rect(say_font_page *page, size_t width,
+                                   size_t height, size_t *id) {
+  size_t x, y;
 
-    page->current_height += row_height;
+  for (*id = 0; *id < page->images.size; (*id)++) {
+    say_atlas_page *img = mo_array_at(&page->images, *id);
+    if (say_skyline_insert(&img->skyline, width, height, &x, &y))
+      return say_make_rect(x, y, width, height);
   }
 
-  say_rect rect = say_make_rect(found_row->current_width, found_row->y,
-                                width, height);
-  found_row->current_width += width;
+  say_atlas_page *img = say_page_add_image(page, width, height);
+  *id = page->images.size - 1;
 
-  return rect;
+  say_skyline_insert(&img->skyline, width, height, &x, &y);
+  return say_make_rect(x, y, width, height);
+}
+
+static say_image *say_font_get_page_image_from(say_font_page *page,
+                                               size_t id) {
+  if (page->images.size == 0)
+    say_page_add_image(page, 0, 0);
+
+  if (id >= page->images.size)
+    return NULL;
+
+  return ((say_atlas_page*)mo_array_at(&page->images, id))->image;
 }
 
 static size_t say_font_get_size(say_font *font) {
@@ -103,29 +107,28 @@ static int say_font_set_size(say_font *font, size_t size) {
   return 1;
 }
 
-static say_glyph *say_font_load_glyph(say_font *font, say_font_page *page,
-                                      uint32_t codepoint, uint8_t bold,
-                                      size_t size) {
-  uint32_t bold_codepoint = ((bold ? 1 : 0) << 31) | codepoint;
-
-  say_glyph tmp;
-  mo_hash_set(page->glyphs, &bold_codepoint, &tmp);
-
-  say_glyph *glyph = mo_hash_get(page->glyphs, &bold_codepoint);
-
+/*
+ * Renders a glyph with FreeType and computes its metrics. Returns NULL if the
+ * glyph has no bitmap, in which case the glyph keeps the default, empty
+ * rect. Otherwise the returned glyph must be released with FT_Done_Glyph.
+ */
+static FT_BitmapGlyph say_font_rasterize(say_font *font, say_glyph *glyph,
+                                         uint32_t codepoint, uint8_t bold,
+                                         size_t size) {
   glyph->offset   = 0;
   glyph->bounds   = say_make_rect(2, 0, 2, 2);
   glyph->sub_rect = say_make_rect(2, 0, 2, 2);
+  glyph->page     = 0;
 
   if (!(font->face && say_font_set_size(font, size)))
-    return glyph;
+    return NULL;
 
   if (FT_Load_Char(font->face, codepoint, FT_LOAD_TARGET_NORMAL) != 0)
-    return glyph;
+    return NULL;
 
   FT_Glyph ft_glyph;
   if (FT_Get_Glyph(font->face->glyph, &ft_glyph) != 0)
-    return glyph;
+    return NULL;
 
   FT_Pos weight = 1 << 6;
   uint8_t outline = ft_glyph->format == FT_GLYPH_FORMAT_OUTLINE;
@@ -147,59 +150,90 @@ static say_glyph *say_font_load_glyph(say_font *font, say_font_page *page,
   if (bold)
     glyph->offset += weight >> 6;
 
+  if (bitmap->width <= 0 || bitmap->rows <= 0) {
+    FT_Done_Glyph(ft_glyph);
+    return NULL;
+  }
+
+  return bitmap_glyph;
+}
+
+/*
+ * Finds room for a rasterized glyph in the images of a page and copies its
+ * bitmap there.
+ */
+static void say_font_place_glyph(say_font_page *page, say_glyph *glyph,
+                                 FT_BitmapGlyph bitmap_glyph) {
+  FT_Bitmap *bitmap = &bitmap_glyph->bitmap;
+
   int width  = bitmap->width;
   int height = bitmap->rows;
 
-  if (width > 0 && height > 0) {
-    static const int padding = 1;
-    glyph->sub_rect = say_page_find_rect(page,
-                                         width  + (2 * padding),
-                                         height + (2 * padding));
+  static const int padding = 1;
+  glyph->sub_rect = say_page_find_rect(page,
+                                       width  + (2 * padding),
+                                       height + (2 * padding),
+                                       &glyph->page);
+  say_image *image = say_font_get_page_image_from(page, glyph->page);
+
+  glyph->bounds.x = +bitmap_glyph->left - padding;
+  glyph->bounds.y = -bitmap_glyph->top - padding;
+  glyph->bounds.w = width   + (2 * padding);
+  glyph->bounds.h = height  + (2 * padding);
+
+  say_rect actual_rect = glyph->sub_rect;
+  actual_rect.x += padding;
+  actual_rect.y += padding;
+  actual_rect.w -= 2 * padding;
+  actual_rect.h -= 2 * padding;
 
-    glyph->bounds.x = +bitmap_glyph->left - padding;
-    glyph->bounds.y = -bitmap_glyph->top - padding;
-    glyph->bounds.w = width   + (2 * padding);
-    glyph->bounds.h = height  + (2 * padding);
+  /*
+   * Rows are written directly into the buffer, and only the glyph's rect is
+   * marked for upload.
+   */
+  say_color *buffer = say_image_get_buffer(image);
+  size_t     stride = say_image_get_width(image);
 
-    say_rect actual_rect = glyph->sub_rect;
-    actual_rect.x += padding;
-    actual_rect.y += padding;
-    actual_rect.w -= 2 * padding;
-    actual_rect.h -= 2 * padding;
+  uint8_t *pixels = bitmap->buffer;
 
-    uint8_t *pixels = bitmap->buffer;
+  size_t first_x = actual_rect.x, first_y = actual_rect.y;
+
+  for (int y = 0; y < actual_rect.h; y++) {
+    say_color *row = &buffer[(first_y + y) * stride + first_x];
 
     if (bitmap->pixel_mode == FT_PIXEL_MODE_MONO) {
-      for (int y = actual_rect.y; y < actual_rect.y + actual_rect.h; y++) {
-        for (int x = actual_rect.x; x < actual_rect.x + actual_rect.w; x++) {
-          int pixel_x = x - actual_rect.x;
-          uint8_t alpha = ((pixels[pixel_x / 8]) &
-                           (1 << (7 - (pixel_x % 8)))) ? 255 : 0;
-          say_image_set(page->image, x, y,
-                        say_make_color(255, 255, 255, alpha));
-        }
-
-        pixels += bitmap->pitch;
+      for (int x = 0; x < actual_rect.w; x++) {
+        uint8_t alpha = (pixels[x / 8] & (1 << (7 - (x % 8)))) ? 255 : 0;
+        row[x] = say_make_color(255, 255, 255, alpha);
       }
     }
     else {
-      for (int y = actual_rect.y; y < actual_rect.y + actual_rect.h;
-           y++) {
-        for (int x = actual_rect.x; x < actual_rect.x + actual_rect.w;
-             x++) {
-          int pixel_x = x - actual_rect.x;
-          say_image_set(page->image, x, y,
-                        say_make_color(255, 255, 255, pixels[pixel_x]));
-        }
-
-        pixels += bitmap->pitch;
-      }
+      for (int x = 0; x < actual_rect.w; x++)
+        row[x] = say_make_color(255, 255, 255, pixels[x]);
     }
+
+    pixels += bitmap->pitch;
   }
 
-  FT_Done_Glyph(ft_glyph);
+  say_image_mark_rect_out_of_date(image, actual_rect.x, actual_rect.y,
+                                  actual_rect.w, actual_rect.h);
+}
+
+static say_glyph *say_font_load_glyph(say_font *font, say_font_page *page,
+                                      uint32_t codepoint, uint8_t bold,
+                                      size_t size) {
+  uint32_t bold_codepoint = ((bold ? 1 : 0) << 31) | codepoint;
+
+  say_glyph tmp;
+  FT_BitmapGlyph bitmap_glyph = say_font_rasterize(font, &tmp, codepoint, bold,
+                                                   size);
+  if (bitmap_glyph) {
+    say_font_place_glyph(page, &tmp, bitmap_glyph);
+    FT_Done_Glyph((FT_Glyph)bitmap_glyph);
+  }
 
-  return glyph;
+  mo_hash_set(page->glyphs, &bold_codepoint, &tmp);
+  return mo_hash_get(page->glyphs, &bold_codepoint);
 }
 
 say_font *say_font_create() {
@@ -299,6 +333,74 @@ say_glyph *say_font_get_glyph(say_font *font, uint32_t codepoint, size_t size, u
   }
 }
 
+typedef struct {
+  uint32_t       key;
+  say_glyph      glyph;
+  FT_BitmapGlyph bitmap;
+} say_pending_glyph;
+
+static int say_pending_glyph_cmp(const void *a, const void *b) {
+  const say_pending_glyph *first = a, *second = b;
+
+  int first_height  = first->bitmap  ? (int)first->bitmap->bitmap.rows  : 0;
+  int second_height = second->bitmap ? (int)second->bitmap->bitmap.rows : 0;
+
+  /* Tallest first, which gives a tighter skyline */
+  return second_height - first_height;
+}
+
+size_t say_font_preload(say_font *font, size_t size, const uint32_t *ranges,
+                        size_t range_count, uint8_t bold) {
+  if (!font->face || !say_font_set_size(font, size))
+    return 0;
+
+  say_font_page *page = say_font_get_page(font, size);
+
+  mo_array pending;
+  mo_array_init(&pending, sizeof(say_pending_glyph));
+
+  for (size_t i = 0; i < range_count; i++) {
+    uint32_t first = ranges[2 * i], last = ranges[2 * i + 1];
+
+    for (uint32_t codepoint = first; codepoint <= last; codepoint++) {
+      say_pending_glyph entry;
+      entry.key = ((bold ? 1 : 0) << 31) | codepoint;
+
+      /* Characters missing from the face would all use the same empty glyph */
+      if (!mo_hash_has_key(page->glyphs, &entry.key) &&
+          FT_Get_Char_Index(font->face, codepoint) != 0) {
+        entry.bitmap = say_font_rasterize(font, &entry.glyph, codepoint, bold,
+                                          size);
+        mo_array_push(&pending, &entry);
+
+        /* Prevents loading the same glyph twice for overlapping ranges */
+        mo_hash_set(page->glyphs, &entry.key, &entry.glyph);
+      }
+
+      if (codepoint == last)
+        break;
+    }
+  }
+
+  mo_array_qsort(&pending, say_pending_glyph_cmp);
+
+  for (size_t i = 0; i < pending.size; i++) {
+    say_pending_glyph *entry = mo_array_at(&pending, i);
+
+    if (entry->bitmap) {
+      say_font_place_glyph(page, &entry->glyph, entry->bitmap);
+      FT_Done_Glyph((FT_Glyph)entry->bitmap);
+    }
+
+    mo_hash_set(page->glyphs, &entry->key, &entry->glyph);
+  }
+
+  size_t count = pending.size;
+  mo_array_release(&pending);
+
+  return count;
+}
+
 size_t say_font_get_kerning(say_font *font, uint32_t first, uint32_t second,
                             size_t size) {
   if (first == 0 || second == 0)
@@ -327,8 +429,15 @@ size_t say_font_get_line_height(say_font *font, size_t size) {
 }
 
 say_image *say_font_get_image(say_font *font, size_t size) {
-  say_font_page *page = say_font_get_page(font, size);
-  return page->image;
+  return say_font_get_page_image(font, size, 0);
+}
+
+say_image *say_font_get_page_image(say_font *font, size_t size, size_t page) {
+  return say_font_get_page_image_from(say_font_get_page(font, size), page);
+}
+
+size_t say_font_get_page_count(say_font *font, size_t size) {
+  return say_font_get_page(font, size)->images.size;
 }
 
 void say_font_clean_up() {
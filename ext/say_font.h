@@ -1,24 +1,21 @@
 #ifndef SAY_FONT_H_
 #define SAY_FONT_H_
 
-#include "say_image.h"
+#include "say_atlas.h"
 
 typedef struct {
   int offset;
   say_rect bounds, sub_rect;
+  size_t page;
 } say_glyph;
 
-typedef struct {
-  size_t current_width, height, y;
-} say_font_row;
-
+/*
+ * Glyphs of a given size. They are stored in as many images as needed, which
+ * are never resized, so that glyphs never move once they have been loaded.
+ */
 typedef struct {
   mo_hash  *glyphs;
-  mo_array  rows;
-
-  say_image *image;
-
-  size_t current_height;
+  mo_array  images; /* say_atlas_page */
 } say_font_page;
 
 typedef struct {
@@ -38,10 +35,15 @@ int say_font_load_from_memory(say_font *font, void *buf, size_t size);
 
 say_glyph *say_font_get_glyph(say_font *font, uint32_t codepoint, size_t size,
                               uint8_t bold);
+size_t say_font_preload(say_font *font, size_t size, const uint32_t *ranges,
+                        size_t range_count, uint8_t bold);
+
 size_t say_font_get_kerning(say_font *font, uint32_t first, uint32_t second,
                             size_t size);
 size_t say_font_get_line_height(say_font *font, size_t size);
 say_image *say_font_get_image(say_font *font, size_t size);
+say_image *say_font_get_page_image(say_font *font, size_t size, size_t page);
+size_t say_font_get_page_count(say_font *font, size_t size);
 
 void say_font_clean_up();
 
@@ -19,7 +19,21 @@ static void say_texture_make_current(GLuint texture, int unit) {
   }
 }
 
+/*
+ * Batched sprites only keep the name of their texture. They must be drawn
+ * before it gets modified (or reused by another image once deleted).
+ */
+static void say_texture_will_change(GLuint texture) {
+  say_context *context = say_context_current();
+  if (context && context->target) {
+    say_target *target = context->target;
+    say_renderer_flush_texture(target->renderer, texture);
+  }
+}
+
 static void say_texture_will_delete(GLuint texture) {
+  say_texture_will_change(texture);
+
   mo_array *contexts = say_context_get_all();
   for (size_t i = 0; i < contexts->size; i++) {
     say_context *context = mo_array_get_as(contexts, i, say_context*);
@@ -31,10 +45,39 @@ static void say_texture_will_delete(GLuint texture) {
   }
 }
 
+static void say_image_clear_dirty_rect(say_image *img) {
+  img->dirty_count = 0;
+}
+
+static size_t say_dirty_rect_area(say_dirty_rect rect) {
+  return (rect.x1 - rect.x0) * (rect.y1 - rect.y0);
+}
+
+static say_dirty_rect say_dirty_rect_union(say_dirty_rect a,
+                                           say_dirty_rect b) {
+  say_dirty_rect ret = {
+    a.x0 < b.x0 ? a.x0 : b.x0, a.y0 < b.y0 ? a.y0 : b.y0,
+    a.x1 > b.x1 ? a.x1 : b.x1, a.y1 > b.y1 ? a.y1 : b.y1
+  };
+
+  return ret;
+}
+
+static bool say_dirty_rect_touches(say_dirty_rect a, say_dirty_rect b) {
+  return a.x0 <= b.x1 && b.x0 <= a.x1 && a.y0 <= b.y1 && b.y0 <= a.y1;
+}
+
+static void say_image_remove_dirty_rect(say_image *img, size_t i) {
+  img->dirty[i] = img->dirty[--img->dirty_count];
+}
+
 static void say_image_update_buffer(say_image *img) {
   if (img->buffer_updated)
     return;
 
+  if (!img->pixels)
+    img->pixels = malloc(sizeof(say_color) * img->width * img->height);
+
   say_texture_make_current(img->texture, 0);
   say_pixel_bus_unbind_pack();
   glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE,
@@ -42,6 +85,19 @@ static void say_image_update_buffer(say_image *img) {
 
   img->buffer_updated  = true;
   img->texture_updated = true;
+  say_image_clear_dirty_rect(img);
+}
+
+/*
+ * Forgets about the compressed levels of the current texture. The caller is
+ * expected to reallocate it as RGBA.
+ */
+static void say_image_uncompress_texture(say_image *img) {
+  if (!img->compressed)
+    return;
+
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 1000);
+  img->compressed = false;
 }
 
 say_image *say_image_create() {
@@ -55,19 +111,35 @@ say_image *say_image_create() {
   img->pixels          = NULL;
   img->texture_updated = true;
   img->buffer_updated  = true;
+  say_image_clear_dirty_rect(img);
 
   img->width  = 0;
   img->height = 0;
 
+  img->mipmapped       = false;
+  img->mipmaps_updated = false;
+  img->anisotropy      = 1;
+
   img->smooth = true;
   say_image_set_smooth(img, false);
 
+  img->compressed = false;
+
+  img->atlas       = NULL;
+  img->atlas_page  = NULL;
+  img->atlas_x     = 0;
+  img->atlas_y     = 0;
+  img->tex_version = 0;
+
   return img;
 }
 
 void say_image_free(say_image *img) {
   say_context_ensure();
 
+  if (img->atlas)
+    say_atlas_remove(img->atlas, img);
+
   say_texture_will_delete(img->texture);
   glDeleteTextures(1, &(img->texture));
 
@@ -77,94 +149,224 @@ void say_image_free(say_image *img) {
   free(img);
 }
 
-bool say_image_load_raw(say_image *img, size_t w, size_t h, say_color *pixels) {
-  if (!say_image_create_with_size(img, w, h))
+/*
+ * Resizes the image. If pixels isn't NULL, the image takes ownership of it
+ * instead of keeping (or allocating) its own buffer.
+ */
+static bool say_image_set_storage(say_image *img, size_t w, size_t h,
+                                  say_color *pixels) {
+  if (w == 0 || h == 0) {
+    say_error_set("can't create empty image");
     return false;
+  }
 
-  img->texture_updated = false;
+  if (pixels) {
+    if (img->pixels) free(img->pixels);
+    img->pixels = pixels;
+  }
 
-  memcpy(img->pixels, pixels, sizeof(say_color) * w * h);
+  if (img->width != w || img->height != h || img->compressed) {
+    if (img->atlas)
+      say_atlas_remove(img->atlas, img);
 
-  /*
-   * Vertical flip to fit OpenGL convention.
-   */
-  say_flip_color_buffer(img->pixels, w, h);
+    if (!pixels) {
+      if (img->pixels) free(img->pixels);
+      img->pixels = malloc(sizeof(say_color) * w * h);
+    }
+
+    say_texture_will_change(img->texture);
+    say_texture_make_current(img->texture, 0);
+    say_pixel_bus_unbind_unpack();
+    glGetError(); /* Ignore potential previous errors */
+    say_image_uncompress_texture(img);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+
+    if (glGetError()) {
+      say_error_set("could not create texture");
+      return false;
+    }
+
+    img->mipmaps_updated = false;
+  }
+
+  img->width  = w;
+  img->height = h;
+
+  img->texture_updated = true;
+  img->buffer_updated  = true;
+  say_image_clear_dirty_rect(img);
 
   return true;
 }
 
-bool say_image_load_flipped_raw(say_image *img, size_t w, size_t h,
-                                say_color *pixels) {
+bool say_image_load_raw(say_image *img, size_t w, size_t h, say_color *pixels) {
   if (!say_image_create_with_size(img, w, h))
     return false;
 
-  img->texture_updated = false;
+  say_image_mark_texture_out_of_date(img);
   memcpy(img->pixels, pixels, sizeof(say_color) * w * h);
+
   return true;
 }
 
-bool say_image_load_file(say_image *img, const char *filename) {
+bool say_image_adopt_buffer(say_image *img, size_t w, size_t h,
+                            say_color *pixels) {
+  if (!say_image_set_storage(img, w, h, pixels)) {
+    if (img->pixels != pixels)
+      free(pixels);
+    return false;
+  }
+
+  say_image_mark_texture_out_of_date(img);
+  return true;
+}
+
+/*
+ * Neither say_image_read_file nor say_image_decode_memory set the last error,
+ * as they are also used by the loader threads.
+ */
+uint8_t *say_image_read_file(const char *filename, size_t *size) {
+  FILE *file = fopen(filename, "rb");
+  if (!file)
+    return NULL;
+
+  fseek(file, 0, SEEK_END);
+  long len = ftell(file);
+  fseek(file, 0, SEEK_SET);
+
+  uint8_t *data = len > 0 ? malloc(len) : NULL;
+  if (data && fread(data, 1, len, file) != (size_t)len) {
+    free(data);
+    data = NULL;
+  }
+
+  fclose(file);
+
+  *size = len;
+  return data;
+}
+
+say_color *say_image_decode_memory(const uint8_t *data, size_t size,
+                                   size_t *w, size_t *h) {
   int width, height, comp = 4;
 
-  stbi_uc *buf = stbi_load(filename, &width, &height, &comp, 4);
+  stbi_uc *buf = stbi_load_from_memory(data, size, &width, &height, &comp, 4);
   if (!buf)
-    return false;
+    return NULL;
+
+  *w = width;
+  *h = height;
+
+  return (say_color*)buf;
+}
 
-  if (!say_image_load_raw(img, width, height, (say_color*)buf))
+bool say_image_load_file(say_image *img, const char *filename) {
+  /* The file is only read once, whether it is compressed or not */
+  size_t size;
+  uint8_t *data = say_image_read_file(filename, &size);
+  if (!data) {
+    say_error_set("could not read file");
     return false;
-  stbi_image_free(buf);
+  }
 
-  return true;
+  bool ret = say_image_load_from_memory(img, size, (const char*)data);
+  free(data);
+
+  return ret;
 }
 
 bool say_image_load_from_memory(say_image *img, size_t size,
                                 const char *buffer) {
-  int width, height, comp = 4;
+  if (say_compressed_image_is_container((const uint8_t*)buffer, size))
+    return say_image_load_compressed(img, size, (const uint8_t*)buffer);
 
-  stbi_uc *buf = stbi_load_from_memory((const uint8_t*)buffer, size,
-                                       &width, &height, &comp, 4);
-  if (!buf)
-    return false;
+  size_t width, height;
 
-  if (!say_image_load_raw(img, width, height, (say_color*)buf))
+  say_color *buf = say_image_decode_memory((const uint8_t*)buffer, size,
+                                           &width, &height);
+  if (!buf) {
+    say_error_set("could not decode image");
     return false;
-  stbi_image_free(buf);
+  }
 
-  return true;
+  return say_image_adopt_buffer(img, width, height, buf);
 }
 
-bool say_image_create_with_size(say_image *img, size_t w, size_t h) {
-  if (w == 0 || h == 0) {
-    say_error_set("can't create empty image");
+bool say_image_load_compressed(say_image *img, size_t size,
+                               const uint8_t *data) {
+  say_compressed_image compressed;
+  if (!say_compressed_image_parse(&compressed, data, size))
     return false;
+
+  /* Blocks are decoded in software when the driver can't use them directly */
+  if (!say_compressed_format_is_supported(compressed.format)) {
+    say_color *pixels = malloc(sizeof(say_color) * compressed.width *
+                               compressed.height);
+    if (!pixels) {
+      say_error_set("could not allocate decoded pixels");
+      return false;
+    }
+
+    if (!say_compressed_image_decode(&compressed, pixels)) {
+      free(pixels);
+      return false;
+    }
+
+    return say_image_adopt_buffer(img, compressed.width, compressed.height,
+                                  pixels);
   }
 
-  if (img->width != w || img->height != h) {
-    if (img->pixels) free(img->pixels);
+  if (img->atlas)
+    say_atlas_remove(img->atlas, img);
 
-    img->pixels = malloc(sizeof(say_color) * w * h);
+  say_texture_will_change(img->texture);
+  say_texture_make_current(img->texture, 0);
+  say_pixel_bus_unbind_unpack();
+  glGetError(); /* Ignore potential previous errors */
 
-    say_texture_make_current(img->texture, 0);
-    say_pixel_bus_unbind_unpack();
-    glGetError(); /* Ignore potential previous errors */
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0,
-                 GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+  GLenum format = say_compressed_format_get_gl_format(compressed.format);
+  size_t w = compressed.width, h = compressed.height;
 
-    if (glGetError()) {
-      say_error_set("could not create texture");
-      return false;
-    }
+  for (size_t i = 0; i < compressed.level_count; i++) {
+    glCompressedTexImage2D(GL_TEXTURE_2D, i, format, w, h, 0,
+                           compressed.level_sizes[i], compressed.levels[i]);
+
+    if (w > 1) w /= 2;
+    if (h > 1) h /= 2;
   }
 
-  img->width  = w;
-  img->height = h;
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL,
+                  compressed.level_count - 1);
+
+  if (glGetError()) {
+    say_error_set("could not upload compressed texture");
+    return false;
+  }
+
+  if (img->pixels) {
+    free(img->pixels);
+    img->pixels = NULL;
+  }
 
+  img->width  = compressed.width;
+  img->height = compressed.height;
+
+  img->compressed      = true;
   img->texture_updated = true;
-  img->buffer_updated  = true;
+  img->buffer_updated  = false;
+
+  /* Levels stored in the file are used as they are */
+  img->mipmaps_updated = true;
+  say_image_clear_dirty_rect(img);
 
   return true;
 }
 
+bool say_image_create_with_size(say_image *img, size_t w, size_t h) {
+  return say_image_set_storage(img, w, h, NULL);
+}
+
 static bool say_image_assert_non_empty(say_image *img) {
   if (img->width == 0 || img->height == 0) {
     say_error_set("can't save empty image");
@@ -174,19 +376,12 @@ static bool say_image_assert_non_empty(say_image *img) {
   return true;
 }
 
-static say_color *say_image_reversed_buffer(say_image *img) {
-  return say_flip_color_buffer_copy(img->pixels, img->width,
-                                    img->height);
-}
-
 bool say_image_write_bmp(say_image *img, const char *filename) {
   if (!say_image_assert_non_empty(img))
     return false;
 
   say_image_update_buffer(img);
-  say_color *buf = say_image_reversed_buffer(img);
-  stbi_write_bmp(filename, img->width, img->height, 4, buf);
-  free(buf);
+  stbi_write_bmp(filename, img->width, img->height, 4, img->pixels);
 
   return true;
 }
@@ -201,9 +396,7 @@ bool say_image_write_png(say_image *img, const char *filename) {
 #endif
 
   say_image_update_buffer(img);
-  say_color *buf = say_image_reversed_buffer(img);
-  stbi_write_png(filename, img->width, img->height, 4, buf, 0);
-  free(buf);
+  stbi_write_png(filename, img->width, img->height, 4, img->pixels, 0);
 
   return true;
 }
@@ -213,9 +406,7 @@ bool say_image_write_tga(say_image *img, const char *filename) {
     return false;
 
   say_image_update_buffer(img);
-  say_color *buf = say_image_reversed_buffer(img);
-  stbi_write_tga(filename, img->width, img->height, 4, buf);
-  free(buf);
+  stbi_write_tga(filename, img->width, img->height, 4, img->pixels);
 
   return true;
 }
@@ -261,24 +452,21 @@ bool say_image_resize(say_image *img, size_t w, size_t h) {
   if (!say_image_create_with_size(img, w, h))
     return false;
 
-  img->texture_updated = false;
+  say_image_mark_texture_out_of_date(img);
 
-  size_t row_size = sizeof(say_color) * old_h;
+  size_t copy_w = old_w < w ? old_w : w;
+  size_t copy_h = old_h < h ? old_h : h;
 
-  for (size_t y = 0; y < old_h; y++) {
-    memcpy(&img->pixels[(h - y - 1) * img->width],
-           &cpy[(old_h - y - 1) * old_h], row_size);
-    for (size_t x = old_w; x < img->width; x++) {
-      img->pixels[(h - y - 1) * img->height + x] =
-        say_make_color(255, 255, 255, 0);
-    }
-  }
+  for (size_t y = 0; y < h; y++) {
+    size_t x = 0;
 
-  for (size_t y = old_h; y < img->height; y++) {
-    for (size_t x = 0; x < img->width; x++) {
-      img->pixels[(h - y - 1) * img->height + x] =
-        say_make_color(255, 255, 255, 0);
+    if (y < copy_h) {
+      memcpy(&img->pixels[y * w], &cpy[y * old_w], sizeof(say_color) * copy_w);
+      x = copy_w;
     }
+
+    for (; x < w; x++)
+      img->pixels[y * w + x] = say_make_color(255, 255, 255, 0);
   }
 
   free(cpy);
@@ -290,26 +478,286 @@ bool say_image_is_smooth(say_image *img) {
   return img->smooth;
 }
 
+static void say_image_apply_filter(say_image *img) {
+  say_context_ensure();
+  say_texture_make_current(img->texture, 0);
+
+  GLenum interp = img->smooth ? GL_LINEAR : GL_NEAREST;
+  GLenum min_interp = interp;
+
+  if (img->mipmapped) {
+    /* Trilinear filtering when smoothing, nearest texel of the nearest level otherwise */
+    min_interp = img->smooth ? GL_LINEAR_MIPMAP_LINEAR :
+      GL_NEAREST_MIPMAP_NEAREST;
+  }
+
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, min_interp);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, interp);
+}
+
 void say_image_set_smooth(say_image *img, bool val) {
   if (img->smooth != val) {
     img->smooth = val;
+    say_image_apply_filter(img);
+  }
+}
+
+bool say_image_is_mipmapped(say_image *img) {
+  return img->mipmapped;
+}
+
+bool say_image_set_mipmapped(say_image *img, bool val) {
+  /* Images are drawn from the page, which has no mip chain of its own */
+  if (val && img->atlas) {
+    say_error_set("can't mipmap an image packed in an atlas");
+    return false;
+  }
 
-    say_context_ensure();
+  if (img->mipmapped != val) {
+    img->mipmapped = val;
+    say_image_apply_filter(img);
+  }
+
+  return true;
+}
+
+float say_image_get_anisotropy(say_image *img) {
+  return img->anisotropy;
+}
+
+bool say_image_anisotropy_is_available() {
+  say_context_ensure();
+  return GLEW_EXT_texture_filter_anisotropic;
+}
+
+void say_image_set_anisotropy(say_image *img, float val) {
+  if (!say_image_anisotropy_is_available())
+    return;
+
+  GLfloat max = 1;
+  glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &max);
+
+  if (val < 1)   val = 1;
+  if (val > max) val = max;
+
+  img->anisotropy = val;
+
+  say_texture_make_current(img->texture, 0);
+  glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, val);
+}
+
+/*
+ * Builds the mip chain by averaging 2x2 blocks of the previous level, for
+ * drivers that can't generate it themselves.
+ */
+static void say_image_generate_mipmaps_in_software(say_image *img) {
+  say_image_update_buffer(img);
+
+  say_texture_make_current(img->texture, 0);
+  say_pixel_bus_unbind_unpack();
+
+  size_t w = img->width, h = img->height;
+  say_color *prev = img->pixels;
+
+  for (GLint level = 1; w > 1 || h > 1; level++) {
+    size_t next_w = w > 1 ? w / 2 : 1;
+    size_t next_h = h > 1 ? h / 2 : 1;
+
+    say_color *next = malloc(sizeof(say_color) * next_w * next_h);
+
+    for (size_t y = 0; y < next_h; y++) {
+      size_t y0 = 2 * y, y1 = 2 * y + 1 < h ? 2 * y + 1 : h - 1;
+
+      for (size_t x = 0; x < next_w; x++) {
+        size_t x0 = 2 * x, x1 = 2 * x + 1 < w ? 2 * x + 1 : w - 1;
+
+        say_color a = prev[y0 * w + x0], b = prev[y0 * w + x1];
+        say_color c = prev[y1 * w + x0], d = prev[y1 * w + x1];
+
+        next[y * next_w + x] = say_make_color((a.r + b.r + c.r + d.r + 2) / 4,
+                                              (a.g + b.g + c.g + d.g + 2) / 4,
+                                              (a.b + b.b + c.b + d.b + 2) / 4,
+                                              (a.a + b.a + c.a + d.a + 2) / 4);
+      }
+    }
+
+    glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, next_w, next_h, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, next);
+
+    if (prev != img->pixels)
+      free(prev);
+
+    prev = next;
+    w    = next_w;
+    h    = next_h;
+  }
+
+  if (prev != img->pixels)
+    free(prev);
+}
+
+void say_image_generate_mipmaps(say_image *img) {
+  say_context_ensure();
+
+  img = say_image_get_texture_image(img);
+  if (img->mipmaps_updated || img->width == 0 || img->height == 0)
+    return;
+
+  if (!img->texture_updated)
+    say_image_update_texture(img);
+
+  if (GLEW_EXT_framebuffer_object || GLEW_VERSION_3_0) {
     say_texture_make_current(img->texture, 0);
+    glGenerateMipmap(GL_TEXTURE_2D);
+  }
+  else
+    say_image_generate_mipmaps_in_software(img);
+
+  img->mipmaps_updated = true;
+}
+
+/*
+ * Clips a rect to an image. Returns false if nothing is left.
+ */
+static bool say_image_clip(say_image *img, long *x, long *y, long *w,
+                           long *h) {
+  if (*x < 0) { *w += *x; *x = 0; }
+  if (*y < 0) { *h += *y; *y = 0; }
+
+  if (*x + *w > (long)img->width)  *w = (long)img->width  - *x;
+  if (*y + *h > (long)img->height) *h = (long)img->height - *y;
+
+  return *w > 0 && *h > 0;
+}
+
+void say_image_fill_rect(say_image *img, say_rect rect, say_color color) {
+  long x = rect.x, y = rect.y, w = rect.w, h = rect.h;
+  if (!say_image_clip(img, &x, &y, &w, &h))
+    return;
+
+  say_image_update_buffer(img);
 
-    GLenum interp = val ? GL_LINEAR : GL_NEAREST;
+  for (long row = 0; row < h; row++) {
+    say_color *pixels = &img->pixels[(y + row) * img->width + x];
+    for (long col = 0; col < w; col++)
+      pixels[col] = color;
+  }
+
+  say_image_mark_rect_out_of_date(img, x, y, w, h);
+}
+
+void say_image_blit(say_image *img, say_image *src, say_rect src_rect,
+                    say_vector2 pos) {
+  long src_x = src_rect.x, src_y = src_rect.y;
+  long w = src_rect.w, h = src_rect.h;
+
+  if (!say_image_clip(src, &src_x, &src_y, &w, &h))
+    return;
+
+  /* Parts clipped from the source move the destination too */
+  long x = (long)pos.x + (src_x - (long)src_rect.x);
+  long y = (long)pos.y + (src_y - (long)src_rect.y);
+
+  long dst_x = x, dst_y = y;
+  if (!say_image_clip(img, &dst_x, &dst_y, &w, &h))
+    return;
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, interp);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, interp);
+  src_x += dst_x - x;
+  src_y += dst_y - y;
+
+  say_image_update_buffer(src);
+  say_image_update_buffer(img);
+
+  /* Rows are copied in the right order when blitting an image onto itself */
+  bool backward = img == src && dst_y > src_y;
+
+  for (long i = 0; i < h; i++) {
+    long row = backward ? h - i - 1 : i;
+    memmove(&img->pixels[(dst_y + row) * img->width + dst_x],
+            &src->pixels[(src_y + row) * src->width + src_x],
+            sizeof(say_color) * w);
   }
+
+  say_image_mark_rect_out_of_date(img, dst_x, dst_y, w, h);
 }
 
 say_rect say_image_get_tex_rect(say_image *img, say_rect rect) {
+  if (img->atlas_page) {
+    rect.x += img->atlas_x;
+    rect.y += img->atlas_y;
+
+    return say_image_get_tex_rect(img->atlas_page, rect);
+  }
+
   if (img->width == 0 || img->height == 0)
     return say_make_rect(0, 0, 0, 0);
 
-  return say_make_rect(rect.x / img->width, 1 - (rect.y / img->height),
-                       rect.w / img->width, -(rect.h / img->height));
+  /* Textures are stored top-down: row 0 is the top of the image */
+  return say_make_rect(rect.x / img->width, rect.y / img->height,
+                       rect.w / img->width, rect.h / img->height);
+}
+
+size_t say_image_get_tex_version(say_image *img) {
+  return img->tex_version;
+}
+
+say_vector2 say_image_get_atlas_pos(say_image *img) {
+  return say_make_vector2(img->atlas_x, img->atlas_y);
+}
+
+say_image *say_image_get_texture_image(say_image *img) {
+  if (!img->atlas_page)
+    return img;
+
+  if (!img->texture_updated) {
+    say_atlas_blit(img->atlas, img);
+
+    img->texture_updated = true;
+    say_image_clear_dirty_rect(img);
+  }
+
+  return img->atlas_page;
+}
+
+void say_image_set_atlas(say_image *img, struct say_atlas *atlas,
+                         say_image *page, size_t x, size_t y) {
+  say_context_ensure();
+
+  if (page && !img->atlas_page) {
+    /* The pixels are stored in the page, no need to keep a copy in VRAM */
+    say_texture_make_current(img->texture, 0);
+    say_image_uncompress_texture(img);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 0, 0, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+  }
+  else if (!page && img->atlas_page) {
+    say_texture_make_current(img->texture, 0);
+    say_pixel_bus_unbind_unpack();
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, img->width, img->height, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+  }
+
+  img->atlas      = atlas;
+  img->atlas_page = page;
+  img->atlas_x    = x;
+  img->atlas_y    = y;
+
+  img->tex_version++;
+  say_image_mark_texture_out_of_date(img);
+}
+
+bool say_image_is_compressed(say_image *img) {
+  /* Modified pixels are uploaded uncompressed the next time they're needed */
+  return img->compressed && img->texture_updated;
+}
+
+void say_image_decompress(say_image *img) {
+  if (!img->compressed)
+    return;
+
+  say_image_update_buffer(img);
+  say_image_mark_texture_out_of_date(img);
+  say_image_update_texture(img);
 }
 
 say_color *say_image_get_buffer(say_image *img) {
@@ -318,19 +766,72 @@ say_color *say_image_get_buffer(say_image *img) {
 }
 
 void say_image_mark_out_of_date(say_image *img) {
-  img->buffer_updated = false;
+  img->buffer_updated  = false;
+  img->mipmaps_updated = false;
+}
+
+void say_image_mark_texture_out_of_date(say_image *img) {
+  say_image_mark_rect_out_of_date(img, 0, 0, img->width, img->height);
+}
+
+void say_image_mark_rect_out_of_date(say_image *img, size_t x, size_t y,
+                                     size_t w, size_t h) {
+  if (x >= img->width || y >= img->height || w == 0 || h == 0)
+    return;
+
+  if (x + w > img->width)  w = img->width - x;
+  if (y + h > img->height) h = img->height - y;
+
+  say_dirty_rect rect = {x, y, x + w, y + h};
+
+  /*
+   * Rects that touch are merged. When there are too many rects, the new one is
+   * merged with the rect it grows the least.
+   */
+  for (size_t i = 0; i < img->dirty_count;) {
+    if (say_dirty_rect_touches(rect, img->dirty[i])) {
+      rect = say_dirty_rect_union(rect, img->dirty[i]);
+      say_image_remove_dirty_rect(img, i);
+      i = 0;
+    }
+    else
+      i++;
+
+    if (i == img->dirty_count &&
+        img->dirty_count == SAY_IMAGE_MAX_DIRTY_RECTS) {
+      size_t best = 0, best_cost = SIZE_MAX;
+      for (size_t j = 0; j < img->dirty_count; j++) {
+        size_t cost =
+          say_dirty_rect_area(say_dirty_rect_union(rect, img->dirty[j])) -
+          say_dirty_rect_area(img->dirty[j]);
+
+        if (cost < best_cost) {
+          best      = j;
+          best_cost = cost;
+        }
+      }
+
+      rect = say_dirty_rect_union(rect, img->dirty[best]);
+      say_image_remove_dirty_rect(img, best);
+      i = 0;
+    }
+  }
+
+  img->dirty[img->dirty_count++] = rect;
+
+  img->texture_updated = false;
 }
 
 say_color say_image_get(say_image *img, size_t x, size_t y) {
   say_image_update_buffer(img);
-  return img->pixels[(img->height - y - 1) * img->width + x];
+  return img->pixels[y * img->width + x];
 }
 
 void say_image_set(say_image *img, size_t x, size_t y, say_color color) {
   say_image_update_buffer(img);
 
-  img->pixels[(img->height - y - 1) * img->width + x] = color;
-  img->texture_updated = false;
+  img->pixels[y * img->width + x] = color;
+  say_image_mark_rect_out_of_date(img, x, y, 1, 1);
 }
 
 void say_image_bind(say_image *img) {
@@ -339,24 +840,64 @@ void say_image_bind(say_image *img) {
 
 void say_image_bind_to(say_image *img, int unit) {
   say_context_ensure();
+
+  img = say_image_get_texture_image(img);
   say_texture_make_current(img->texture, unit);
 
   if (!img->texture_updated)
     say_image_update_texture(img);
+
+  if (img->mipmapped && !img->mipmaps_updated) {
+    say_image_generate_mipmaps(img);
+    say_texture_make_current(img->texture, unit);
+  }
 }
 
 void say_image_update_texture(say_image *img) {
   if (!img->pixels)
     return;
 
-  say_texture_make_current(img->texture, 0);
-  say_pixel_bus_unbind_unpack();
-  glTexSubImage2D(GL_TEXTURE_2D, 0,
-                  0, 0,
-                  img->width, img->height,
-                  GL_RGBA, GL_UNSIGNED_BYTE, img->pixels);
+  if (img->atlas_page) {
+    say_image_update_texture(say_image_get_texture_image(img));
+    return;
+  }
+
+  if (img->compressed || img->dirty_count != 0)
+    say_texture_will_change(img->texture);
+
+  if (img->compressed) {
+    /* Modified pixels can't be written back into compressed blocks */
+    say_texture_make_current(img->texture, 0);
+    say_pixel_bus_unbind_unpack();
+
+    say_image_uncompress_texture(img);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, img->width, img->height, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, img->pixels);
+  }
+  else if (img->dirty_count != 0) {
+    say_texture_make_current(img->texture, 0);
+    say_pixel_bus_unbind_unpack();
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, img->width);
+
+    /* Only the dirty regions are uploaded */
+    for (size_t i = 0; i < img->dirty_count; i++) {
+      say_dirty_rect *rect = &img->dirty[i];
+
+      glTexSubImage2D(GL_TEXTURE_2D, 0,
+                      rect->x0, rect->y0,
+                      rect->x1 - rect->x0, rect->y1 - rect->y0,
+                      GL_RGBA, GL_UNSIGNED_BYTE,
+                      &img->pixels[rect->y0 * img->width + rect->x0]);
+    }
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+  }
+
+  img->mipmaps_updated = false;
 
   img->texture_updated = true;
+  say_image_clear_dirty_rect(img);
 }
 
 void say_image_unbind() {
@@ -370,6 +911,11 @@ void say_image_unbind_from(int unit) {
   say_texture_make_current(0, unit);
 }
 
+void say_texture_bind(GLuint texture, int unit) {
+  say_context_ensure();
+  say_texture_make_current(texture, unit);
+}
+
 GLuint say_image_get_texture(say_image *img) {
-  return img->texture;
+  return say_image_get_texture_image(img)->texture;
 }
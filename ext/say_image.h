@@ -5,6 +5,14 @@
 
 #define SAY_MAX_TEXTURE_UNIT 32
 
+#define SAY_IMAGE_MAX_DIRTY_RECTS 8
+
+typedef struct {
+  size_t x0, y0, x1, y1;
+} say_dirty_rect;
+
+struct say_atlas;
+
 typedef struct say_image {
   GLuint texture;
 
@@ -12,9 +20,41 @@ typedef struct say_image {
   bool texture_updated;
   bool buffer_updated;
 
+  /*
+   * Regions of pixels that changed since the texture was last updated. They
+   * are merged once there are too many of them.
+   */
+  say_dirty_rect dirty[SAY_IMAGE_MAX_DIRTY_RECTS];
+  size_t         dirty_count;
+
   size_t width, height;
 
   bool smooth;
+
+  /*
+   * Mipmapped images are sampled from a chain of downscaled levels, generated
+   * the next time the image is bound after its texture changed.
+   */
+  bool  mipmapped;
+  bool  mipmaps_updated;
+  float anisotropy;
+
+  /*
+   * Compressed images are uploaded as they are stored in DDS or KTX files. Their
+   * pixel buffer is only allocated (and decompressed by the driver) when
+   * needed, and the texture is converted to RGBA once pixels are modified.
+   */
+  bool compressed;
+
+  /*
+   * When an image is packed into an atlas, its pixels live in a page of that
+   * atlas, at (atlas_x, atlas_y). tex_version changes whenever that location
+   * changes, so that texture coordinates can be recomputed.
+   */
+  struct say_atlas *atlas;
+  struct say_image *atlas_page;
+  size_t atlas_x, atlas_y;
+  size_t tex_version;
 } say_image;
 
 say_image *say_image_create();
@@ -28,10 +68,18 @@ bool say_image_resize(say_image *img, size_t w, size_t h);
 
 bool say_image_load_raw(say_image *img, size_t width, size_t height,
                         say_color *pixels);
-bool say_image_load_flipped_raw(say_image *img, size_t width, size_t height,
-                                say_color *pixels);
+bool say_image_adopt_buffer(say_image *img, size_t width, size_t height,
+                            say_color *pixels);
 bool say_image_load_file(say_image *img, const char *filename);
+uint8_t *say_image_read_file(const char *filename, size_t *size);
+say_color *say_image_decode_memory(const uint8_t *data, size_t size,
+                                   size_t *w, size_t *h);
 bool say_image_load_from_memory(say_image *img, size_t size, const char *buffer);
+bool say_image_load_compressed(say_image *img, size_t size,
+                               const uint8_t *data);
+
+bool say_image_is_compressed(say_image *img);
+void say_image_decompress(say_image *img);
 bool say_image_create_with_size(say_image *img, size_t w, size_t h);
 
 bool say_image_write_bmp(say_image *img, const char *filename);
@@ -42,14 +90,36 @@ bool say_image_write(say_image *img, const char *filename);
 bool say_image_is_smooth(say_image *img);
 void say_image_set_smooth(say_image *img, bool val);
 
+bool say_image_is_mipmapped(say_image *img);
+bool say_image_set_mipmapped(say_image *img, bool val);
+
+bool say_image_anisotropy_is_available();
+float say_image_get_anisotropy(say_image *img);
+void say_image_set_anisotropy(say_image *img, float val);
+
+void say_image_generate_mipmaps(say_image *img);
+
 say_color say_image_get(say_image *img, size_t x, size_t y);
 void say_image_set(say_image *img, size_t x, size_t y, say_color color);
 
+void say_image_fill_rect(say_image *img, say_rect rect, say_color color);
+void say_image_blit(say_image *img, say_image *src, say_rect src_rect,
+                    say_vector2 pos);
+
 say_rect say_image_get_tex_rect(say_image *img, say_rect rect);
+size_t say_image_get_tex_version(say_image *img);
+say_vector2 say_image_get_atlas_pos(say_image *img);
+
+say_image *say_image_get_texture_image(say_image *img);
+void say_image_set_atlas(say_image *img, struct say_atlas *atlas,
+                         say_image *page, size_t x, size_t y);
 
 say_color *say_image_get_buffer(say_image *img);
 
 void say_image_mark_out_of_date(say_image *img);
+void say_image_mark_texture_out_of_date(say_image *img);
+void say_image_mark_rect_out_of_date(say_image *img, size_t x, size_t y,
+                                     size_t w, size_t h);
 
 void say_image_bind(say_image *img);
 void say_image_bind_to(say_image *img, int unit);
@@ -60,4 +130,6 @@ void say_image_update_texture(say_image *img);
 
 GLuint say_image_get_texture(say_image *img);
 
+void say_texture_bind(GLuint texture, int unit);
+
 #endif
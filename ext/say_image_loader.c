@@ -0,0 +1,249 @@
+#include "say.h"
+
+static say_thread *say_image_loader_threads[SAY_IMAGE_LOADER_THREADS];
+
+static say_mutex *say_image_loader_mutex = NULL;
+static say_cond  *say_image_loader_queued = NULL;
+static say_cond  *say_image_loader_done   = NULL;
+
+static say_image_job *say_image_loader_first = NULL;
+static say_image_job *say_image_loader_last  = NULL;
+
+static bool say_image_loader_running  = false;
+static bool say_image_loader_stopping = false;
+
+/* Must be called with the mutex locked */
+static void say_image_job_unref(say_image_job *job) {
+  if (--job->ref_count != 0)
+    return;
+
+  if (job->pixels)
+    free(job->pixels);
+
+  if (job->data)
+    free(job->data);
+
+  free(job->filename);
+  free(job);
+}
+
+static say_image_job *say_image_loader_pop() {
+  say_image_job *job = say_image_loader_first;
+
+  say_image_loader_first = job->next;
+  if (!say_image_loader_first)
+    say_image_loader_last = NULL;
+
+  job->next = NULL;
+  return job;
+}
+
+static void *say_image_loader_thread(void *data) {
+  say_mutex_lock(say_image_loader_mutex);
+
+  while (true) {
+    while (!say_image_loader_first && !say_image_loader_stopping)
+      say_cond_wait(say_image_loader_queued, say_image_loader_mutex);
+
+    if (say_image_loader_stopping)
+      break;
+
+    say_image_job *job = say_image_loader_pop();
+
+    /* Nobody is waiting for this image anymore */
+    if (job->ref_count == 1) {
+      say_image_job_unref(job);
+      continue;
+    }
+
+    say_mutex_unlock(say_image_loader_mutex);
+
+    size_t     size   = 0, width = 0, height = 0;
+    say_color *pixels = NULL;
+
+    uint8_t *data = say_image_read_file(job->filename, &size);
+    if (data && !say_compressed_image_is_container(data, size)) {
+      pixels = say_image_decode_memory(data, size, &width, &height);
+
+      free(data);
+      data = NULL;
+    }
+
+    say_mutex_lock(say_image_loader_mutex);
+
+    job->pixels    = pixels;
+    job->width     = width;
+    job->height    = height;
+    job->data      = data;
+    job->data_size = data ? size : 0;
+    job->state     = (pixels || data) ? SAY_IMAGE_JOB_DONE :
+      SAY_IMAGE_JOB_FAILED;
+
+    say_cond_broadcast(say_image_loader_done);
+    say_image_job_unref(job);
+  }
+
+  say_mutex_unlock(say_image_loader_mutex);
+  return NULL;
+}
+
+static void say_image_loader_start() {
+  if (!say_image_loader_mutex) {
+    say_image_loader_mutex  = say_mutex_create();
+    say_image_loader_queued = say_cond_create();
+    say_image_loader_done   = say_cond_create();
+  }
+
+  if (say_image_loader_running)
+    return;
+
+  say_image_loader_running  = true;
+  say_image_loader_stopping = false;
+
+  for (size_t i = 0; i < SAY_IMAGE_LOADER_THREADS; i++) {
+    say_image_loader_threads[i] = say_thread_create(NULL,
+                                                    say_image_loader_thread);
+  }
+}
+
+say_image_job *say_image_loader_push(const char *filename) {
+  say_image_loader_start();
+
+  say_image_job *job = malloc(sizeof(say_image_job));
+
+  job->filename  = say_strdup(filename);
+  job->pixels    = NULL;
+  job->width     = 0;
+  job->height    = 0;
+  job->data      = NULL;
+  job->data_size = 0;
+  job->state     = SAY_IMAGE_JOB_PENDING;
+  job->ref_count = 2;
+  job->next      = NULL;
+
+  job->wait_interrupted = false;
+
+  say_mutex_lock(say_image_loader_mutex);
+
+  if (say_image_loader_last)
+    say_image_loader_last->next = job;
+  else
+    say_image_loader_first = job;
+  say_image_loader_last = job;
+
+  say_cond_signal(say_image_loader_queued);
+  say_mutex_unlock(say_image_loader_mutex);
+
+  return job;
+}
+
+say_image_job_state say_image_job_get_state(say_image_job *job) {
+  say_mutex_lock(say_image_loader_mutex);
+  say_image_job_state state = job->state;
+  say_mutex_unlock(say_image_loader_mutex);
+
+  return state;
+}
+
+/*
+ * Returns once the job is done, or early if say_image_job_interrupt_wait gets
+ * called in the meantime.
+ */
+void say_image_job_wait(say_image_job *job) {
+  say_mutex_lock(say_image_loader_mutex);
+
+  while (job->state == SAY_IMAGE_JOB_PENDING && !job->wait_interrupted)
+    say_cond_wait(say_image_loader_done, say_image_loader_mutex);
+  job->wait_interrupted = false;
+
+  say_mutex_unlock(say_image_loader_mutex);
+}
+
+void say_image_job_interrupt_wait(say_image_job *job) {
+  say_mutex_lock(say_image_loader_mutex);
+  job->wait_interrupted = true;
+  say_cond_broadcast(say_image_loader_done);
+  say_mutex_unlock(say_image_loader_mutex);
+}
+
+size_t say_image_job_get_byte_size(say_image_job *job) {
+  if (job->data)
+    return job->data_size;
+
+  return job->width * job->height * sizeof(say_color);
+}
+
+bool say_image_job_load(say_image_job *job, say_image *img) {
+  while (say_image_job_get_state(job) == SAY_IMAGE_JOB_PENDING)
+    say_image_job_wait(job);
+
+  if (job->state == SAY_IMAGE_JOB_FAILED) {
+    say_error_set("could not load image");
+    return false;
+  }
+  else if (job->data) {
+    /* Compressed containers are uploaded as they are */
+    bool ret = say_image_load_compressed(img, job->data_size, job->data);
+
+    free(job->data);
+    job->data = NULL;
+
+    return ret;
+  }
+  else if (!job->pixels) {
+    say_error_set("image has already been loaded");
+    return false;
+  }
+
+  /* The decoded buffer is handed over to the image without being copied */
+  say_color *pixels = job->pixels;
+  job->pixels = NULL;
+
+  if (!say_image_adopt_buffer(img, job->width, job->height, pixels))
+    return false;
+
+  /* Uploads now rather than the first time the image is drawn */
+  say_image_update_texture(img);
+  return true;
+}
+
+void say_image_job_release(say_image_job *job) {
+  say_mutex_lock(say_image_loader_mutex);
+  say_image_job_unref(job);
+  say_mutex_unlock(say_image_loader_mutex);
+}
+
+/*
+ * Stops the loader threads. The lock and the condition variables are kept
+ * alive: jobs that haven't been garbage collected yet still need them when they
+ * are queried or freed.
+ */
+void say_image_loader_clean_up() {
+  if (!say_image_loader_running)
+    return;
+
+  say_mutex_lock(say_image_loader_mutex);
+  say_image_loader_stopping = true;
+  say_cond_broadcast(say_image_loader_queued);
+  say_mutex_unlock(say_image_loader_mutex);
+
+  for (size_t i = 0; i < SAY_IMAGE_LOADER_THREADS; i++) {
+    say_thread_join(say_image_loader_threads[i]);
+    say_thread_free(say_image_loader_threads[i]);
+  }
+
+  say_mutex_lock(say_image_loader_mutex);
+
+  /* Drop the loader's reference to jobs that were never started */
+  while (say_image_loader_first) {
+    say_image_job *job = say_image_loader_pop();
+    job->state = SAY_IMAGE_JOB_FAILED;
+    say_image_job_unref(job);
+  }
+
+  /* Wakes up threads waiting for those jobs */
+  say_cond_broadcast(say_image_loader_done);
+
+  say_image_loader_running = false;
+  say_mutex_unlock(say_image_loader_mutex);
+}
@@ -0,0 +1,51 @@
+#ifndef SAY_IMAGE_LOADER_H_
+#define SAY_IMAGE_LOADER_H_
+
+#include "say_image.h"
+#include "say_thread.h"
+
+#define SAY_IMAGE_LOADER_THREADS 2
+
+typedef enum {
+  SAY_IMAGE_JOB_PENDING,
+  SAY_IMAGE_JOB_DONE,
+  SAY_IMAGE_JOB_FAILED
+} say_image_job_state;
+
+/*
+ * A file being decoded by the loader threads. Jobs are reference counted: one
+ * reference is held by the loader until the file is decoded, the other by the
+ * caller until say_image_job_release is called.
+ */
+typedef struct say_image_job {
+  char *filename;
+
+  say_color *pixels;
+  size_t width, height;
+
+  /* Compressed containers are read but left for the GPU to decode */
+  uint8_t *data;
+  size_t data_size;
+
+  say_image_job_state state;
+  size_t ref_count;
+
+  bool wait_interrupted;
+
+  struct say_image_job *next;
+} say_image_job;
+
+say_image_job *say_image_loader_push(const char *filename);
+
+say_image_job_state say_image_job_get_state(say_image_job *job);
+void say_image_job_wait(say_image_job *job);
+void say_image_job_interrupt_wait(say_image_job *job);
+
+size_t say_image_job_get_byte_size(say_image_job *job);
+
+bool say_image_job_load(say_image_job *job, say_image *img);
+void say_image_job_release(say_image_job *job);
+
+void say_image_loader_clean_up();
+
+#endif
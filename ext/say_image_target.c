@@ -89,6 +89,9 @@ say_image_target *say_image_target_create() {
   target->target = say_target_create();
   target->img    = NULL;
 
+  /* Rows are rendered top-down, the way images store them */
+  say_target_set_flip_y(target->target, true);
+
   target->fbos = mo_hash_create(sizeof(say_context*), sizeof(say_fbo));
   target->fbos->release = say_fbo_delete_current;
   target->fbos->hash_of = mo_hash_of_pointer;
@@ -112,6 +115,15 @@ void say_image_target_free(say_image_target *target) {
 
 void say_image_target_set_image(say_image_target *target, say_image *image) {
   say_context_ensure();
+
+  /* Rendering is done directly to the image's own texture */
+  if (image && image->atlas)
+    say_atlas_remove(image->atlas, image);
+
+  /* Compressed textures can't be rendered to */
+  if (image)
+    say_image_decompress(image);
+
   target->img = image;
 
   if (target->img) {
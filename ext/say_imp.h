@@ -66,5 +66,6 @@ say_imp_context  say_imp_context_create_for_window(say_imp_context shared,
 
 void say_imp_context_make_current(say_imp_context ctxt);
 void say_imp_context_update(say_imp_context ctxt);
+void say_imp_context_set_vsync(say_imp_context ctxt, bool val);
 
 #endif
@@ -89,6 +89,27 @@ void say_index_buffer_resize(say_index_buffer *buf, size_t size) {
                mo_array_at(&buf->buffer, 0), buf->type);
 }
 
+void say_index_buffer_resize_storage(say_index_buffer *buf, size_t size) {
+  say_context_ensure();
+  say_index_buffer_bind(buf);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, size * sizeof(GLuint), NULL,
+               buf->type);
+}
+
+GLuint *say_index_buffer_map_range(say_index_buffer *buf, size_t index,
+                                   size_t size, GLbitfield access) {
+  say_context_ensure();
+  say_index_buffer_bind(buf);
+  return glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, index * sizeof(GLuint),
+                          size * sizeof(GLuint), access);
+}
+
+void say_index_buffer_unmap(say_index_buffer *buf) {
+  say_context_ensure();
+  say_index_buffer_bind(buf);
+  glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+}
+
 GLuint *say_index_buffer_get(say_index_buffer *buf, size_t i) {
   return mo_array_get_ptr(&buf->buffer, i, GLuint);
 }
@@ -24,6 +24,11 @@ void say_index_buffer_update(say_index_buffer *buf);
 size_t say_index_buffer_get_size(say_index_buffer *buf);
 void   say_index_buffer_resize(say_index_buffer *buf, size_t size);
 
+void say_index_buffer_resize_storage(say_index_buffer *buf, size_t size);
+GLuint *say_index_buffer_map_range(say_index_buffer *buf, size_t index,
+                                   size_t size, GLbitfield access);
+void say_index_buffer_unmap(say_index_buffer *buf);
+
 GLuint *say_index_buffer_get(say_index_buffer *buf, size_t i);
 
 GLuint say_index_buffer_get_ibo(say_index_buffer *buf);
@@ -0,0 +1,212 @@
+#include "say.h"
+
+/*
+ * Sounds don't own an OpenAL source. They borrow one of a fixed amount of
+ * voices while they are playing, so that bursts of sounds can't exhaust the
+ * sources provided by the implementation. When every voice is in use, the one
+ * playing the least important sound is stolen.
+ */
+typedef struct {
+  ALuint src;
+  say_sound *owner;
+} say_voice;
+
+static mo_array say_mixer_voices;
+static bool say_mixer_initialized = false;
+
+static size_t say_mixer_voice_count = SAY_MIXER_DEFAULT_VOICE_COUNT;
+
+/* Set once the implementation refused to create more sources */
+static bool say_mixer_exhausted = false;
+
+static void say_mixer_init() {
+  if (!say_mixer_initialized) {
+    mo_array_init(&say_mixer_voices, sizeof(say_voice));
+    say_mixer_initialized = true;
+  }
+}
+
+static bool say_mixer_voice_is_idle(say_voice *voice) {
+  if (!voice->owner)
+    return true;
+
+  ALint state;
+  alGetSourcei(voice->src, AL_SOURCE_STATE, &state);
+
+  return state == AL_STOPPED || state == AL_INITIAL;
+}
+
+static void say_mixer_evict(say_voice *voice) {
+  if (!voice->owner)
+    return;
+
+  alSourceStop(voice->src);
+  alSourcei(voice->src, AL_BUFFER, 0);
+
+  voice->owner->src->src = 0;
+  voice->owner->offset   = 0;
+
+  voice->owner = NULL;
+}
+
+/*
+ * How loud a sound is perceived by the listener, using the inverse clamped
+ * distance model OpenAL uses by default.
+ */
+static float say_mixer_audibility(say_sound *snd) {
+  say_audio_source *src = snd->src;
+
+  say_vector3 pos = src->pos;
+  if (!src->relative) {
+    say_vector3 listener = say_audio_get_pos();
+    pos = say_make_vector3(pos.x - listener.x, pos.y - listener.y,
+                           pos.z - listener.z);
+  }
+
+  float dist = sqrtf(pos.x * pos.x + pos.y * pos.y + pos.z * pos.z);
+  if (dist < src->min_distance)
+    dist = src->min_distance;
+
+  float denom = src->min_distance + src->attenuation * (dist - src->min_distance);
+  if (denom <= 0)
+    return src->gain;
+
+  return src->gain * src->min_distance / denom;
+}
+
+/* Returns true if a is less important than b */
+static bool say_mixer_is_less_important(say_sound *a, float a_audibility,
+                                        say_sound *b, float b_audibility) {
+  if (a->priority != b->priority)
+    return a->priority < b->priority;
+  else
+    return a_audibility < b_audibility;
+}
+
+static say_voice *say_mixer_find_voice(say_sound *snd) {
+  for (size_t i = 0; i < say_mixer_voices.size; i++) {
+    say_voice *voice = mo_array_at(&say_mixer_voices, i);
+    if (say_mixer_voice_is_idle(voice))
+      return voice;
+  }
+
+  if (say_mixer_voices.size < say_mixer_voice_count && !say_mixer_exhausted) {
+    say_voice voice = {0, NULL};
+
+    alGetError();
+    alGenSources(1, &voice.src);
+
+    if (alGetError() == AL_NO_ERROR) {
+      mo_array_push(&say_mixer_voices, &voice);
+      return mo_array_at(&say_mixer_voices, say_mixer_voices.size - 1);
+    }
+
+    say_mixer_exhausted = true;
+  }
+
+  say_voice *victim = NULL;
+  float victim_audibility = 0;
+
+  for (size_t i = 0; i < say_mixer_voices.size; i++) {
+    say_voice *voice = mo_array_at(&say_mixer_voices, i);
+    float audibility = say_mixer_audibility(voice->owner);
+
+    if (!victim || say_mixer_is_less_important(voice->owner, audibility,
+                                               victim->owner,
+                                               victim_audibility)) {
+      victim            = voice;
+      victim_audibility = audibility;
+    }
+  }
+
+  if (victim && say_mixer_is_less_important(victim->owner, victim_audibility,
+                                            snd, say_mixer_audibility(snd)))
+    return victim;
+
+  return NULL;
+}
+
+bool say_mixer_acquire(say_sound *snd) {
+  if (snd->src->src)
+    return true;
+
+  say_audio_context_ensure();
+  say_mixer_init();
+
+  say_voice *voice = say_mixer_find_voice(snd);
+  if (!voice)
+    return false;
+
+  say_mixer_evict(voice);
+
+  voice->owner  = snd;
+  snd->src->src = voice->src;
+
+  say_audio_source_apply(snd->src);
+  alSourcei(voice->src, AL_BUFFER, snd->buf ? snd->buf->buf : 0);
+  alSourcei(voice->src, AL_LOOPING, snd->looping);
+
+  return true;
+}
+
+void say_mixer_release(say_sound *snd) {
+  if (!snd->src->src)
+    return;
+
+  for (size_t i = 0; i < say_mixer_voices.size; i++) {
+    say_voice *voice = mo_array_at(&say_mixer_voices, i);
+    if (voice->owner == snd) {
+      say_mixer_evict(voice);
+      break;
+    }
+  }
+}
+
+void say_mixer_set_voice_count(size_t count) {
+  say_mixer_init();
+
+  while (say_mixer_voices.size > count) {
+    say_voice *voice = mo_array_at(&say_mixer_voices,
+                                   say_mixer_voices.size - 1);
+    say_mixer_evict(voice);
+    alDeleteSources(1, &voice->src);
+
+    mo_array_resize(&say_mixer_voices, say_mixer_voices.size - 1);
+  }
+
+  say_mixer_voice_count = count;
+  say_mixer_exhausted   = false;
+}
+
+size_t say_mixer_get_voice_count() {
+  return say_mixer_voice_count;
+}
+
+size_t say_mixer_get_active_voice_count() {
+  if (!say_mixer_initialized)
+    return 0;
+
+  size_t count = 0;
+  for (size_t i = 0; i < say_mixer_voices.size; i++) {
+    if (!say_mixer_voice_is_idle(mo_array_at(&say_mixer_voices, i)))
+      count++;
+  }
+
+  return count;
+}
+
+void say_mixer_clean_up() {
+  if (!say_mixer_initialized)
+    return;
+
+  for (size_t i = 0; i < say_mixer_voices.size; i++) {
+    say_voice *voice = mo_array_at(&say_mixer_voices, i);
+    say_mixer_evict(voice);
+    alDeleteSources(1, &voice->src);
+  }
+
+  mo_array_release(&say_mixer_voices);
+
+  say_mixer_initialized = false;
+  say_mixer_exhausted   = false;
+}
@@ -1,27 +1,58 @@
 #include "say.h"
 
-static size_t say_music_get_buf_size(say_music *music) {
-  return music->info.channels * music->info.samplerate;
+/*
+ * A single thread refills the buffers of every music. It sleeps until the
+ * first queued buffer of a playing music may have been processed, and is woken
+ * up immediately whenever a music starts, seeks, or stops.
+ */
+static say_thread *say_music_thread = NULL;
+static say_mutex  *say_music_lock   = NULL;
+static say_cond   *say_music_cond   = NULL;
+
+static mo_array say_music_list;
+static bool say_music_thread_running = false;
+
+static size_t say_music_get_chunk_size(say_music *music) {
+  return music->info.channels * music->buffer_size;
 }
 
-static sf_count_t say_music_read_chunk(say_music *music, short *buf) {
-  sf_count_t size = (sf_count_t)say_music_get_buf_size(music);
-  return sf_read_short(music->file, buf, size);
+static void say_music_alloc_chunk(say_music *music) {
+  size_t size = say_music_get_chunk_size(music);
+
+  if (size > music->chunk_capacity) {
+    music->chunk = realloc(music->chunk, sizeof(short) * size);
+    music->chunk_capacity = size;
+  }
+
+  say_audio_converter *conv = &music->converter;
+  size_t out_size = conv->out_channels *
+    say_audio_converter_get_max_output(conv, music->buffer_size);
+
+  if (out_size > music->converted_capacity) {
+    music->converted = realloc(music->converted, sizeof(short) * out_size);
+    music->converted_capacity = out_size;
+  }
 }
 
 static bool say_music_fill_buffer(say_music *music, ALint al_buffer) {
-  sf_count_t sample_count = say_music_get_buf_size(music);
+  say_audio_converter *conv = &music->converter;
 
-  size_t buf_size = sizeof(short) * sample_count;
-  short *buf = malloc(buf_size);
+  sf_count_t frames = sf_readf_short(music->file, music->chunk,
+                                     music->buffer_size);
 
-  sf_count_t read_samples = say_music_read_chunk(music, buf);
-  alBufferData(al_buffer, music->format, buf, read_samples * sizeof(short),
-               music->info.samplerate);
-
-  free(buf);
+  if (say_audio_converter_is_identity(conv)) {
+    alBufferData(al_buffer, music->format, music->chunk,
+                 frames * conv->in_channels * sizeof(short), conv->in_rate);
+  }
+  else {
+    size_t out_frames = say_audio_converter_run(conv, music->chunk, frames,
+                                                music->converted);
+    alBufferData(al_buffer, music->format, music->converted,
+                 out_frames * conv->out_channels * sizeof(short),
+                 conv->out_rate);
+  }
 
-  return read_samples != 0;
+  return frames != 0;
 }
 
 static void say_music_start_stream(say_music *music) {
@@ -35,68 +66,119 @@ static void say_music_start_stream(say_music *music) {
     alSourceUnqueueBuffers(music->src->src, 1, &buf);
   }
 
-  for (size_t i = 0; i < SAY_MUSIC_BUF_COUNT; i++) {
+  for (size_t i = 0; i < music->buffer_count; i++) {
     say_music_fill_buffer(music, music->buffers[i]);
     alSourceQueueBuffers(music->src->src, 1, &music->buffers[i]);
     music->last_buffer = music->buffers[i];
   }
 }
 
-static void *say_music_playback_thread(say_music *music) {
-  while (music->continue_running) {
+static void say_music_seek_unlocked(say_music *music, float time) {
+  if (music->file) {
+    music->played_time = time;
+    sf_seek(music->file, music->info.samplerate * time, SEEK_SET);
+    say_audio_converter_reset(&music->converter);
+
     if (music->streaming) {
-      ALint processed = 0;
-      alGetSourcei(music->src->src, AL_BUFFERS_PROCESSED, &processed);
-
-      while (processed > 0) {
-        processed--;
-
-        ALuint buffer;
-        alSourceUnqueueBuffers(music->src->src, 1, &buffer);
-
-        /* compute duration of the buffer */
-        ALint size, chan, freq;
-        alGetBufferi(buffer, AL_SIZE, &size);
-        alGetBufferi(buffer, AL_FREQUENCY, &freq);
-        alGetBufferi(buffer, AL_CHANNELS, &chan);
-
-        /* adds 1 for any buffer but the last one */
-        music->played_time += (float)size / (freq * chan * sizeof(short));
-
-        bool still_playing = say_music_fill_buffer(music, buffer);
-        if (!still_playing) {
-          if (music->looping && music->last_buffer == buffer) {
-            say_music_seek(music, 0);
-          }
-          else if (!music->looping) {
-            music->streaming = false;
-          }
-        }
-        else {
-          alSourceQueueBuffers(music->src->src, 1, &buffer);
-          music->last_buffer = buffer;
-        }
+      music->streaming = false;
+      alSourceStop(music->src->src);
+
+      say_music_start_stream(music);
+
+      alSourcePlay(music->src->src);
+      music->streaming = true;
+    }
+  }
+}
+
+static void say_music_update(say_music *music) {
+  ALint processed = 0;
+  alGetSourcei(music->src->src, AL_BUFFERS_PROCESSED, &processed);
+
+  while (processed > 0) {
+    processed--;
+
+    ALuint buffer;
+    alSourceUnqueueBuffers(music->src->src, 1, &buffer);
+
+    /* compute duration of the buffer */
+    ALint size, chan, freq;
+    alGetBufferi(buffer, AL_SIZE, &size);
+    alGetBufferi(buffer, AL_FREQUENCY, &freq);
+    alGetBufferi(buffer, AL_CHANNELS, &chan);
+
+    music->played_time += (float)size / (freq * chan * sizeof(short));
+
+    bool still_playing = say_music_fill_buffer(music, buffer);
+    if (!still_playing) {
+      if (music->looping && music->last_buffer == buffer) {
+        say_music_seek_unlocked(music, 0);
+        return;
       }
+      else if (!music->looping) {
+        music->streaming = false;
+      }
+    }
+    else {
+      alSourceQueueBuffers(music->src->src, 1, &buffer);
+      music->last_buffer = buffer;
     }
+  }
+}
 
-    /* sleep for 0.1s */
-    static const int sleep_time = 100;
+static void *say_music_stream_thread(void *data) {
+  say_mutex_lock(say_music_lock);
 
-#ifdef SAY_WIN
-    Sleep(sleep_time);
-#else
-    usleep(sleep_time * 1000);
-#endif
+  while (say_music_thread_running) {
+    float delay = -1;
+
+    for (size_t i = 0; i < say_music_list.size; i++) {
+      say_music *music = mo_array_get_as(&say_music_list, i, say_music*);
+      if (!music->streaming)
+        continue;
+
+      say_music_update(music);
+
+      /* Wake up twice per buffer so that it never runs dry */
+      float buf_duration = (float)music->buffer_size / music->info.samplerate;
+      if (delay < 0 || buf_duration / 2 < delay)
+        delay = buf_duration / 2;
+    }
+
+    if (delay < 0)
+      say_cond_wait(say_music_cond, say_music_lock);
+    else
+      say_cond_timed_wait(say_music_cond, say_music_lock, delay);
   }
 
+  say_mutex_unlock(say_music_lock);
   return NULL;
 }
 
+static void say_music_wake_up() {
+  say_cond_signal(say_music_cond);
+}
+
 say_music *say_music_create() {
   say_music *music = malloc(sizeof(say_music));
 
   music->src = say_audio_source_create();
-  alGenBuffers(SAY_MUSIC_BUF_COUNT, music->buffers);
+
+  music->buffer_count = SAY_MUSIC_DEFAULT_BUF_COUNT;
+  music->buffer_size  = SAY_MUSIC_DEFAULT_BUF_SIZE;
+
+  music->custom_buffer_size = false;
+
+  music->buffers = malloc(sizeof(ALuint) * music->buffer_count);
+  alGenBuffers(music->buffer_count, music->buffers);
+
+  music->chunk          = NULL;
+  music->chunk_capacity = 0;
+
+  say_audio_converter_init(&music->converter, 1, 1, 1, 1, 1);
+
+  music->converted          = NULL;
+  music->converted_capacity = 0;
 
   music->last_buffer = 0;
 
@@ -104,37 +186,92 @@ say_music *say_music_create() {
 
   music->duration = 0;
 
-  music->continue_running = true;
-  music->streaming        = false;
+  music->streaming = false;
+  music->looping   = false;
+
+  if (!say_music_lock) {
+    say_music_lock = say_mutex_create();
+    say_music_cond = say_cond_create();
+
+    mo_array_init(&say_music_list, sizeof(say_music*));
+  }
+
+  say_mutex_lock(say_music_lock);
 
-  music->looping = false;
+  mo_array_push(&say_music_list, &music);
 
-  music->thread = say_thread_create(music,
-                                    (say_thread_func)say_music_playback_thread);
+  if (!say_music_thread) {
+    say_music_thread_running = true;
+    say_music_thread = say_thread_create(NULL, say_music_stream_thread);
+  }
+
+  say_mutex_unlock(say_music_lock);
 
   return music;
 }
 
-void say_music_free(say_music *music) {
-  music->continue_running = false;
+static void say_music_stop_thread() {
+  say_mutex_lock(say_music_lock);
+  say_music_thread_running = false;
+  say_music_wake_up();
+  say_mutex_unlock(say_music_lock);
 
 #ifndef SAY_WIN
-  say_thread_join(music->thread);
+  say_thread_join(say_music_thread);
 #endif
-  say_thread_free(music->thread);
+  say_thread_free(say_music_thread);
+
+  say_music_thread = NULL;
+}
 
+void say_music_free(say_music *music) {
+  say_mutex_lock(say_music_lock);
+
+  for (size_t i = 0; i < say_music_list.size; i++) {
+    if (mo_array_get_as(&say_music_list, i, say_music*) == music) {
+      mo_array_delete(&say_music_list, i);
+      break;
+    }
+  }
+
+  /* Buffers can't be deleted while they are still queued */
   alSourceStop(music->src->src);
-  alDeleteBuffers(SAY_MUSIC_BUF_COUNT, music->buffers);
+  alSourcei(music->src->src, AL_BUFFER, 0);
+  alDeleteBuffers(music->buffer_count, music->buffers);
+
+  bool last_music = say_music_list.size == 0;
+
+  say_mutex_unlock(say_music_lock);
+
+  /* Don't keep an idle thread around once every music is gone */
+  if (last_music && say_music_thread)
+    say_music_stop_thread();
 
   say_audio_source_free(music->src);
 
   if (music->file)
     sf_close(music->file);
 
+  say_audio_converter_release(&music->converter);
+
+  free(music->buffers);
+  free(music->chunk);
+  free(music->converted);
   free(music);
 }
 
+/*
+ * The lock is kept alive: musics that haven't been garbage collected yet still
+ * need it when they are freed.
+ */
+void say_music_clean_up() {
+  if (say_music_thread)
+    say_music_stop_thread();
+}
+
 bool say_music_open(say_music *music, const char *filename) {
+  say_mutex_lock(say_music_lock);
+
   music->streaming = false;
   alSourceStop(music->src->src);
 
@@ -145,55 +282,152 @@ bool say_music_open(say_music *music, const char *filename) {
   music->file = sf_open(filename, SFM_READ, &music->info);
 
   if (!music->file) {
+    say_mutex_unlock(say_music_lock);
+
     say_error_set(sf_strerror(music->file));
     return false;
   }
 
-  music->format = say_audio_get_format(music->info.channels);
+  size_t channels = music->info.channels;
+
+  music->format = say_audio_get_format(channels);
+  if (!music->format && channels > 2) {
+    channels = 2;
+    music->format = say_audio_get_format(channels);
+  }
+
   if (!music->format) {
     sf_close(music->file);
     music->file = NULL;
 
+    say_mutex_unlock(say_music_lock);
+
     say_error_set("unsupported amount of channels");
     return false;
   }
 
+  /* Decoded chunks are converted to the rate of the device while streaming */
+  say_audio_converter_release(&music->converter);
+  say_audio_converter_init(&music->converter,
+                           music->info.channels, music->info.samplerate,
+                           channels, say_audio_get_device_rate(), 1);
+
+  if (!music->custom_buffer_size)
+    music->buffer_size = music->info.samplerate;
+
+  say_music_alloc_chunk(music);
+
   music->duration = (float)music->info.frames / music->info.samplerate;
   music->played_time = 0;
 
+  say_mutex_unlock(say_music_lock);
+
   return true;
 }
 
-void say_music_set_looping(say_music *music, bool val) {
-  music->looping = val;
-}
+/*
+ * Stops streaming, changes how buffers are laid out, and resumes playback from
+ * where it was.
+ */
+static void say_music_reconfigure(say_music *music, size_t count,
+                                  size_t frames) {
+  say_mutex_lock(say_music_lock);
 
-bool say_music_is_looping(say_music *music) {
-  return music->looping;
-}
+  bool was_streaming = music->streaming;
+
+  ALfloat offset = 0.0f;
+  alGetSourcef(music->src->src, AL_SEC_OFFSET, &offset);
+  float time = offset + music->played_time;
+
+  music->streaming = false;
+  alSourceStop(music->src->src);
+  alSourcei(music->src->src, AL_BUFFER, 0);
+
+  if (count != music->buffer_count) {
+    alDeleteBuffers(music->buffer_count, music->buffers);
+
+    music->buffer_count = count;
+    music->buffers = realloc(music->buffers, sizeof(ALuint) * count);
+    alGenBuffers(count, music->buffers);
+  }
+
+  music->buffer_size = frames;
 
-void say_music_seek(say_music *music, float time) {
   if (music->file) {
+    say_music_alloc_chunk(music);
+
     music->played_time = time;
     sf_seek(music->file, music->info.samplerate * time, SEEK_SET);
+    say_audio_converter_reset(&music->converter);
 
-    if (music->streaming) {
-      music->streaming = false;
-      alSourceStop(music->src->src);
-
+    if (was_streaming) {
       say_music_start_stream(music);
-
       alSourcePlay(music->src->src);
+
       music->streaming = true;
+      say_music_wake_up();
     }
   }
+
+  say_mutex_unlock(say_music_lock);
+}
+
+void say_music_set_buffer_count(say_music *music, size_t count) {
+  if (count < 2)
+    count = 2;
+
+  if (count != music->buffer_count)
+    say_music_reconfigure(music, count, music->buffer_size);
+}
+
+size_t say_music_get_buffer_count(say_music *music) {
+  return music->buffer_count;
+}
+
+void say_music_set_buffer_size(say_music *music, size_t frames) {
+  if (frames < 1)
+    frames = 1;
+
+  music->custom_buffer_size = true;
+
+  if (frames != music->buffer_size)
+    say_music_reconfigure(music, music->buffer_count, frames);
+}
+
+size_t say_music_get_buffer_size(say_music *music) {
+  return music->buffer_size;
+}
+
+void say_music_set_looping(say_music *music, bool val) {
+  say_mutex_lock(say_music_lock);
+  music->looping = val;
+  say_mutex_unlock(say_music_lock);
+}
+
+bool say_music_is_looping(say_music *music) {
+  return music->looping;
+}
+
+void say_music_seek(say_music *music, float time) {
+  say_mutex_lock(say_music_lock);
+
+  say_music_seek_unlocked(music, time);
+  say_music_wake_up();
+
+  say_mutex_unlock(say_music_lock);
 }
 
 float say_music_get_time(say_music *music) {
+  say_mutex_lock(say_music_lock);
+
   ALfloat time = 0.0f;
   alGetSourcef(music->src->src, AL_SEC_OFFSET, &time);
 
-  return time + music->played_time;
+  float ret = time + music->played_time;
+
+  say_mutex_unlock(say_music_lock);
+
+  return ret;
 }
 
 float say_music_get_duration(say_music *music) {
@@ -201,29 +435,45 @@ float say_music_get_duration(say_music *music) {
 }
 
 void say_music_play(say_music *music) {
+  say_mutex_lock(say_music_lock);
+
   if (music->file) {
     /* queue more data if sound was stopped */
     if (say_audio_source_get_status(music->src) == SAY_STATUS_STOPPED) {
-      say_music_seek(music, 0);
+      say_music_seek_unlocked(music, 0);
       say_music_start_stream(music);
     }
 
     alSourcePlay(music->src->src);
     music->streaming = true;
+
+    say_music_wake_up();
   }
+
+  say_mutex_unlock(say_music_lock);
 }
 
 void say_music_pause(say_music *music) {
+  say_mutex_lock(say_music_lock);
+
   if (music->file) {
     music->streaming = false;
     alSourcePause(music->src->src);
   }
+
+  say_mutex_unlock(say_music_lock);
 }
 
 void say_music_stop(say_music *music) {
+  say_mutex_lock(say_music_lock);
+
   if (music->file) {
     music->streaming = false;
-    say_music_seek(music, 0);
+    say_music_seek_unlocked(music, 0);
     alSourceStop(music->src->src);
+
+    say_music_wake_up();
   }
+
+  say_mutex_unlock(say_music_lock);
 }
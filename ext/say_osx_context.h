@@ -129,3 +129,8 @@ void say_imp_context_make_current(say_imp_context ctxt) {
 void say_imp_context_update(say_imp_context ctxt) {
   [ctxt update];
 }
+
+void say_imp_context_set_vsync(say_imp_context ctxt, bool val) {
+  GLint interval = val ? 1 : 0;
+  [ctxt.context setValues:&interval forParameter:NSOpenGLCPSwapInterval];
+}
@@ -76,8 +76,22 @@ size_t say_pixel_bus_pull_target(say_pixel_bus *bus,
 
   say_pixel_bus_bind_pack(bus);
 
-  glReadPixels(x, target->size.y - y - h, w, h, GL_RGBA,
-               GL_UNSIGNED_BYTE, (void*)(offset * sizeof(say_color)));
+  if (target->flip_y) {
+    glReadPixels(x, y, w, h, GL_RGBA,
+                 GL_UNSIGNED_BYTE, (void*)(offset * sizeof(say_color)));
+  }
+  else {
+    /*
+     * The window's rows are stored bottom-up. They're read one at a time so
+     * that the buffer uses the same order as images.
+     */
+    for (size_t row = 0; row < h; row++) {
+      glReadPixels(x, target->size.y - y - row - 1, w, 1, GL_RGBA,
+                   GL_UNSIGNED_BYTE,
+                   (void*)((offset + row * w) * sizeof(say_color)));
+    }
+  }
+
   return offset + w * h;
 }
 
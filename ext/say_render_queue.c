@@ -0,0 +1,260 @@
+#include "say.h"
+
+/*
+ * Items are sorted using three 64-bit keys, from the most significant one:
+ *
+ *   - 1 bit telling whether the drawable is blended (opaque ones come first),
+ *     32 bits of depth (front-to-back for opaque drawables, back-to-front for
+ *     blended ones), and 31 bits of run number;
+ *   - the shader program and the texture;
+ *   - the vertex type and the id of the global buffer.
+ *
+ * With GL_LEQUAL, the last opaque drawable wins where two of them overlap at
+ * the same depth. Opaque drawables are thus only sorted by state within a run
+ * of drawables known not to overlap: a new run starts whenever a drawable
+ * overlaps the previous ones, or when its bounds can't be known. Blended
+ * drawables only use the first key, as they must be drawn in order.
+ *
+ * Drawables with the same keys are drawn in the order they were pushed.
+ */
+
+static uint32_t say_render_queue_depth_key(float z) {
+  uint32_t bits;
+  memcpy(&bits, &z, sizeof(bits));
+
+  /* Maps floats to unsigned integers that compare the same way */
+  return (bits & 0x80000000) ? ~bits : bits | 0x80000000;
+}
+
+/*
+ * Bounds of the vertices of a drawable once transformed. Only known for
+ * drawables using the default vertex type and shader, so that vertices are
+ * known not to be moved around while drawing.
+ */
+static bool say_render_queue_get_bounds(say_drawable *drawable,
+                                        say_rect *bounds) {
+  if (drawable->vtype != 0 || drawable->shader || !drawable->slice ||
+      drawable->slice->size == 0)
+    return false;
+
+  say_affine affine;
+  if (!say_drawable_get_affine(drawable, &affine))
+    return false;
+
+  say_vertex *vertices = say_buffer_slice_get_vertex(drawable->slice, 0);
+
+  say_vector2 min = say_affine_transform(&affine, vertices[0].pos);
+  say_vector2 max = min;
+
+  for (size_t i = 1; i < drawable->slice->size; i++) {
+    say_vector2 pos = say_affine_transform(&affine, vertices[i].pos);
+
+    if (pos.x < min.x) min.x = pos.x;
+    if (pos.y < min.y) min.y = pos.y;
+    if (pos.x > max.x) max.x = pos.x;
+    if (pos.y > max.y) max.y = pos.y;
+  }
+
+  *bounds = say_make_rect(min.x, min.y, max.x - min.x, max.y - min.y);
+  return true;
+}
+
+static bool say_rect_overlaps(say_rect a, say_rect b) {
+  /* Rects that only share an edge don't cover the same pixels */
+  return a.x < b.x + b.w && b.x < a.x + a.w &&
+    a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+static uint32_t say_render_queue_run_for(say_render_queue *queue,
+                                         say_drawable *drawable) {
+  say_rect bounds;
+  bool known = say_render_queue_get_bounds(drawable, &bounds);
+
+  if (!known || !queue->run_bounds_known ||
+      say_rect_overlaps(queue->run_bounds, bounds)) {
+    queue->run++;
+    queue->run_bounds_known = known;
+    queue->run_bounds       = bounds;
+  }
+  else {
+    /* Grows the bounds of the run so they contain this drawable too */
+    say_rect *run = &queue->run_bounds;
+
+    float x1 = run->x + run->w, y1 = run->y + run->h;
+    if (bounds.x + bounds.w > x1) x1 = bounds.x + bounds.w;
+    if (bounds.y + bounds.h > y1) y1 = bounds.y + bounds.h;
+
+    if (bounds.x < run->x) run->x = bounds.x;
+    if (bounds.y < run->y) run->y = bounds.y;
+
+    run->w = x1 - run->x;
+    run->h = y1 - run->y;
+  }
+
+  return queue->run & 0x7FFFFFFF;
+}
+
+static void say_render_queue_make_keys(say_render_queue *queue,
+                                       say_render_item *item,
+                                       say_drawable *drawable) {
+  /* Bigger z values are closer to the viewer */
+  uint32_t depth = say_render_queue_depth_key(say_drawable_get_depth(drawable));
+
+  if (item->blend_mode != SAY_BLEND_NO) {
+    item->keys[2] = (1ULL << 63) | ((uint64_t)depth << 31);
+    item->keys[1] = 0;
+    item->keys[0] = 0;
+  }
+  else {
+    uint32_t run = say_render_queue_run_for(queue, drawable);
+
+    item->keys[2] = ((uint64_t)(uint32_t)~depth << 31) | run;
+    item->keys[1] = ((uint64_t)item->program << 32) | item->texture;
+    item->keys[0] = ((uint64_t)item->vtype << 32) | item->buffer;
+  }
+}
+
+static size_t say_render_queue_count_changes(say_render_item *items,
+                                             size_t count) {
+  size_t changes = 0;
+
+  for (size_t i = 1; i < count; i++) {
+    say_render_item *prev = &items[i - 1], *item = &items[i];
+
+    if (prev->program != item->program)       changes++;
+    if (prev->texture != item->texture)       changes++;
+    if (prev->vtype != item->vtype ||
+        prev->buffer != item->buffer)         changes++;
+    if (prev->blend_mode != item->blend_mode) changes++;
+  }
+
+  return changes;
+}
+
+/* Stable LSD radix sort, skipping bytes all keys have in common */
+static say_render_item *say_render_queue_sort(say_render_queue *queue) {
+  size_t count = queue->items.size;
+  mo_array_resize(&queue->sorted, count);
+
+  say_render_item *src = mo_array_at(&queue->items, 0);
+  say_render_item *dst = mo_array_at(&queue->sorted, 0);
+
+  for (size_t pass = 0; pass < 3 * 8; pass++) {
+    size_t key   = pass / 8;
+    size_t shift = (pass % 8) * 8;
+
+    size_t offsets[256] = {0};
+
+    for (size_t i = 0; i < count; i++)
+      offsets[(src[i].keys[key] >> shift) & 0xFF]++;
+
+    if (offsets[(src[0].keys[key] >> shift) & 0xFF] == count)
+      continue;
+
+    size_t pos = 0;
+    for (size_t i = 0; i < 256; i++) {
+      size_t n = offsets[i];
+      offsets[i] = pos;
+      pos += n;
+    }
+
+    for (size_t i = 0; i < count; i++)
+      dst[offsets[(src[i].keys[key] >> shift) & 0xFF]++] = src[i];
+
+    say_render_item *tmp = src;
+    src = dst;
+    dst = tmp;
+  }
+
+  return src;
+}
+
+say_render_queue *say_render_queue_create() {
+  say_render_queue *queue = malloc(sizeof(say_render_queue));
+
+  mo_array_init(&queue->items, sizeof(say_render_item));
+  mo_array_init(&queue->sorted, sizeof(say_render_item));
+
+  queue->run              = 0;
+  queue->run_bounds_known = false;
+
+  say_render_queue_reset_stats(queue);
+
+  return queue;
+}
+
+void say_render_queue_free(say_render_queue *queue) {
+  mo_array_release(&queue->items);
+  mo_array_release(&queue->sorted);
+  free(queue);
+}
+
+bool say_render_queue_is_empty(say_render_queue *queue) {
+  return queue->items.size == 0;
+}
+
+void say_render_queue_push(say_render_queue *queue, say_drawable *drawable) {
+  say_drawable_prepare(drawable);
+
+  say_render_item item;
+  item.drawable   = drawable;
+  item.program    = drawable->shader ? drawable->shader->program : 0;
+  item.blend_mode = drawable->blend_mode;
+  item.texture    = 0;
+  item.vtype      = 0;
+  item.buffer     = 0;
+
+  if (drawable->batch_proc) {
+    size_t first;
+    say_image *image = drawable->batch_proc(drawable->data, &first);
+    if (image)
+      item.texture = say_image_get_texture(image);
+  }
+
+  if (drawable->slice) {
+    item.vtype  = drawable->vtype;
+    item.buffer = drawable->slice->buf_id;
+  }
+
+  say_render_queue_make_keys(queue, &item, drawable);
+
+  mo_array_push(&queue->items, &item);
+}
+
+void say_render_queue_flush(say_render_queue *queue, say_renderer *renderer) {
+  size_t count = queue->items.size;
+  if (count == 0)
+    return;
+
+  queue->stats.drawables += count;
+  queue->stats.unsorted_state_changes +=
+    say_render_queue_count_changes(mo_array_at(&queue->items, 0), count);
+
+  say_render_item *items = say_render_queue_sort(queue);
+  queue->stats.state_changes += say_render_queue_count_changes(items, count);
+
+  size_t draw_calls = renderer->draw_calls;
+
+  for (size_t i = 0; i < count; i++)
+    say_renderer_push(renderer, items[i].drawable);
+  say_renderer_flush(renderer);
+
+  queue->stats.draw_calls += renderer->draw_calls - draw_calls;
+
+  mo_array_resize(&queue->items, 0);
+
+  queue->run              = 0;
+  queue->run_bounds_known = false;
+}
+
+void say_render_queue_get_stats(say_render_queue *queue,
+                                say_render_stats *stats) {
+  *stats = queue->stats;
+}
+
+void say_render_queue_reset_stats(say_render_queue *queue) {
+  queue->stats.drawables              = 0;
+  queue->stats.draw_calls             = 0;
+  queue->stats.state_changes          = 0;
+  queue->stats.unsorted_state_changes = 0;
+}
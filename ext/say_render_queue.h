@@ -0,0 +1,49 @@
+#ifndef SAY_RENDER_QUEUE_H_
+#define SAY_RENDER_QUEUE_H_
+
+#include "say_renderer.h"
+
+typedef struct {
+  uint64_t      keys[3]; /* least significant first */
+  say_drawable *drawable;
+
+  GLuint         program;
+  GLuint         texture;
+  uint32_t       vtype;
+  uint32_t       buffer;
+  say_blend_mode blend_mode;
+} say_render_item;
+
+typedef struct {
+  size_t drawables;
+  size_t draw_calls;
+
+  size_t state_changes;          /* after sorting */
+  size_t unsorted_state_changes; /* had drawables been drawn in order */
+} say_render_stats;
+
+typedef struct {
+  mo_array items;
+  mo_array sorted;
+
+  /* Drawables of a run can be reordered, as they don't overlap */
+  uint32_t run;
+  bool     run_bounds_known;
+  say_rect run_bounds;
+
+  say_render_stats stats;
+} say_render_queue;
+
+say_render_queue *say_render_queue_create();
+void say_render_queue_free(say_render_queue *queue);
+
+bool say_render_queue_is_empty(say_render_queue *queue);
+
+void say_render_queue_push(say_render_queue *queue, say_drawable *drawable);
+void say_render_queue_flush(say_render_queue *queue, say_renderer *renderer);
+
+void say_render_queue_get_stats(say_render_queue *queue,
+                                say_render_stats *stats);
+void say_render_queue_reset_stats(say_render_queue *queue);
+
+#endif
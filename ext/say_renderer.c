@@ -1,14 +1,126 @@
 #include "say.h"
 
+#define SAY_BATCH_MIN_CAPACITY 64
+
+static void say_renderer_reserve_batch(say_renderer *renderer, size_t size) {
+  if (size <= renderer->batch_capacity)
+    return;
+
+  size_t capa = renderer->batch_capacity ? renderer->batch_capacity :
+    SAY_BATCH_MIN_CAPACITY;
+  while (capa < size)
+    capa *= 2;
+
+  if (!renderer->batch_buffer) {
+    renderer->batch_buffer  = say_buffer_create(0, SAY_STREAM, capa * 4);
+    renderer->batch_indices = say_index_buffer_create(SAY_STATIC, capa * 6);
+  }
+  else {
+    say_buffer_resize(renderer->batch_buffer, capa * 4);
+    say_index_buffer_resize(renderer->batch_indices, capa * 6);
+  }
+
+  /* Quads are stored in the same order as a triangle fan would use them. */
+  for (size_t i = renderer->batch_capacity; i < capa; i++) {
+    GLuint *indices = say_index_buffer_get(renderer->batch_indices, i * 6);
+    GLuint  first   = i * 4;
+
+    indices[0] = first;
+    indices[1] = first + 1;
+    indices[2] = first + 2;
+    indices[3] = first;
+    indices[4] = first + 2;
+    indices[5] = first + 3;
+  }
+
+  say_index_buffer_update(renderer->batch_indices);
+  renderer->batch_capacity = capa;
+}
+
+static bool say_renderer_batch(say_renderer *renderer, say_drawable *drawable) {
+  if (!drawable->batch_proc || drawable->shader || drawable->vtype != 0)
+    return false;
+
+  size_t first = 0;
+  say_image *image = drawable->batch_proc(drawable->data, &first);
+  if (!image)
+    return false;
+
+  say_drawable_prepare(drawable);
+
+  /*
+   * Vertices are transformed on the CPU, which only works as long as the
+   * matrix doesn't do anything else than a 2D transformation and a
+   * translation along the z axis.
+   */
+  say_affine affine;
+  if (!say_drawable_get_affine(drawable, &affine))
+    return false;
+
+  float z = say_drawable_get_depth(drawable);
+
+  GLuint texture = say_image_get_texture(image);
+
+  if (renderer->batch_size != 0 &&
+      (renderer->batch_texture    != texture ||
+       renderer->batch_blend_mode != drawable->blend_mode ||
+       renderer->batch_z          != z)) {
+    say_renderer_flush(renderer);
+  }
+
+  if (renderer->batch_size == 0) {
+    renderer->batch_texture    = texture;
+    renderer->batch_blend_mode = drawable->blend_mode;
+    renderer->batch_z          = z;
+  }
+
+  if (!image->texture_updated)
+    say_image_update_texture(image);
+
+  if (image->mipmapped && !image->mipmaps_updated)
+    say_image_generate_mipmaps(image);
+
+  say_renderer_reserve_batch(renderer, renderer->batch_size + 1);
+
+  say_vertex *src = say_buffer_slice_get_vertex(drawable->slice, first);
+  say_vertex *dst = say_buffer_get_vertex(renderer->batch_buffer,
+                                          renderer->batch_size * 4);
+
+  for (size_t i = 0; i < 4; i++) {
+    dst[i].pos = say_affine_transform(&affine, src[i].pos);
+    dst[i].col = src[i].col;
+    dst[i].tex = src[i].tex;
+  }
+
+  renderer->batch_size++;
+  return true;
+}
+
 say_renderer *say_renderer_create() {
   say_renderer *renderer = (say_renderer*)malloc(sizeof(say_renderer));
   renderer->shader = say_shader_create();
+
+  renderer->batching       = true;
+  renderer->batch_buffer   = NULL;
+  renderer->batch_indices  = NULL;
+  renderer->batch_capacity = 0;
+  renderer->batch_size     = 0;
+  renderer->batch_matrix   = say_matrix_identity();
+
+  renderer->draw_calls = 0;
+
   say_renderer_reset_states(renderer);
 
   return renderer;
 }
 
 void say_renderer_free(say_renderer *renderer) {
+  if (renderer->batch_buffer) {
+    say_buffer_free(renderer->batch_buffer);
+    say_index_buffer_free(renderer->batch_indices);
+  }
+
+  say_matrix_free(renderer->batch_matrix);
   say_shader_free(renderer->shader);
   free(renderer);
 }
@@ -17,12 +129,25 @@ say_shader *say_renderer_get_shader(say_renderer *renderer) {
   return renderer->shader;
 }
 
+void say_renderer_set_batching(say_renderer *renderer, bool val) {
+  renderer->batching = val;
+}
+
+bool say_renderer_is_batching(say_renderer *renderer) {
+  return renderer->batching;
+}
+
 void say_renderer_reset_states(say_renderer *renderer) {
   renderer->using_texture = 0;
   say_shader_set_int_id(renderer->shader, SAY_TEXTURE_ENABLED_LOC_ID, 0);
 
 }
 void say_renderer_push(say_renderer *renderer, say_drawable *drawable) {
+  if (renderer->batching && say_renderer_batch(renderer, drawable))
+    return;
+
+  say_renderer_flush(renderer);
+
   if (!drawable->shader &&
       renderer->using_texture != say_drawable_is_textured(drawable)) {
     renderer->using_texture = !(renderer->using_texture);
@@ -31,12 +156,47 @@ void say_renderer_push(say_renderer *renderer, say_drawable *drawable) {
   }
 
   say_drawable_draw(drawable, renderer->shader);
+  renderer->draw_calls++;
 }
 
 void say_renderer_push_buffer(say_renderer *renderer,
                               say_buffer_renderer *buf) {
+  say_renderer_flush(renderer);
   say_buffer_renderer_render(buf, renderer->shader);
+  renderer->draw_calls++;
 
   renderer->using_texture = 0;
   say_shader_set_int_id(renderer->shader, SAY_TEXTURE_ENABLED_LOC_ID, 0);
 }
+
+void say_renderer_flush(say_renderer *renderer) {
+  if (renderer->batch_size == 0)
+    return;
+
+  say_drawable_enable_blend_mode(renderer->batch_blend_mode);
+
+  if (!renderer->using_texture) {
+    renderer->using_texture = 1;
+    say_shader_set_int_id(renderer->shader, SAY_TEXTURE_ENABLED_LOC_ID, 1);
+  }
+
+  say_matrix_set(renderer->batch_matrix, 3, 2, renderer->batch_z);
+  say_shader_set_matrix_id(renderer->shader, SAY_MODEL_VIEW_LOC_ID,
+                           renderer->batch_matrix);
+
+  say_buffer_update_part(renderer->batch_buffer, 0, renderer->batch_size * 4);
+  say_buffer_bind(renderer->batch_buffer);
+  say_index_buffer_bind(renderer->batch_indices);
+
+  say_texture_bind(renderer->batch_texture, 0);
+  glDrawElements(GL_TRIANGLES, renderer->batch_size * 6, GL_UNSIGNED_INT,
+                 NULL);
+
+  renderer->batch_size = 0;
+  renderer->draw_calls++;
+}
+
+void say_renderer_flush_texture(say_renderer *renderer, GLuint texture) {
+  if (renderer->batch_size != 0 && renderer->batch_texture == texture)
+    say_renderer_flush(renderer);
+}
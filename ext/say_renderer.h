@@ -7,6 +7,20 @@
 typedef struct {
   say_shader *shader;
   uint8_t using_texture;
+
+  bool batching;
+
+  say_buffer       *batch_buffer;
+  say_index_buffer *batch_indices;
+  size_t            batch_capacity;
+  size_t            batch_size;
+
+  GLuint         batch_texture;
+  say_blend_mode batch_blend_mode;
+  float          batch_z;
+  say_matrix    *batch_matrix;
+
+  size_t draw_calls;
 } say_renderer;
 
 say_renderer *say_renderer_create();
@@ -14,9 +28,15 @@ void say_renderer_free(say_renderer *renderer);
 
 say_shader *say_renderer_get_shader(say_renderer *renderer);
 
+void say_renderer_set_batching(say_renderer *renderer, bool val);
+bool say_renderer_is_batching(say_renderer *renderer);
+
 void say_renderer_reset_states(say_renderer *renderer);
 void say_renderer_push(say_renderer *renderer, say_drawable *drawable);
 void say_renderer_push_buffer(say_renderer *renderer,
                               say_buffer_renderer *buf);
 
+void say_renderer_flush(say_renderer *renderer);
+void say_renderer_flush_texture(say_renderer *renderer, GLuint texture);
+
 #endif
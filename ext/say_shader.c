@@ -139,6 +139,12 @@ void say_shader_force_old() {
   say_shader_use_old_force = 1;
 }
 
+bool say_shader_uses_new_glsl() {
+  return say_shader_use_new &&
+    (!say_shader_use_old_force ||
+     say_context_get_config()->core_profile);
+}
+
 bool say_shader_is_geometry_available() {
   say_context_ensure();
   return GLEW_ARB_geometry_shader4 || GLEW_VERSION_3_2;
@@ -153,9 +159,7 @@ say_shader *say_shader_create() {
   shader->vertex_shader   = glCreateShader(GL_VERTEX_SHADER);
   shader->geometry_shader = 0;
 
-  bool new_shader = say_shader_use_new &&
-    (!say_shader_use_old_force ||
-     say_context_get_config()->core_profile);
+  bool new_shader = say_shader_uses_new_glsl();
 
   if (!new_shader) {
     say_shader_compile_frag(shader, say_default_frag_shader);
@@ -52,6 +52,7 @@ void say_shader_free(say_shader *shader);
 
 void say_shader_enable_new_glsl();
 void say_shader_force_old();
+bool say_shader_uses_new_glsl();
 
 bool say_shader_compile_frag(say_shader *shader, const char *src);
 bool say_shader_compile_vertex(say_shader *shader, const char *src);
@@ -3,13 +3,19 @@
 say_sound *say_sound_create() {
   say_sound *snd = malloc(sizeof(say_sound));
 
-  snd->src = say_audio_source_create();
+  snd->src = say_audio_source_create_pooled();
   snd->buf = NULL;
 
+  snd->looping = false;
+  snd->offset  = 0;
+
+  snd->priority = 0;
+
   return snd;
 }
 
 void say_sound_free(say_sound *snd) {
+  say_mixer_release(snd);
   say_audio_source_free(snd->src);
   free(snd);
 }
@@ -18,7 +24,6 @@ void say_sound_set_buffer(say_sound *snd, say_sound_buffer *buf) {
   say_sound_stop(snd);
 
   snd->buf = buf;
-  alSourcei(snd->src->src, AL_BUFFER, buf ? buf->buf : 0);
 }
 
 say_sound_buffer *say_sound_get_buffer(say_sound *snd) {
@@ -26,21 +31,27 @@ say_sound_buffer *say_sound_get_buffer(say_sound *snd) {
 }
 
 void say_sound_set_looping(say_sound *snd, uint8_t val) {
-  alSourcei(snd->src->src, AL_LOOPING, val);
+  snd->looping = val;
+
+  if (snd->src->src)
+    alSourcei(snd->src->src, AL_LOOPING, val);
 }
 
 uint8_t say_sound_is_looping(say_sound *snd) {
-  ALint looping;
-  alGetSourcei(snd->src->src, AL_LOOPING, &looping);
-
-  return looping;
+  return snd->looping;
 }
 
 void say_sound_seek(say_sound *snd, float time) {
-  alSourcef(snd->src->src, AL_SEC_OFFSET, time);
+  if (snd->src->src)
+    alSourcef(snd->src->src, AL_SEC_OFFSET, time);
+  else
+    snd->offset = time;
 }
 
 float say_sound_get_time(say_sound *snd) {
+  if (!snd->src->src)
+    return snd->offset;
+
   float time;
   alGetSourcef(snd->src->src, AL_SEC_OFFSET, &time);
 
@@ -55,13 +66,38 @@ float say_sound_get_duration(say_sound *snd) {
 }
 
 void say_sound_play(say_sound *snd) {
+  if (!snd->src->src) {
+    /* Too many more important sounds are playing */
+    if (!say_mixer_acquire(snd))
+      return;
+
+    if (snd->offset != 0) {
+      alSourcef(snd->src->src, AL_SEC_OFFSET, snd->offset);
+      snd->offset = 0;
+    }
+  }
+
   alSourcePlay(snd->src->src);
 }
 
 void say_sound_pause(say_sound *snd) {
-  alSourcePause(snd->src->src);
+  if (snd->src->src)
+    alSourcePause(snd->src->src);
 }
 
 void say_sound_stop(say_sound *snd) {
-  alSourceStop(snd->src->src);
+  say_mixer_release(snd);
+  snd->offset = 0;
+}
+
+void say_sound_set_priority(say_sound *snd, int priority) {
+  snd->priority = priority;
+}
+
+int say_sound_get_priority(say_sound *snd) {
+  return snd->priority;
+}
+
+bool say_sound_has_voice(say_sound *snd) {
+  return snd->src->src != 0;
 }
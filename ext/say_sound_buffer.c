@@ -1,57 +1,259 @@
 #include "say.h"
 
+#include <sys/stat.h>
+
+/*
+ * Shared OpenAL buffers, indexed by the contents of the file they were decoded
+ * from.
+ */
+typedef struct {
+  ALuint buf;
+  size_t ref_count;
+
+  size_t channel_count;
+  size_t sample_rate;
+  size_t sample_count;
+
+  float duration;
+} say_sound_cache_entry;
+
+static mo_hash *say_sound_cache = NULL;
+
+/*
+ * Incremented whenever the cache is destroyed, so that buffers that were
+ * using an entry of a previous cache don't look it up in a new one.
+ */
+static size_t say_sound_cache_generation = 0;
+
+static int say_sound_key_hash_of(void *ptr) {
+  say_sound_key *key = ptr;
+  return (int)(key->hash ^ (key->hash >> 32));
+}
+
+static int say_sound_key_cmp(const void *a, const void *b) {
+  const say_sound_key *first = a, *sec = b;
+
+  if (first->hash != sec->hash)
+    return first->hash > sec->hash ? +1 : -1;
+  else if (first->size != sec->size)
+    return first->size > sec->size ? +1 : -1;
+  else
+    return 0;
+}
+
+static mo_hash *say_sound_get_cache() {
+  if (!say_sound_cache) {
+    say_sound_cache = mo_hash_create(sizeof(say_sound_key),
+                                     sizeof(say_sound_cache_entry));
+    say_sound_cache->hash_of = say_sound_key_hash_of;
+    say_sound_cache->key_cmp = say_sound_key_cmp;
+  }
+
+  return say_sound_cache;
+}
+
+/* FNV-1a */
+static uint64_t say_sound_hash(uint64_t hash, const uint8_t *data,
+                               size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    hash ^= data[i];
+    hash *= 1099511628211ULL;
+  }
+
+  return hash;
+}
+
+/* Conversion settings are part of the key, as they change the samples */
+static say_sound_key say_sound_key_of(say_sound_buffer *buf,
+                                      const uint8_t *data, size_t size) {
+  uint64_t hash = say_sound_hash(14695981039346656037ULL, data, size);
+
+  hash = say_sound_hash(hash, (const uint8_t*)&buf->target_channels,
+                        sizeof(buf->target_channels));
+  hash = say_sound_hash(hash, (const uint8_t*)&buf->resample,
+                        sizeof(buf->resample));
+  hash = say_sound_hash(hash, (const uint8_t*)&buf->gain, sizeof(buf->gain));
+
+  say_sound_key key = {hash, size};
+  return key;
+}
+
+static say_sound_cache_entry *say_sound_buffer_get_entry(say_sound_buffer *buf) {
+  if (!buf->cached || !say_sound_cache ||
+      buf->cache_generation != say_sound_cache_generation)
+    return NULL;
+
+  return mo_hash_get_ptr(say_sound_cache, &buf->key, say_sound_cache_entry);
+}
+
+static void say_sound_buffer_release_data(say_sound_buffer *buf) {
+  if (buf->samples) {
+    free(buf->samples);
+    buf->samples = NULL;
+  }
+
+  /* The entry is gone if the cache was cleaned up since it was loaded */
+  say_sound_cache_entry *entry = say_sound_buffer_get_entry(buf);
+  if (entry && --entry->ref_count == 0) {
+    alDeleteBuffers(1, &entry->buf);
+    mo_hash_del(say_sound_cache, &buf->key);
+  }
+
+  buf->cached = false;
+
+  buf->buf          = 0;
+  buf->sample_count = 0;
+}
+
 say_sound_buffer *say_sound_buffer_create() {
   say_sound_buffer *buf = malloc(sizeof(say_sound_buffer));
 
   say_audio_context_ensure();
-  alGenBuffers(1, &buf->buf);
+
+  buf->buf = 0;
 
   buf->samples      = NULL;
   buf->sample_count = 0;
 
+  buf->channel_count = 0;
+  buf->sample_rate   = 0;
+
   buf->duration = 0;
 
+  buf->keep_samples = true;
+  buf->cached       = false;
+
+  buf->cache_generation = 0;
+
+  buf->target_channels = 0;
+  buf->resample        = false;
+  buf->gain            = 1;
+
   return buf;
 }
 
 void say_sound_buffer_free(say_sound_buffer *buf) {
-  if (buf->samples)
-    free(buf->samples);
+  say_sound_buffer_release_data(buf);
+  free(buf);
+}
 
-  alDeleteBuffers(1, &buf->buf);
+static void say_sound_buffer_use_entry(say_sound_buffer *buf,
+                                       say_sound_key key,
+                                       say_sound_cache_entry *entry) {
+  entry->ref_count++;
 
-  free(buf);
+  buf->buf    = entry->buf;
+  buf->cached = true;
+  buf->key    = key;
+
+  buf->cache_generation = say_sound_cache_generation;
+
+  buf->channel_count = entry->channel_count;
+  buf->sample_rate   = entry->sample_rate;
+  buf->sample_count  = entry->sample_count;
+
+  buf->duration = entry->duration;
 }
 
-static int say_sound_buffer_load(say_sound_buffer *buf, SF_INFO info, SNDFILE *file) {
-  if (!file) {
-    say_error_set(sf_strerror(file));
-    return 0;
-  }
+/* Identical files are only decoded once, unless samples must be kept */
+static bool say_sound_buffer_use_cache(say_sound_buffer *buf,
+                                       say_sound_key key) {
+  if (buf->keep_samples)
+    return false;
 
-  buf->sample_count = info.frames * info.channels;
-  buf->samples = realloc(buf->samples, sizeof(short) * buf->sample_count);
+  say_sound_cache_entry *entry = mo_hash_get_ptr(say_sound_get_cache(), &key,
+                                                 say_sound_cache_entry);
+  if (!entry)
+    return false;
 
-  sf_read_short(file, buf->samples, buf->sample_count);
+  say_sound_buffer_use_entry(buf, key, entry);
+  return true;
+}
 
-  sf_close(file);
+static int say_sound_buffer_load(say_sound_buffer *buf, say_sound_key key,
+                                 SNDFILE *file, SF_INFO info) {
+  size_t channels = buf->target_channels ? buf->target_channels :
+    (size_t)info.channels;
+
+  ALenum fmt = say_audio_get_format(channels);
+  if (!fmt && channels > 2) {
+    /* Mix down layouts the implementation can't play */
+    channels = 2;
+    fmt = say_audio_get_format(channels);
+  }
 
-  ALenum fmt = say_audio_get_format(info.channels);
   if (!fmt) {
+    sf_close(file);
     say_error_set("unsupported amount of channels");
     return 0;
   }
 
-  alBufferData(buf->buf, fmt, buf->samples, buf->sample_count * sizeof(short),
-               info.samplerate);
+  size_t rate = buf->resample ? say_audio_get_device_rate() :
+    (size_t)info.samplerate;
+
+  size_t sample_count = info.frames * info.channels;
+  short *samples = malloc(sizeof(short) * sample_count);
+
+  sf_count_t frames = sf_readf_short(file, samples, info.frames);
+  sf_close(file);
 
-  buf->duration = (float)buf->sample_count / info.samplerate / info.channels;
+  sample_count = frames * info.channels;
+
+  say_audio_converter conv;
+  say_audio_converter_init(&conv, info.channels, info.samplerate,
+                           channels, rate, buf->gain);
+
+  if (!say_audio_converter_is_identity(&conv)) {
+    short *converted = malloc(sizeof(short) * channels *
+                              say_audio_converter_get_max_output(&conv, frames));
+
+    sample_count = channels * say_audio_converter_run(&conv, samples, frames,
+                                                      converted);
+
+    free(samples);
+    samples = converted;
+  }
+
+  say_audio_converter_release(&conv);
+
+  say_sound_cache_entry *entry = mo_hash_get_ptr(say_sound_get_cache(), &key,
+                                                 say_sound_cache_entry);
+  if (!entry) {
+    say_sound_cache_entry new_entry;
+
+    alGenBuffers(1, &new_entry.buf);
+    alBufferData(new_entry.buf, fmt, samples, sample_count * sizeof(short),
+                 rate);
+
+    new_entry.ref_count     = 0;
+    new_entry.channel_count = channels;
+    new_entry.sample_rate   = rate;
+    new_entry.sample_count  = sample_count;
+    new_entry.duration      = (float)info.frames / info.samplerate;
+
+    mo_hash_set(say_sound_cache, &key, &new_entry);
+    entry = mo_hash_get_ptr(say_sound_cache, &key, say_sound_cache_entry);
+  }
+
+  say_sound_buffer_use_entry(buf, key, entry);
+
+  /* OpenAL keeps its own copy of the samples */
+  if (buf->keep_samples)
+    buf->samples = samples;
+  else
+    free(samples);
 
   return 1;
 }
 
 int say_sound_buffer_load_from_memory(say_sound_buffer *buf, size_t len,
                                       const char *str) {
+  say_sound_buffer_release_data(buf);
+
+  say_sound_key key = say_sound_key_of(buf, (const uint8_t*)str, len);
+  if (say_sound_buffer_use_cache(buf, key))
+    return 1;
+
   SF_INFO info;
   say_vfile vfile = say_make_vfile((void*)str, len);
 
@@ -59,14 +261,94 @@ int say_sound_buffer_load_from_memory(say_sound_buffer *buf, size_t len,
   say_setup_vio(vio);
 
   SNDFILE *file = sf_open_virtual(&vio, SFM_READ, &info, &vfile);
+  if (!file) {
+    say_error_set(sf_strerror(file));
+    return 0;
+  }
 
-  return say_sound_buffer_load(buf, info, file);
+  return say_sound_buffer_load(buf, key, file, info);
 }
 
+/*
+ * Files are identified by their path, size and modification time rather than
+ * by their contents, so that they don't need to be read twice.
+ */
 int say_sound_buffer_load_from_file(say_sound_buffer *buf, const char *filename) {
+  say_sound_buffer_release_data(buf);
+
+  struct stat st;
+  if (stat(filename, &st) != 0) {
+    say_error_set("could not open file");
+    return 0;
+  }
+
+  uint64_t mtime = (uint64_t)st.st_mtime;
+
+  say_sound_key key = say_sound_key_of(buf, (const uint8_t*)filename,
+                                       strlen(filename));
+  key.hash = say_sound_hash(key.hash, (const uint8_t*)&mtime, sizeof(mtime));
+  key.size = st.st_size;
+
+  if (say_sound_buffer_use_cache(buf, key))
+    return 1;
+
+  SF_INFO info;
+  SNDFILE *file = sf_open(filename, SFM_READ, &info);
+  if (!file) {
+    say_error_set(sf_strerror(file));
+    return 0;
+  }
+
+  return say_sound_buffer_load(buf, key, file, info);
+}
+
+void say_sound_buffer_set_keep_samples(say_sound_buffer *buf, bool val) {
+  buf->keep_samples = val;
+
+  if (!val && buf->samples) {
+    free(buf->samples);
+    buf->samples = NULL;
+  }
+}
+
+void say_sound_buffer_set_conversion(say_sound_buffer *buf, size_t channels,
+                                     bool resample, float gain) {
+  buf->target_channels = channels > 2 ? 2 : channels;
+  buf->resample        = resample;
+  buf->gain            = gain;
+}
+
+bool say_sound_buffer_keeps_samples(say_sound_buffer *buf) {
+  return buf->keep_samples;
+}
+
+bool say_sound_buffer_is_shared(say_sound_buffer *buf) {
+  say_sound_cache_entry *entry = say_sound_buffer_get_entry(buf);
+  return entry && entry->ref_count > 1;
+}
+
+size_t say_sound_buffer_get_cache_size() {
+  return say_sound_cache ? say_sound_cache->size : 0;
+}
+
+void say_sound_buffer_clean_up() {
+  if (say_sound_cache) {
+    mo_hash_free(say_sound_cache);
+    say_sound_cache = NULL;
+    say_sound_cache_generation++;
+  }
+}
+
+float say_sound_file_get_duration(const char *filename) {
   SF_INFO info;
   SNDFILE *file = sf_open(filename, SFM_READ, &info);
-  return say_sound_buffer_load(buf, info, file);
+  if (!file) {
+    say_error_set(sf_strerror(file));
+    return -1;
+  }
+
+  sf_close(file);
+  return (float)info.frames / info.samplerate;
 }
 
 short *say_sound_buffer_get_samples(say_sound_buffer *buf) {
@@ -78,17 +360,11 @@ size_t say_sound_buffer_get_sample_count(say_sound_buffer *buf) {
 }
 
 size_t say_sound_buffer_get_channel_count(say_sound_buffer *buf) {
-  ALint channel_count;
-  alGetBufferi(buf->buf, AL_CHANNELS, &channel_count);
-
-  return channel_count;
+  return buf->channel_count;
 }
 
 size_t say_sound_buffer_get_sample_rate(say_sound_buffer *buf) {
-  ALint sample_rate;
-  alGetBufferi(buf->buf, AL_FREQUENCY, &sample_rate);
-
-  return sample_rate;
+  return buf->sample_rate;
 }
 
 float say_sound_buffer_get_duration(say_sound_buffer *buf) {
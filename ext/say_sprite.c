@@ -39,6 +39,8 @@ static void say_sprite_fill_vertices(void *data, void *vertices_ptr) {
   if (!sprite->image)
     return;
 
+  sprite->tex_version = say_image_get_tex_version(sprite->image);
+
   for (size_t i = 0; i < say_drawable_get_vertex_count(sprite->drawable); i++)
     vertices[i].col = sprite->color;
 
@@ -81,6 +83,29 @@ static void say_sprite_draw(void *data, size_t first, size_t index) {
   glDrawArrays(GL_TRIANGLE_FAN, first, 4);
 }
 
+say_image *say_sprite_batch_quad(void *data, size_t *first) {
+  say_sprite *sprite = (say_sprite*)data;
+
+  if (!sprite->image)
+    return NULL;
+
+  if (sprite->is_sheet)
+    *first = 4 * ((sprite->sheet_y * sprite->sheet_w) + sprite->sheet_x);
+  else
+    *first = 0;
+
+  /* Sprites whose image was packed into an atlas are batched by page */
+  return say_image_get_texture_image(sprite->image);
+}
+
+static bool say_sprite_has_changed(void *data) {
+  say_sprite *sprite = (say_sprite*)data;
+
+  /* Texture coordinates change when the image is moved to or in an atlas */
+  return sprite->image &&
+    say_image_get_tex_version(sprite->image) != sprite->tex_version;
+}
+
 say_sprite *say_sprite_create() {
   say_sprite *sprite = malloc(sizeof(say_sprite));
 
@@ -90,8 +115,11 @@ say_sprite *say_sprite_create() {
   say_drawable_set_textured(sprite->drawable, 1);
   say_drawable_set_fill_proc(sprite->drawable, say_sprite_fill_vertices);
   say_drawable_set_render_proc(sprite->drawable, say_sprite_draw);
+  say_drawable_set_batch_proc(sprite->drawable, say_sprite_batch_quad);
+  say_drawable_set_changed_proc(sprite->drawable, say_sprite_has_changed);
 
-  sprite->image = NULL;
+  sprite->image       = NULL;
+  sprite->tex_version = 0;
 
   sprite->color = say_make_color(255, 255, 255, 255);
 
@@ -7,6 +7,7 @@
 typedef struct {
   say_drawable *drawable;
   say_image *image;
+  size_t tex_version;
 
   say_color color;
   say_rect  rect;
@@ -23,6 +24,8 @@ void say_sprite_free(say_sprite *sprite);
 
 void say_sprite_copy(say_sprite *sprite, say_sprite *orig);
 
+say_image *say_sprite_batch_quad(void *data, size_t *first);
+
 say_image *say_sprite_get_image(say_sprite *sprite);
 void say_sprite_set_image(say_sprite *sprite, say_image *img);
 
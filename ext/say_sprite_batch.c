@@ -0,0 +1,284 @@
+#include "say.h"
+
+static size_t      say_sprite_batch_vtype  = 0;
+static say_shader *say_sprite_batch_shader = NULL;
+
+#define SAY_TEXTURE_SIZE_ATTR   "in_TextureSize"
+#define SAY_TEXTURE_OFFSET_ATTR "in_TextureOffset"
+
+static const char *say_sprite_batch_vertex_shader =
+  "#version 110\n"
+  "\n"
+  "attribute vec2  in_Corner;\n"
+  "attribute vec2  in_Position;\n"
+  "attribute vec2  in_Scale;\n"
+  "attribute vec2  in_Origin;\n"
+  "attribute float in_Angle;\n"
+  "attribute vec4  in_Color;\n"
+  "attribute vec2  in_RectPos;\n"
+  "attribute vec2  in_RectSize;\n"
+  "\n"
+  "uniform mat4 in_ModelView;\n"
+  "uniform mat4 in_Projection;\n"
+  "uniform vec2 in_TextureSize;\n"
+  "uniform vec2 in_TextureOffset;\n"
+  "\n"
+  "varying vec4 var_Color;\n"
+  "varying vec2 var_TexCoord;\n"
+  "\n"
+  "void main() {\n"
+  "  vec2  local = (in_Corner * in_RectSize - in_Origin) * in_Scale;\n"
+  "  float c     = cos(-radians(in_Angle));\n"
+  "  float s     = sin(-radians(in_Angle));\n"
+  "  vec2  pos   = vec2(c * local.x + s * local.y,\n"
+  "                     c * local.y - s * local.x) + in_Position;\n"
+  "\n"
+  "  vec2 tex = in_TextureOffset + in_RectPos + in_Corner * in_RectSize;\n"
+  "\n"
+  "  gl_Position  = vec4(pos, 0, 1) * (in_ModelView * in_Projection);\n"
+  "  var_Color    = in_Color;\n"
+  "  var_TexCoord = tex / in_TextureSize;\n"
+  "}\n";
+
+static const char *say_sprite_batch_new_vertex_shader =
+  "#version 130\n"
+  "\n"
+  "in vec2  in_Corner;\n"
+  "in vec2  in_Position;\n"
+  "in vec2  in_Scale;\n"
+  "in vec2  in_Origin;\n"
+  "in float in_Angle;\n"
+  "in vec4  in_Color;\n"
+  "in vec2  in_RectPos;\n"
+  "in vec2  in_RectSize;\n"
+  "\n"
+  "uniform mat4 in_ModelView;\n"
+  "uniform mat4 in_Projection;\n"
+  "uniform vec2 in_TextureSize;\n"
+  "uniform vec2 in_TextureOffset;\n"
+  "\n"
+  "out vec4 var_Color;\n"
+  "out vec2 var_TexCoord;\n"
+  "\n"
+  "void main() {\n"
+  "  vec2  local = (in_Corner * in_RectSize - in_Origin) * in_Scale;\n"
+  "  float c     = cos(-radians(in_Angle));\n"
+  "  float s     = sin(-radians(in_Angle));\n"
+  "  vec2  pos   = vec2(c * local.x + s * local.y,\n"
+  "                     c * local.y - s * local.x) + in_Position;\n"
+  "\n"
+  "  vec2 tex = in_TextureOffset + in_RectPos + in_Corner * in_RectSize;\n"
+  "\n"
+  "  gl_Position  = vec4(pos, 0, 1) * (in_ModelView * in_Projection);\n"
+  "  var_Color    = in_Color;\n"
+  "  var_TexCoord = tex / in_TextureSize;\n"
+  "}\n";
+
+static void say_sprite_batch_push_elem(say_vertex_type *type,
+                                       say_vertex_elem_type elem_type,
+                                       const char *name, bool per_instance) {
+  say_vertex_elem el;
+  el.type         = elem_type;
+  el.name         = say_strdup(name);
+  el.per_instance = per_instance;
+
+  say_vertex_type_push(type, el);
+}
+
+static size_t say_sprite_batch_get_vtype() {
+  if (say_sprite_batch_vtype == 0) {
+    say_sprite_batch_vtype = say_vertex_type_make_new();
+    say_vertex_type *type  = say_get_vertex_type(say_sprite_batch_vtype);
+
+    say_sprite_batch_push_elem(type, SAY_VECTOR2, "in_Corner",   false);
+    say_sprite_batch_push_elem(type, SAY_VECTOR2, "in_Position", true);
+    say_sprite_batch_push_elem(type, SAY_VECTOR2, "in_Scale",    true);
+    say_sprite_batch_push_elem(type, SAY_VECTOR2, "in_Origin",   true);
+    say_sprite_batch_push_elem(type, SAY_FLOAT,   "in_Angle",    true);
+    say_sprite_batch_push_elem(type, SAY_COLOR,   "in_Color",    true);
+    say_sprite_batch_push_elem(type, SAY_VECTOR2, "in_RectPos",  true);
+    say_sprite_batch_push_elem(type, SAY_VECTOR2, "in_RectSize", true);
+  }
+
+  return say_sprite_batch_vtype;
+}
+
+static say_shader *say_sprite_batch_get_shader() {
+  if (!say_sprite_batch_shader) {
+    say_shader *shader = say_shader_create();
+
+    say_shader_compile_vertex(shader,
+                              say_shader_uses_new_glsl() ?
+                              say_sprite_batch_new_vertex_shader :
+                              say_sprite_batch_vertex_shader);
+    say_shader_apply_vertex_type(shader, say_sprite_batch_get_vtype());
+    say_shader_link(shader);
+
+    say_sprite_batch_shader = shader;
+  }
+
+  return say_sprite_batch_shader;
+}
+
+static void say_sprite_batch_upload(say_sprite_batch *batch) {
+  if (batch->dirty_from >= batch->dirty_to)
+    return;
+
+  say_buffer_update_instance_part(batch->buffer, batch->dirty_from,
+                                  batch->dirty_to - batch->dirty_from);
+
+  batch->dirty_from = SIZE_MAX;
+  batch->dirty_to   = 0;
+}
+
+static void say_sprite_batch_mark_dirty(say_sprite_batch *batch, size_t id) {
+  if (id < batch->dirty_from) batch->dirty_from = id;
+  if (id + 1 > batch->dirty_to) batch->dirty_to = id + 1;
+}
+
+static void say_sprite_batch_render(void *data, size_t first, size_t index) {
+  say_sprite_batch *batch = (say_sprite_batch*)data;
+
+  if (!batch->image || batch->count == 0)
+    return;
+
+  say_sprite_batch_upload(batch);
+
+  /* Images packed into an atlas are drawn from their page */
+  say_image *texture = say_image_get_texture_image(batch->image);
+
+  say_shader *shader = say_sprite_batch_get_shader();
+  say_shader_set_vector2_loc(shader,
+                             say_shader_locate(shader, SAY_TEXTURE_SIZE_ATTR),
+                             say_image_get_size(texture));
+  say_shader_set_vector2_loc(shader,
+                             say_shader_locate(shader, SAY_TEXTURE_OFFSET_ATTR),
+                             say_image_get_atlas_pos(batch->image));
+
+  say_buffer_bind(batch->buffer);
+  say_image_bind(batch->image);
+
+  glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, 4, batch->count);
+}
+
+bool say_sprite_batch_is_available() {
+  say_context_ensure();
+  return (GLEW_ARB_draw_instanced && GLEW_ARB_instanced_arrays) ||
+    GLEW_VERSION_3_3;
+}
+
+say_sprite_batch *say_sprite_batch_create() {
+  say_sprite_batch *batch = malloc(sizeof(say_sprite_batch));
+
+  size_t vtype = say_sprite_batch_get_vtype();
+
+  /*
+   * No vertices go through the global buffers: the batch uses its own buffer,
+   * with a single quad and as many instances as there are sprites.
+   */
+  batch->drawable = say_drawable_create(vtype);
+  say_drawable_set_custom_data(batch->drawable, batch);
+  say_drawable_set_textured(batch->drawable, 1);
+  say_drawable_set_render_proc(batch->drawable, say_sprite_batch_render);
+  say_drawable_set_shader(batch->drawable, say_sprite_batch_get_shader());
+
+  batch->buffer = say_buffer_create(vtype, SAY_DYNAMIC, 4);
+
+  say_vector2 *corners = say_buffer_get_vertex(batch->buffer, 0);
+  corners[0] = say_make_vector2(0, 0);
+  corners[1] = say_make_vector2(1, 0);
+  corners[2] = say_make_vector2(1, 1);
+  corners[3] = say_make_vector2(0, 1);
+  say_buffer_update(batch->buffer);
+
+  say_buffer_resize_instance(batch->buffer, 64);
+
+  batch->image = NULL;
+  batch->count = 0;
+
+  batch->dirty_from = SIZE_MAX;
+  batch->dirty_to   = 0;
+
+  return batch;
+}
+
+void say_sprite_batch_copy(say_sprite_batch *batch, say_sprite_batch *orig) {
+  say_drawable_copy(batch->drawable, orig->drawable);
+
+  batch->image = orig->image;
+  batch->count = orig->count;
+
+  size_t capa = say_buffer_get_instance_size(orig->buffer);
+  if (say_buffer_get_instance_size(batch->buffer) < capa)
+    say_buffer_resize_instance(batch->buffer, capa);
+
+  memcpy(say_buffer_get_instance(batch->buffer, 0),
+         say_buffer_get_instance(orig->buffer, 0),
+         orig->count * sizeof(say_sprite_batch_instance));
+
+  batch->dirty_from = 0;
+  batch->dirty_to   = batch->count;
+}
+
+void say_sprite_batch_free(say_sprite_batch *batch) {
+  say_drawable_free(batch->drawable);
+  say_buffer_free(batch->buffer);
+  free(batch);
+}
+
+say_image *say_sprite_batch_get_image(say_sprite_batch *batch) {
+  return batch->image;
+}
+
+void say_sprite_batch_set_image(say_sprite_batch *batch, say_image *img) {
+  batch->image = img;
+}
+
+size_t say_sprite_batch_get_size(say_sprite_batch *batch) {
+  return batch->count;
+}
+
+void say_sprite_batch_clear(say_sprite_batch *batch) {
+  batch->count = 0;
+
+  batch->dirty_from = SIZE_MAX;
+  batch->dirty_to   = 0;
+}
+
+size_t say_sprite_batch_add(say_sprite_batch *batch,
+                            say_sprite_batch_instance *sprite) {
+  size_t capa = say_buffer_get_instance_size(batch->buffer);
+
+  if (batch->count == capa) {
+    /* Resizing uploads every instance anyway */
+    say_buffer_resize_instance(batch->buffer, capa * 2);
+
+    batch->dirty_from = SIZE_MAX;
+    batch->dirty_to   = 0;
+  }
+
+  size_t id = batch->count++;
+  say_sprite_batch_set(batch, id, sprite);
+
+  return id;
+}
+
+void say_sprite_batch_set(say_sprite_batch *batch, size_t id,
+                          say_sprite_batch_instance *sprite) {
+  memcpy(say_buffer_get_instance(batch->buffer, id), sprite,
+         sizeof(say_sprite_batch_instance));
+  say_sprite_batch_mark_dirty(batch, id);
+}
+
+say_sprite_batch_instance *say_sprite_batch_get(say_sprite_batch *batch,
+                                                size_t id) {
+  return say_buffer_get_instance(batch->buffer, id);
+}
+
+void say_sprite_batch_clean_up() {
+  if (say_sprite_batch_shader)
+    say_shader_free(say_sprite_batch_shader);
+
+  say_sprite_batch_shader = NULL;
+  say_sprite_batch_vtype  = 0;
+}
@@ -0,0 +1,50 @@
+#ifndef SAY_SPRITE_BATCH_H_
+#define SAY_SPRITE_BATCH_H_
+
+#include "say_drawable.h"
+#include "say_buffer.h"
+#include "say_image.h"
+
+/* Per-instance attributes, in the same order as in the vertex type */
+typedef struct {
+  say_vector2 pos;
+  say_vector2 scale;
+  say_vector2 origin;
+  float       angle;
+  say_color   color;
+  say_vector2 rect_pos;
+  say_vector2 rect_size;
+} __attribute__((packed)) say_sprite_batch_instance;
+
+typedef struct {
+  say_drawable *drawable;
+  say_buffer   *buffer;
+  say_image    *image;
+
+  size_t count;
+  size_t dirty_from, dirty_to;
+} say_sprite_batch;
+
+bool say_sprite_batch_is_available();
+
+say_sprite_batch *say_sprite_batch_create();
+void say_sprite_batch_free(say_sprite_batch *batch);
+
+void say_sprite_batch_copy(say_sprite_batch *batch, say_sprite_batch *orig);
+
+say_image *say_sprite_batch_get_image(say_sprite_batch *batch);
+void say_sprite_batch_set_image(say_sprite_batch *batch, say_image *img);
+
+size_t say_sprite_batch_get_size(say_sprite_batch *batch);
+void say_sprite_batch_clear(say_sprite_batch *batch);
+
+size_t say_sprite_batch_add(say_sprite_batch *batch,
+                            say_sprite_batch_instance *sprite);
+void say_sprite_batch_set(say_sprite_batch *batch, size_t id,
+                          say_sprite_batch_instance *sprite);
+say_sprite_batch_instance *say_sprite_batch_get(say_sprite_batch *batch,
+                                                size_t id);
+
+void say_sprite_batch_clean_up();
+
+#endif
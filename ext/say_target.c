@@ -1,5 +1,15 @@
 #include "say.h"
 
+static void say_target_flush_pending(say_target *target) {
+  say_render_queue_flush(target->queue, target->renderer);
+  say_renderer_flush(target->renderer);
+}
+
+static bool say_target_has_pending(say_target *target) {
+  return !say_render_queue_is_empty(target->queue) ||
+    target->renderer->batch_size != 0;
+}
+
 static void say_target_update_states(say_target *target) {
   if (target->up_to_date) {
     target->up_to_date = 0;
@@ -8,8 +18,10 @@ static void say_target_update_states(say_target *target) {
 
   if (!target->view_up_to_date ||
       say_view_has_changed(target->view)) {
+    /* Queued drawables were meant for the previous projection */
+    say_target_flush_pending(target);
     say_view_apply(target->view, target->renderer->shader,
-                   target->size);
+                   target->size, target->flip_y);
     target->view_up_to_date = 1;
   }
 }
@@ -22,7 +34,10 @@ say_target *say_target_create() {
 
   target->context  = say_thread_variable_create();
   target->renderer = say_renderer_create();
+  target->queue    = say_render_queue_create();
+  target->queueing = false;
   target->view     = say_view_create();
+  target->flip_y   = false;
 
   target->up_to_date         = 1;
   target->view_up_to_date    = 1;
@@ -35,8 +50,16 @@ say_target *say_target_create() {
 }
 
 void say_target_free(say_target *target) {
+  mo_array *contexts = say_context_get_all();
+  for (size_t i = 0; i < contexts->size; i++) {
+    say_context *context = mo_array_get_as(contexts, i, say_context*);
+    if (context->target == target)
+      context->target = NULL;
+  }
+
   say_view_free(target->view);
   say_renderer_free(target->renderer);
+  say_render_queue_free(target->queue);
 
   say_thread_variable_free(target->context);
 
@@ -108,6 +131,13 @@ int say_target_make_current(say_target *target) {
       return 1;
     }
 
+    /*
+     * Drawables still waiting in the previous target's batch or queue must be
+     * drawn before its framebuffer gets unbound.
+     */
+    if (current && current->target)
+      say_target_flush_pending(current->target);
+
     target->view_up_to_date = 0;
 
     say_context_make_current(context);
@@ -152,6 +182,18 @@ say_shader *say_target_get_shader(say_target *target) {
   return say_renderer_get_shader(target->renderer);
 }
 
+say_matrix *say_target_get_projection(say_target *target) {
+  if (target->flip_y)
+    return say_view_get_flipped_matrix(target->view);
+  else
+    return say_view_get_matrix(target->view);
+}
+
+void say_target_set_flip_y(say_target *target, bool val) {
+  target->flip_y = val;
+  target->view_up_to_date = 0;
+}
+
 say_rect say_target_get_clip(say_target *target) {
   say_rect viewport = say_view_get_viewport(target->view);
   viewport.x *= target->size.x;
@@ -175,6 +217,8 @@ void say_target_clear(say_target *target, say_color color) {
   if (!say_target_make_current(target))
     return;
 
+  say_target_flush_pending(target);
+
   glClearColor(color.r / 255.0f, color.g / 255.0f, color.b / 255.0f,
                color.a / 255.0f);
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -187,11 +231,15 @@ void say_target_draw(say_target *target, say_drawable *drawable) {
   if (drawable->shader) {
     say_shader_set_matrix_id(drawable->shader,
                              SAY_PROJECTION_LOC_ID,
-                             say_view_get_matrix(target->view));
+                             say_target_get_projection(target));
   }
 
   say_target_update_states(target);
-  say_renderer_push(target->renderer, drawable);
+
+  if (target->queueing)
+    say_render_queue_push(target->queue, drawable);
+  else
+    say_renderer_push(target->renderer, drawable);
 }
 
 void say_target_draw_buffer(say_target *target,
@@ -199,9 +247,10 @@ void say_target_draw_buffer(say_target *target,
   if (!say_target_make_current(target))
     return;
 
-  buf->matrix = say_view_get_matrix(target->view);
+  buf->matrix = say_target_get_projection(target);
 
   say_target_update_states(target);
+  say_target_flush_pending(target);
   say_renderer_push_buffer(target->renderer, buf);
 }
 
@@ -209,11 +258,14 @@ say_color say_target_get(say_target *target, size_t x, size_t y) {
   if (!say_target_make_current(target))
     return say_make_color(0, 0, 0, 0);
 
+  say_target_flush_pending(target);
+
   say_pixel_bus_unbind_pack();
 
+  GLint row = target->flip_y ? (GLint)y : (GLint)target->size.y - (GLint)y - 1;
+
   say_color col;
-  glReadPixels(x, (GLint)target->size.y - (GLint)y - 1, 1, 1, GL_RGBA,
-               GL_UNSIGNED_BYTE, &col);
+  glReadPixels(x, row, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, &col);
 
   return col;
 }
@@ -223,15 +275,28 @@ say_image *say_target_get_rect(say_target *target, size_t x, size_t y,
   if (!say_target_make_current(target))
     return NULL;
 
+  say_target_flush_pending(target);
+
   say_image *image = say_image_create();
   if (!say_image_create_with_size(image, w, h)) {
     say_image_free(image);
     return NULL;
   }
 
+  say_color *buf = say_image_get_buffer(image);
+
   say_pixel_bus_unbind_pack();
-  glReadPixels(x, (GLint)target->size.y - (GLint)y - (GLint)h, w, h, GL_RGBA,
-               GL_UNSIGNED_BYTE, say_image_get_buffer(image));
+
+  if (target->flip_y)
+    glReadPixels(x, y, w, h, GL_RGBA, GL_UNSIGNED_BYTE, buf);
+  else {
+    /* The window's rows are stored bottom-up, unlike images */
+    glReadPixels(x, (GLint)target->size.y - (GLint)y - (GLint)h, w, h, GL_RGBA,
+                 GL_UNSIGNED_BYTE, buf);
+    say_flip_color_buffer(buf, w, h);
+  }
+
+  say_image_mark_texture_out_of_date(image);
 
   return image;
 }
@@ -240,7 +305,48 @@ say_image *say_target_to_image(say_target *target) {
   return say_target_get_rect(target, 0, 0, target->size.x, target->size.y);
 }
 
+void say_target_set_batching(say_target *target, bool val) {
+  if (!val)
+    say_target_flush(target);
+
+  say_renderer_set_batching(target->renderer, val);
+}
+
+bool say_target_is_batching(say_target *target) {
+  return say_renderer_is_batching(target->renderer);
+}
+
+void say_target_set_queueing(say_target *target, bool val) {
+  if (!val)
+    say_target_flush(target);
+
+  target->queueing = val;
+}
+
+bool say_target_is_queueing(say_target *target) {
+  return target->queueing;
+}
+
+bool say_target_has_queued_drawables(say_target *target) {
+  return !say_render_queue_is_empty(target->queue);
+}
+
+void say_target_get_render_stats(say_target *target, say_render_stats *stats) {
+  say_render_queue_get_stats(target->queue, stats);
+}
+
+void say_target_reset_render_stats(say_target *target) {
+  say_render_queue_reset_stats(target->queue);
+}
+
+void say_target_flush(say_target *target) {
+  if (say_target_has_pending(target) && say_target_make_current(target))
+    say_target_flush_pending(target);
+}
+
 void say_target_update(say_target *target) {
+  say_target_flush(target);
+
   say_context *context = say_target_get_context(target);
   if (context) {
     say_context_update(context);
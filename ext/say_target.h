@@ -2,7 +2,7 @@
 #define SAY_TARGET_H_
 
 #include "say_context.h"
-#include "say_renderer.h"
+#include "say_render_queue.h"
 #include "say_view.h"
 #include "say_thread.h"
 
@@ -20,11 +20,19 @@ typedef struct {
 
   void *data;
 
-  say_renderer *renderer;
+  say_renderer     *renderer;
+  say_render_queue *queue;
+  bool              queueing;
 
   say_view *view;
   say_vector2 size;
 
+  /*
+   * True if the first row of the framebuffer is the top of the target, as is
+   * the case when rendering to a texture.
+   */
+  bool flip_y;
+
   uint8_t up_to_date;
   uint8_t view_up_to_date;
 } say_target;
@@ -48,6 +56,9 @@ say_view *say_target_get_view(say_target *target);
 say_view *say_target_get_default_view(say_target *target);
 
 say_shader *say_target_get_shader(say_target *target);
+say_matrix *say_target_get_projection(say_target *target);
+
+void say_target_set_flip_y(say_target *target, bool val);
 
 say_rect say_target_get_clip(say_target *target);
 say_rect say_target_get_viewport_for(say_target *target, say_rect rect);
@@ -64,6 +75,17 @@ say_image *say_target_get_rect(say_target *target, size_t x, size_t y,
                                size_t w, size_t h);
 say_image *say_target_to_image(say_target *target);
 
+void say_target_set_batching(say_target *target, bool val);
+bool say_target_is_batching(say_target *target);
+
+void say_target_set_queueing(say_target *target, bool val);
+bool say_target_is_queueing(say_target *target);
+bool say_target_has_queued_drawables(say_target *target);
+
+void say_target_get_render_stats(say_target *target, say_render_stats *stats);
+void say_target_reset_render_stats(say_target *target);
+
+void say_target_flush(say_target *target);
 void say_target_update(say_target *target);
 
 #endif
@@ -108,16 +108,15 @@ static void say_text_fill_vertices(void *data, void *vertices_ptr) {
   if (!text->font)
     return;
 
-  say_image *img = say_font_get_image(text->font, text->size);
+  if (!text->rect_updated)
+    say_text_update_rect(text);
 
+  /* Underlines use the white square present in every page */
+  say_image *img = say_font_get_image(text->font, text->size);
   if (!img)
     return;
 
-  if (!text->rect_updated)
-    say_text_update_rect(text);
-
-  /* Updating the rect may cause the image to change size */
-  text->last_img_size = say_image_get_size(img);
+  mo_array_resize(&text->quad_pages, text->underline_vertex / 4);
 
   uint8_t is_bold       = (text->style & SAY_TEXT_BOLD) != 0;
   uint8_t is_underlined = (text->style & SAY_TEXT_UNDERLINED) != 0;
@@ -191,7 +190,11 @@ static void say_text_fill_vertices(void *data, void *vertices_ptr) {
                                             is_bold);
       x += say_font_get_kerning(text->font, previous, current, text->size);
 
-      say_rect tex_rect = say_image_get_tex_rect(img, glyph->sub_rect);
+      say_image *page = say_font_get_page_image(text->font, text->size,
+                                                glyph->page);
+      mo_array_get_as(&text->quad_pages, ver_id / 4, size_t) = glyph->page;
+
+      say_rect tex_rect = say_image_get_tex_rect(page, glyph->sub_rect);
       say_rect rect = glyph->bounds;
 
       float left   = rect.x;
@@ -255,51 +258,79 @@ static void say_text_fill_vertices(void *data, void *vertices_ptr) {
   }
 }
 
+static size_t say_text_quad_page(say_text *text, size_t quad) {
+  /* Underlines (and quads that were never filled) use the first page */
+  if (quad < text->quad_pages.size)
+    return mo_array_get_as(&text->quad_pages, quad, size_t);
+  else
+    return 0;
+}
+
 static void say_text_draw(void *data, size_t first, size_t index) {
   say_text *text = (say_text*)data;
 
   if (!text->font)
     return;
 
-  say_image *img = say_font_get_image(text->font, text->size);
+  for (size_t i = 0; i < text->ranges.size; i++) {
+    say_text_range *range = mo_array_at(&text->ranges, i);
+    if (range->count == 0)
+      continue;
 
-  if (!img)
-    return;
+    say_image *img = say_font_get_page_image(text->font, text->size, i);
+    if (!img)
+      continue;
 
-  /*
-   * Following condition is true when the font image has been resized because of
-   * new characters that have been loaded.
-   */
-  say_vector2 img_size = say_image_get_size(img);
-  if (img_size.x != text->last_img_size.x ||
-      img_size.y != text->last_img_size.y) {
-    /*
-     * Unfortunately, this means we'd have to draw the text a second time to
-     * display it correctly (but we won't let the text appear in this case).
-     *
-     * There should be a way to update the text whenever image size is changed.
-     */
-    say_drawable_set_changed(text->drawable);
-  }
-  else {
     say_image_bind(img);
-    glDrawElements(GL_TRIANGLES, say_drawable_get_index_count(text->drawable),
-                   GL_UNSIGNED_INT, (void*)(index * sizeof(GLuint)));
+    glDrawElements(GL_TRIANGLES, range->count, GL_UNSIGNED_INT,
+                   (void*)((index + range->first) * sizeof(GLuint)));
   }
 }
 
 static void say_text_fill_indices(void *data, GLuint *indices, size_t from) {
   say_text *text = (say_text*)data;
 
-  size_t count = say_drawable_get_index_count(text->drawable);
-  size_t v = from;
-  for (size_t i = 0; i < count; i += 6, v += 4) {
-    indices[i + 0] = v + 0;
-    indices[i + 1] = v + 1;
-    indices[i + 2] = v + 2;
-    indices[i + 3] = v + 3;
-    indices[i + 4] = v + 0;
-    indices[i + 5] = v + 2;
+  size_t quad_count = say_drawable_get_index_count(text->drawable) / 6;
+
+  /*
+   * Quads are grouped by page, so that each page is drawn with a single call.
+   * The first pass counts the indices of each page, the second one writes them.
+   */
+  say_text_range empty = {0, 0};
+  mo_array_resize(&text->ranges, 0);
+
+  for (size_t q = 0; q < quad_count; q++) {
+    size_t page = say_text_quad_page(text, q);
+    while (text->ranges.size <= page)
+      mo_array_push(&text->ranges, &empty);
+
+    ((say_text_range*)mo_array_at(&text->ranges, page))->count += 6;
+  }
+
+  size_t offset = 0;
+  for (size_t i = 0; i < text->ranges.size; i++) {
+    say_text_range *range = mo_array_at(&text->ranges, i);
+
+    range->first = offset;
+    offset      += range->count;
+    range->count = 0;
+  }
+
+  for (size_t q = 0; q < quad_count; q++) {
+    say_text_range *range = mo_array_at(&text->ranges,
+                                        say_text_quad_page(text, q));
+
+    GLuint *quad = indices + range->first + range->count;
+    size_t  v    = from + 4 * q;
+
+    quad[0] = v + 0;
+    quad[1] = v + 1;
+    quad[2] = v + 2;
+    quad[3] = v + 3;
+    quad[4] = v + 0;
+    quad[5] = v + 2;
+
+    range->count += 6;
   }
 }
 
@@ -324,6 +355,9 @@ say_text *say_text_create() {
   text->underline_vertex = 0;
   text->auto_center      = false;
 
+  mo_array_init(&text->quad_pages, sizeof(size_t));
+  mo_array_init(&text->ranges, sizeof(say_text_range));
+
   return text;
 }
 
@@ -331,6 +365,9 @@ void say_text_free(say_text *text) {
   if (text->string)
     free(text->string);
 
+  mo_array_release(&text->quad_pages);
+  mo_array_release(&text->ranges);
+
   say_drawable_free(text->drawable);
   free(text);
 }
@@ -353,8 +390,6 @@ void say_text_copy(say_text *text, say_text *src) {
   text->auto_center = src->auto_center;
   text->center      = src->center;
 
-  text->last_img_size = src->last_img_size;
-
   text->underline_vertex = src->underline_vertex;
 
   say_text_compute_vertex_count(text);
@@ -9,6 +9,11 @@
 #define SAY_TEXT_ITALIC     0x2
 #define SAY_TEXT_UNDERLINED 0x4
 
+/* Indices of the quads using a given page of the font */
+typedef struct {
+  size_t first, count;
+} say_text_range;
+
 typedef struct {
   say_drawable *drawable;
 
@@ -28,9 +33,10 @@ typedef struct {
   bool        auto_center;
   say_vector2 center;
 
-  say_vector2 last_img_size;
-
   size_t underline_vertex;
+
+  mo_array quad_pages; /* size_t */
+  mo_array ranges;     /* say_text_range, one per page */
 } say_text;
 
 say_text *say_text_create();
@@ -31,10 +31,60 @@ void say_thread_join(say_thread *th) {
   WaitForSingleObject(th->th, INFINITE);
 }
 
+say_mutex *say_mutex_create() {
+  say_mutex *mutex = malloc(sizeof(say_mutex));
+  InitializeCriticalSection(&mutex->section);
+
+  return mutex;
+}
+
+void say_mutex_free(say_mutex *mutex) {
+  DeleteCriticalSection(&mutex->section);
+  free(mutex);
+}
+
+void say_mutex_lock(say_mutex *mutex) {
+  EnterCriticalSection(&mutex->section);
+}
+
+void say_mutex_unlock(say_mutex *mutex) {
+  LeaveCriticalSection(&mutex->section);
+}
+
+say_cond *say_cond_create() {
+  say_cond *cond = malloc(sizeof(say_cond));
+  InitializeConditionVariable(&cond->cond);
+
+  return cond;
+}
+
+void say_cond_free(say_cond *cond) {
+  free(cond);
+}
+
+void say_cond_wait(say_cond *cond, say_mutex *mutex) {
+  SleepConditionVariableCS(&cond->cond, &mutex->section, INFINITE);
+}
+
+void say_cond_timed_wait(say_cond *cond, say_mutex *mutex, float seconds) {
+  SleepConditionVariableCS(&cond->cond, &mutex->section,
+                           (DWORD)(seconds * 1000));
+}
+
+void say_cond_signal(say_cond *cond) {
+  WakeConditionVariable(&cond->cond);
+}
+
+void say_cond_broadcast(say_cond *cond) {
+  WakeAllConditionVariable(&cond->cond);
+}
+
 #else
 
 /* POSIX threads */
 
+#include <sys/time.h>
+
 say_thread *say_thread_create(void *data, say_thread_func func) {
   say_thread *th = malloc(sizeof(say_thread));
   pthread_create(&th->th, NULL, func, data);
@@ -50,4 +100,61 @@ void say_thread_join(say_thread *th) {
   pthread_join(th->th, NULL);
 }
 
+say_mutex *say_mutex_create() {
+  say_mutex *mutex = malloc(sizeof(say_mutex));
+  pthread_mutex_init(&mutex->mutex, NULL);
+
+  return mutex;
+}
+
+void say_mutex_free(say_mutex *mutex) {
+  pthread_mutex_destroy(&mutex->mutex);
+  free(mutex);
+}
+
+void say_mutex_lock(say_mutex *mutex) {
+  pthread_mutex_lock(&mutex->mutex);
+}
+
+void say_mutex_unlock(say_mutex *mutex) {
+  pthread_mutex_unlock(&mutex->mutex);
+}
+
+say_cond *say_cond_create() {
+  say_cond *cond = malloc(sizeof(say_cond));
+  pthread_cond_init(&cond->cond, NULL);
+
+  return cond;
+}
+
+void say_cond_free(say_cond *cond) {
+  pthread_cond_destroy(&cond->cond);
+  free(cond);
+}
+
+void say_cond_wait(say_cond *cond, say_mutex *mutex) {
+  pthread_cond_wait(&cond->cond, &mutex->mutex);
+}
+
+void say_cond_timed_wait(say_cond *cond, say_mutex *mutex, float seconds) {
+  struct timeval now;
+  gettimeofday(&now, NULL);
+
+  long nsec = now.tv_usec * 1000 + (long)((seconds - (long)seconds) * 1e9);
+
+  struct timespec until;
+  until.tv_sec  = now.tv_sec + (long)seconds + nsec / 1000000000;
+  until.tv_nsec = nsec % 1000000000;
+
+  pthread_cond_timedwait(&cond->cond, &mutex->mutex, &until);
+}
+
+void say_cond_signal(say_cond *cond) {
+  pthread_cond_signal(&cond->cond);
+}
+
+void say_cond_broadcast(say_cond *cond) {
+  pthread_cond_broadcast(&cond->cond);
+}
+
 #endif
@@ -15,6 +15,14 @@ typedef struct {
   say_thread_func func;
   void *data;
   } say_thread;
+
+typedef struct {
+  CRITICAL_SECTION section;
+} say_mutex;
+
+typedef struct {
+  CONDITION_VARIABLE cond;
+} say_cond;
 #else
 typedef struct {
   pthread_key_t key;
@@ -23,6 +31,14 @@ typedef struct {
 typedef struct {
   pthread_t th;
 } say_thread;
+
+typedef struct {
+  pthread_mutex_t mutex;
+} say_mutex;
+
+typedef struct {
+  pthread_cond_t cond;
+} say_cond;
 #endif
 
 say_thread_variable *say_thread_variable_create();
@@ -36,4 +52,18 @@ void say_thread_free(say_thread *th);
 
 void say_thread_join(say_thread *th);
 
+say_mutex *say_mutex_create();
+void say_mutex_free(say_mutex *mutex);
+
+void say_mutex_lock(say_mutex *mutex);
+void say_mutex_unlock(say_mutex *mutex);
+
+say_cond *say_cond_create();
+void say_cond_free(say_cond *cond);
+
+void say_cond_wait(say_cond *cond, say_mutex *mutex);
+void say_cond_timed_wait(say_cond *cond, say_mutex *mutex, float seconds);
+void say_cond_signal(say_cond *cond);
+void say_cond_broadcast(say_cond *cond);
+
 #endif
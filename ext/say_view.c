@@ -19,6 +19,7 @@ say_view *say_view_create() {
   say_view *view = (say_view*)malloc(sizeof(say_view));
 
   view->matrix = say_matrix_identity();
+  view->flipped_matrix = say_matrix_identity();
   view->matrix_updated = 0;
   view->custom_matrix  = 0;
 
@@ -31,6 +32,7 @@ say_view *say_view_create() {
 }
 
 void say_view_free(say_view *view) {
+  say_matrix_free(view->flipped_matrix);
   say_matrix_free(view->matrix);
   free(view);
 }
@@ -96,6 +98,22 @@ say_matrix *say_view_get_matrix(say_view *view) {
   return view->matrix;
 }
 
+/*
+ * Returns the projection matrix with the y axis reversed, so that the top of
+ * the view ends up on the first row of the framebuffer.
+ */
+say_matrix *say_view_get_flipped_matrix(say_view *view) {
+  say_matrix_set_content(view->flipped_matrix,
+                         say_view_get_matrix(view)->content);
+
+  for (int x = 0; x < 4; x++) {
+    say_matrix_set(view->flipped_matrix, x, 1,
+                   -say_matrix_get(view->flipped_matrix, x, 1));
+  }
+
+  return view->flipped_matrix;
+}
+
 void say_view_set_matrix(say_view *view, say_matrix *matrix) {
   if (matrix) {
     view->custom_matrix = 1;
@@ -116,12 +134,16 @@ uint8_t say_view_has_changed(say_view *view) {
   return view->has_changed;
 }
 
-void say_view_apply(say_view *view, say_shader *shader, say_vector2 size) {
+void say_view_apply(say_view *view, say_shader *shader, say_vector2 size,
+                    bool flip_y) {
   say_shader_set_matrix_id(shader, SAY_PROJECTION_LOC_ID,
+                           flip_y ? say_view_get_flipped_matrix(view) :
                            say_view_get_matrix(view));
 
-  glViewport(view->viewport.x * size.x,
-             size.y - (view->viewport.y + view->viewport.h) * size.y,
+  float y = flip_y ? view->viewport.y * size.y :
+    size.y - (view->viewport.y + view->viewport.h) * size.y;
+
+  glViewport(view->viewport.x * size.x, y,
              view->viewport.w * size.x,
              view->viewport.h * size.y);
 
@@ -6,6 +6,7 @@
 
 typedef struct {
   say_matrix *matrix;
+  say_matrix *flipped_matrix;
   uint8_t matrix_updated;
   uint8_t custom_matrix;
   uint8_t has_changed;
@@ -32,9 +33,11 @@ say_vector2 say_view_get_center(say_view *view);
 say_rect say_view_get_viewport(say_view *view);
 
 say_matrix *say_view_get_matrix(say_view *view);
+say_matrix *say_view_get_flipped_matrix(say_view *view);
 void say_view_set_matrix(say_view *view, say_matrix *matrix);
 
 uint8_t say_view_has_changed(say_view *view);
-void say_view_apply(say_view *view, say_shader *shader, say_vector2 size);
+void say_view_apply(say_view *view, say_shader *shader, say_vector2 size,
+                    bool flip_y);
 
 #endif
@@ -127,3 +127,13 @@ void say_imp_context_make_current(say_imp_context ctxt) {
 void say_imp_context_update(say_imp_context ctxt) {
   SwapBuffers(ctxt->device);
 }
+
+typedef BOOL (WINAPI *say_wgl_swap_interval)(int interval);
+
+void say_imp_context_set_vsync(say_imp_context ctxt, bool val) {
+  say_wgl_swap_interval func = (say_wgl_swap_interval)
+    wglGetProcAddress("wglSwapIntervalEXT");
+
+  if (func)
+    func(val ? 1 : 0);
+}
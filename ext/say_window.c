@@ -73,6 +73,12 @@ void say_window_update(say_window *win) {
   say_target_update(win->target);
 }
 
+/* Only affects the context used by the calling thread */
+void say_window_set_vsync(say_window *win, bool val) {
+  if (say_target_make_current(win->target))
+    say_context_set_vsync(say_context_current(), val);
+}
+
 void say_window_hide_cursor(say_window *win) {
   say_imp_window_hide_cursor(win->win);
   win->show_cursor = false;
@@ -145,6 +151,28 @@ int say_window_poll_event(say_window *win, say_event *ev) {
   return false;
 }
 
+/*
+ * Drains up to max pending events at once. With coalesce_motion, consecutive
+ * mouse motions are merged into the last one, since only the final position
+ * usually matters.
+ */
+size_t say_window_poll_events(say_window *win, say_event *out, size_t max,
+                              bool coalesce_motion) {
+  size_t count = 0;
+
+  while (count < max && say_window_poll_event(win, &out[count])) {
+    if (coalesce_motion && count > 0 &&
+        out[count].type     == SAY_EVENT_MOUSE_MOTION &&
+        out[count - 1].type == SAY_EVENT_MOUSE_MOTION) {
+      out[count - 1] = out[count];
+    }
+    else
+      count++;
+  }
+
+  return count;
+}
+
 void say_window_wait_event(say_window *win, say_event *ev) {
   say_imp_window_wait_event(win->win, ev, &win->input);
   say_window_process_event(win, ev);
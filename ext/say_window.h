@@ -26,6 +26,7 @@ int say_window_open(say_window *win, size_t w, size_t h, const char *title,
 void say_window_close(say_window *win);
 
 void say_window_update(say_window *win);
+void say_window_set_vsync(say_window *win, bool val);
 
 void say_window_hide_cursor(say_window *win);
 void say_window_show_cursor(say_window *win);
@@ -36,6 +37,8 @@ void say_window_set_title(say_window *win, const char *title);
 bool  say_window_resize(say_window *win, size_t w, size_t h);
 
 int  say_window_poll_event(say_window *win, say_event *ev);
+size_t say_window_poll_events(say_window *win, say_event *out, size_t max,
+                              bool coalesce_motion);
 void say_window_wait_event(say_window *win, say_event *ev);
 
 say_input *say_window_get_input(say_window *win);
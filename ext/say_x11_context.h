@@ -148,3 +148,46 @@ void say_imp_context_update(say_imp_context context) {
   glXSwapBuffers(context->dis, context->win);
 }
 
+typedef void (*say_glx_swap_interval_ext)(Display *dpy, GLXDrawable drawable,
+                                          int interval);
+typedef int (*say_glx_swap_interval_mesa)(unsigned int interval);
+typedef int (*say_glx_swap_interval_sgi)(int interval);
+
+static bool say_x11_has_glx_extension(Display *dis, const char *name) {
+  const char *exts = glXQueryExtensionsString(dis, DefaultScreen(dis));
+  if (!exts)
+    return false;
+
+  /* Only match whole names, e.g. not GLX_EXT_swap_control_tear */
+  size_t len = strlen(name);
+  for (const char *it = strstr(exts, name); it; it = strstr(it + 1, name)) {
+    if ((it == exts || it[-1] == ' ') && (it[len] == ' ' || it[len] == '\0'))
+      return true;
+  }
+
+  return false;
+}
+
+void say_imp_context_set_vsync(say_imp_context context, bool val) {
+  if (say_x11_has_glx_extension(context->dis, "GLX_EXT_swap_control")) {
+    say_glx_swap_interval_ext func = (say_glx_swap_interval_ext)
+      glXGetProcAddress((GLubyte*)"glXSwapIntervalEXT");
+    if (func)
+      func(context->dis, context->win, val ? 1 : 0);
+  }
+  else if (say_x11_has_glx_extension(context->dis, "GLX_MESA_swap_control")) {
+    say_glx_swap_interval_mesa func = (say_glx_swap_interval_mesa)
+      glXGetProcAddress((GLubyte*)"glXSwapIntervalMESA");
+    if (func)
+      func(val ? 1 : 0);
+  }
+  else if (val &&
+           say_x11_has_glx_extension(context->dis, "GLX_SGI_swap_control")) {
+    /* SGI_swap_control can't disable vsync */
+    say_glx_swap_interval_sgi func = (say_glx_swap_interval_sgi)
+      glXGetProcAddress((GLubyte*)"glXSwapIntervalSGI");
+    if (func)
+      func(1);
+  }
+}
+
@@ -377,13 +377,11 @@ bool say_imp_window_set_icon(say_imp_window win, struct say_image *icon) {
 
   /* Convert image to BGRA */
 
-  say_color *orig_buf = say_flip_color_buffer_copy(say_image_get_buffer(icon),
-                                                   say_image_get_width(icon),
-                                                   say_image_get_height(icon));
+  say_color *orig_buf = say_image_get_buffer(icon);
 
   long *pixels = malloc(sizeof(long) * (2 + (icon->width * icon->height)));
 
-  if (!(pixels && orig_buf)) {
+  if (!pixels) {
     say_error_set("could not allocate icon buffer");
     return false;
   }
@@ -404,8 +402,6 @@ bool say_imp_window_set_icon(say_imp_window win, struct say_image *icon) {
     buf++;
   }
 
-  free(orig_buf);
-
   /* Set _NET_WM_ICON */
 
   Atom icon_atom = XInternAtom(win->dis, "_NET_WM_ICON", false);
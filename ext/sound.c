@@ -97,6 +97,33 @@ VALUE ray_sound_stop(VALUE self) {
   return self;
 }
 
+/* @return [Integer] priority of the sound, 0 by default */
+static
+VALUE ray_sound_priority(VALUE self) {
+  return INT2FIX(say_sound_get_priority(ray_rb2sound(self)));
+}
+
+/*
+  @overload priority=(val)
+    Sounds only use a voice while they are playing. When all of them are in
+    use, playing a sound stops the least important one: the one with the
+    lowest priority or, when priorities are equal, the one that is heard the
+    least. If no such sound exists, this sound just doesn't play.
+
+    @param [Integer] val New priority
+*/
+static
+VALUE ray_sound_set_priority(VALUE self, VALUE val) {
+  say_sound_set_priority(ray_rb2sound(self), NUM2INT(val));
+  return val;
+}
+
+/* @return [true, false] True if the sound is currently bound to a voice */
+static
+VALUE ray_sound_has_voice(VALUE self) {
+  return say_sound_has_voice(ray_rb2sound(self)) ? Qtrue : Qfalse;
+}
+
 void Init_ray_sound() {
   ray_cSound = rb_define_class_under(ray_mRay, "Sound", ray_cAudioSource);
   rb_define_alloc_func(ray_cSound, ray_sound_alloc);
@@ -115,4 +142,8 @@ void Init_ray_sound() {
   rb_define_method(ray_cSound, "play", ray_sound_play, 0);
   rb_define_method(ray_cSound, "pause", ray_sound_pause, 0);
   rb_define_method(ray_cSound, "stop", ray_sound_stop, 0);
+
+  rb_define_method(ray_cSound, "priority", ray_sound_priority, 0);
+  rb_define_method(ray_cSound, "priority=", ray_sound_set_priority, 1);
+  rb_define_method(ray_cSound, "voice?", ray_sound_has_voice, 0);
 }
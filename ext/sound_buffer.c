@@ -21,13 +21,46 @@ VALUE ray_sound_buffer_alloc(VALUE self) {
 }
 
 /*
-  @overload initialize(io_or_string)
+  @overload initialize(io_or_string, opts = {})
     Loads the sound buffer out of an IO object or a string.
+
+    Buffers loaded from files with identical contents share the same OpenAL
+    buffer, as long as they don't keep their samples.
+
+    @param [Hash] opts
+    @option opts [true, false] :keep_samples (true) Whether to keep a copy of
+      the samples in memory once they've been sent to OpenAL.
+    @option opts [Integer] :channels Amount of channels to mix the sound down
+      to (1 or 2). Only mono sounds are positioned in 3D. Defaults to the
+      channels of the file.
+    @option opts [true, false] :resample (false) Whether to convert the sound
+      to the sample rate of the audio device once, instead of letting OpenAL
+      resample it each time it is played. {#sample_rate} is then the one of
+      the device rather than the one of the file.
+    @option opts [Float] :gain (1.0) Factor applied to every sample.
  */
 static
-VALUE ray_sound_buffer_init(VALUE self, VALUE arg) {
+VALUE ray_sound_buffer_init(int argc, VALUE *argv, VALUE self) {
   say_sound_buffer *buf = ray_rb2sound_buffer(self);
 
+  VALUE arg, opts = Qnil;
+  rb_scan_args(argc, argv, "11", &arg, &opts);
+
+  if (!NIL_P(opts)) {
+    VALUE keep = rb_hash_aref(opts, RAY_SYM("keep_samples"));
+    if (!NIL_P(keep))
+      say_sound_buffer_set_keep_samples(buf, RTEST(keep));
+
+    VALUE channels = rb_hash_aref(opts, RAY_SYM("channels"));
+    VALUE resample = rb_hash_aref(opts, RAY_SYM("resample"));
+    VALUE gain     = rb_hash_aref(opts, RAY_SYM("gain"));
+
+    say_sound_buffer_set_conversion(buf,
+                                    NIL_P(channels) ? 0 : NUM2ULONG(channels),
+                                    RTEST(resample),
+                                    NIL_P(gain) ? 1 : NUM2DBL(gain));
+  }
+
   if (rb_respond_to(arg, RAY_METH("read"))) {
     arg = rb_funcall(arg, RAY_METH("read"), 0);
 
@@ -63,13 +96,79 @@ VALUE ray_sound_buffer_sample_rate(VALUE self) {
   return INT2FIX(say_sound_buffer_get_sample_rate(ray_rb2sound_buffer(self)));
 }
 
+/* @return [true, false] True if samples are kept in memory */
+static
+VALUE ray_sound_buffer_keeps_samples(VALUE self) {
+  return say_sound_buffer_keeps_samples(ray_rb2sound_buffer(self)) ?
+    Qtrue : Qfalse;
+}
+
+/*
+ * @return [Array<Integer>, nil] Interleaved samples sent to OpenAL, once
+ *   converted. Nil if samples aren't kept in memory.
+ */
+static
+VALUE ray_sound_buffer_samples(VALUE self) {
+  say_sound_buffer *buf = ray_rb2sound_buffer(self);
+
+  short *samples = say_sound_buffer_get_samples(buf);
+  if (!samples)
+    return Qnil;
+
+  size_t count = say_sound_buffer_get_sample_count(buf);
+
+  VALUE ary = rb_ary_new2(count);
+  for (size_t i = 0; i < count; i++)
+    rb_ary_push(ary, INT2FIX(samples[i]));
+
+  return ary;
+}
+
+/*
+ * @return [true, false] True if the OpenAL buffer is shared with another sound
+ *   buffer loaded from the same data.
+ */
+static
+VALUE ray_sound_buffer_is_shared(VALUE self) {
+  return say_sound_buffer_is_shared(ray_rb2sound_buffer(self)) ? Qtrue : Qfalse;
+}
+
+/* @return [Integer] amount of distinct OpenAL buffers that are shared */
+static
+VALUE ray_sound_buffer_cache_size(VALUE self) {
+  return ULONG2NUM(say_sound_buffer_get_cache_size());
+}
+
+/*
+  @overload duration_of(filename)
+    Reads the duration of a sound file without decoding it.
+    @return [Float] duration in seconds
+ */
+static
+VALUE ray_sound_buffer_duration_of(VALUE self, VALUE filename) {
+  float duration = say_sound_file_get_duration(StringValuePtr(filename));
+  if (duration < 0)
+    rb_raise(rb_eRangeError, "%s", say_error_get_last());
+
+  return rb_float_new(duration);
+}
+
 void Init_ray_sound_buffer() {
   ray_cSoundBuffer = rb_define_class_under(ray_mRay, "SoundBuffer", rb_cObject);
 
   rb_define_alloc_func(ray_cSoundBuffer, ray_sound_buffer_alloc);
-  rb_define_method(ray_cSoundBuffer, "initialize", ray_sound_buffer_init, 1);
+  rb_define_method(ray_cSoundBuffer, "initialize", ray_sound_buffer_init, -1);
+
+  rb_define_singleton_method(ray_cSoundBuffer, "cache_size",
+                             ray_sound_buffer_cache_size, 0);
+  rb_define_singleton_method(ray_cSoundBuffer, "duration_of",
+                             ray_sound_buffer_duration_of, 1);
 
   rb_define_method(ray_cSoundBuffer, "duration", ray_sound_buffer_duration, 0);
   rb_define_method(ray_cSoundBuffer, "channel_count", ray_sound_buffer_channel_count, 0);
   rb_define_method(ray_cSoundBuffer, "sample_rate", ray_sound_buffer_sample_rate, 0);
+  rb_define_method(ray_cSoundBuffer, "keep_samples?",
+                   ray_sound_buffer_keeps_samples, 0);
+  rb_define_method(ray_cSoundBuffer, "samples", ray_sound_buffer_samples, 0);
+  rb_define_method(ray_cSoundBuffer, "shared?", ray_sound_buffer_is_shared, 0);
 }
@@ -14,11 +14,24 @@ say_sprite *ray_rb2sprite(VALUE obj) {
   return sprite;
 }
 
+static
+say_image *ray_sprite_batch_proc(void *data, size_t *first) {
+  say_drawable *drawable = ((say_sprite*)data)->drawable;
+
+  /* Shader attributes are set per draw call, so they prevent batching. */
+  VALUE rb_obj = (VALUE)say_drawable_get_other_data(drawable);
+  if (!NIL_P(rb_iv_get(rb_obj, "@shader_attributes")))
+    return NULL;
+
+  return say_sprite_batch_quad(data, first);
+}
+
 VALUE ray_sprite_alloc(VALUE self) {
   say_sprite *sprite = say_sprite_create();
   VALUE rb = Data_Wrap_Struct(self, NULL, say_sprite_free, sprite);
 
   say_drawable_set_shader_proc(sprite->drawable, ray_drawable_shader_proc);
+  say_drawable_set_batch_proc(sprite->drawable, ray_sprite_batch_proc);
   say_drawable_set_other_data(sprite->drawable, (void*)rb);
   rb_iv_set(rb, "@shader_attributes", Qnil);
 
@@ -0,0 +1,188 @@
+#include "ray.h"
+
+VALUE ray_cSpriteBatch = Qnil;
+
+say_sprite_batch *ray_rb2sprite_batch(VALUE obj) {
+  if (!RAY_IS_A(obj, rb_path2class("Ray::SpriteBatch"))) {
+    rb_raise(rb_eTypeError, "Can't convert %s into Ray::SpriteBatch",
+             RAY_OBJ_CLASSNAME(obj));
+  }
+
+  say_sprite_batch *batch;
+  Data_Get_Struct(obj, say_sprite_batch, batch);
+
+  return batch;
+}
+
+static
+VALUE ray_sprite_batch_alloc(VALUE self) {
+  say_sprite_batch *batch = say_sprite_batch_create();
+  VALUE rb = Data_Wrap_Struct(self, NULL, say_sprite_batch_free, batch);
+
+  say_drawable_set_shader_proc(batch->drawable, ray_drawable_shader_proc);
+  say_drawable_set_other_data(batch->drawable, (void*)rb);
+  rb_iv_set(rb, "@shader_attributes", Qnil);
+
+  return rb;
+}
+
+static
+VALUE ray_sprite_batch_init_copy(VALUE self, VALUE orig) {
+  rb_iv_set(self, "@image", rb_iv_get(orig, "@image"));
+  ray_drawable_copy_attr(self, orig);
+  say_sprite_batch_copy(ray_rb2sprite_batch(self), ray_rb2sprite_batch(orig));
+  return self;
+}
+
+/* @return [true, false] True if sprite batches can be drawn */
+static
+VALUE ray_sprite_batch_available(VALUE self) {
+  return say_sprite_batch_is_available() ? Qtrue : Qfalse;
+}
+
+/*
+  @overload image=(img)
+    @param [Ray::Image, nil] img The image all the sprites will use.
+*/
+static
+VALUE ray_sprite_batch_set_image(VALUE self, VALUE img) {
+  say_sprite_batch_set_image(ray_rb2sprite_batch(self),
+                             NIL_P(img) ? NULL : ray_rb2image(img));
+  rb_iv_set(self, "@image", img);
+  return img;
+}
+
+/* @return [Ray::Image, nil] The image used by the sprites */
+static
+VALUE ray_sprite_batch_image(VALUE self) {
+  return rb_iv_get(self, "@image");
+}
+
+/* @return [Integer] Amount of sprites in the batch */
+static
+VALUE ray_sprite_batch_size(VALUE self) {
+  return ULONG2NUM(say_sprite_batch_get_size(ray_rb2sprite_batch(self)));
+}
+
+/* Removes all the sprites from the batch */
+static
+VALUE ray_sprite_batch_clear(VALUE self) {
+  say_sprite_batch_clear(ray_rb2sprite_batch(self));
+  return self;
+}
+
+static
+void ray_sprite_batch_convert(say_sprite_batch_instance *sprite,
+                              VALUE pos, VALUE rect, VALUE scale, VALUE origin,
+                              VALUE angle, VALUE color) {
+  say_rect c_rect = ray_convert_to_rect(rect);
+
+  sprite->pos       = ray_convert_to_vector2(pos);
+  sprite->scale     = ray_convert_to_vector2(scale);
+  sprite->origin    = ray_convert_to_vector2(origin);
+  sprite->angle     = NUM2DBL(angle);
+  sprite->color     = ray_rb2col(color);
+  sprite->rect_pos  = say_make_vector2(c_rect.x, c_rect.y);
+  sprite->rect_size = say_make_vector2(c_rect.w, c_rect.h);
+}
+
+static
+size_t ray_sprite_batch_check_id(say_sprite_batch *batch, VALUE id) {
+  long c_id = NUM2LONG(id);
+  if (c_id < 0 || (size_t)c_id >= say_sprite_batch_get_size(batch))
+    rb_raise(rb_eIndexError, "sprite index %ld out of range", c_id);
+
+  return c_id;
+}
+
+/*
+  @overload add_sprite(pos, rect, scale, origin, angle, color)
+    @return [Integer] Index of the new sprite
+*/
+static
+VALUE ray_sprite_batch_add_sprite(VALUE self, VALUE pos, VALUE rect,
+                                  VALUE scale, VALUE origin, VALUE angle,
+                                  VALUE color) {
+  rb_check_frozen(self);
+
+  say_sprite_batch_instance sprite;
+  ray_sprite_batch_convert(&sprite, pos, rect, scale, origin, angle, color);
+
+  return ULONG2NUM(say_sprite_batch_add(ray_rb2sprite_batch(self), &sprite));
+}
+
+/*
+  @overload set_sprite(id, pos, rect, scale, origin, angle, color)
+*/
+static
+VALUE ray_sprite_batch_set_sprite(VALUE self, VALUE id, VALUE pos, VALUE rect,
+                                  VALUE scale, VALUE origin, VALUE angle,
+                                  VALUE color) {
+  rb_check_frozen(self);
+
+  say_sprite_batch *batch = ray_rb2sprite_batch(self);
+  size_t c_id = ray_sprite_batch_check_id(batch, id);
+
+  say_sprite_batch_instance sprite;
+  ray_sprite_batch_convert(&sprite, pos, rect, scale, origin, angle, color);
+
+  say_sprite_batch_set(batch, c_id, &sprite);
+  return self;
+}
+
+/*
+  @overload sprite_at(id)
+    @return [Array] pos, rect, scale, origin, angle and color of a sprite
+*/
+static
+VALUE ray_sprite_batch_sprite_at(VALUE self, VALUE id) {
+  say_sprite_batch *batch = ray_rb2sprite_batch(self);
+  say_sprite_batch_instance *sprite =
+    say_sprite_batch_get(batch, ray_sprite_batch_check_id(batch, id));
+
+  return rb_ary_new3(6,
+                     ray_vector2_to_rb(sprite->pos),
+                     ray_rect2rb(say_make_rect(sprite->rect_pos.x,
+                                               sprite->rect_pos.y,
+                                               sprite->rect_size.x,
+                                               sprite->rect_size.y)),
+                     ray_vector2_to_rb(sprite->scale),
+                     ray_vector2_to_rb(sprite->origin),
+                     rb_float_new(sprite->angle),
+                     ray_col2rb(sprite->color));
+}
+
+/*
+ * Document-class: Ray::SpriteBatch
+ *
+ * A sprite batch draws many sprites that use the same image with a single
+ * instanced draw call. Each sprite only stores its position, scale, origin,
+ * angle, color and sub-rect; transformations are computed by the GPU.
+ *
+ * Sprite batches use their own shader, so custom shaders can't be used with
+ * them. The batch itself can still be moved, rotated, etc. like any other
+ * drawable.
+ */
+void Init_ray_sprite_batch() {
+  ray_cSpriteBatch = rb_define_class_under(ray_mRay, "SpriteBatch",
+                                           ray_cDrawable);
+  rb_define_alloc_func(ray_cSpriteBatch, ray_sprite_batch_alloc);
+  rb_define_method(ray_cSpriteBatch, "initialize_copy",
+                   ray_sprite_batch_init_copy, 1);
+
+  rb_define_singleton_method(ray_cSpriteBatch, "available?",
+                             ray_sprite_batch_available, 0);
+
+  rb_define_method(ray_cSpriteBatch, "image=", ray_sprite_batch_set_image, 1);
+  rb_define_method(ray_cSpriteBatch, "image", ray_sprite_batch_image, 0);
+
+  rb_define_method(ray_cSpriteBatch, "size", ray_sprite_batch_size, 0);
+  rb_define_method(ray_cSpriteBatch, "clear", ray_sprite_batch_clear, 0);
+
+  rb_define_private_method(ray_cSpriteBatch, "add_sprite",
+                           ray_sprite_batch_add_sprite, 6);
+  rb_define_private_method(ray_cSpriteBatch, "set_sprite",
+                           ray_sprite_batch_set_sprite, 7);
+  rb_define_private_method(ray_cSpriteBatch, "sprite_at",
+                           ray_sprite_batch_sprite_at, 1);
+}
@@ -112,11 +112,48 @@ VALUE ray_target_viewport_for(VALUE self, VALUE rect) {
  */
 static
 VALUE ray_target_make_current(VALUE self) {
-  if (!say_target_make_current(ray_rb2target(self)))
+  say_target *target = ray_rb2target(self);
+  if (!say_target_make_current(target))
     rb_raise(rb_eRuntimeError, "%s", say_error_get_last());
+
+  /* Any OpenGL call made afterward must happen after batched drawing */
+  say_target_flush(target);
+  return self;
+}
+
+/*
+ * Draws the sprites that are waiting to be batched together
+ *
+ * Sprites that share an image, a blend mode and a z order are drawn with a
+ * single draw call when they are drawn in a row. This is done automatically
+ * when needed (e.g. before {#update}, {#clear}, or reading pixels), so it only
+ * matters when using low-level OpenGL access.
+ */
+static
+VALUE ray_target_flush(VALUE self) {
+  say_target_flush(ray_rb2target(self));
   return self;
 }
 
+/*
+ * @return [true, false] True if consecutive sprites are batched together
+ */
+static
+VALUE ray_target_is_batching(VALUE self) {
+  return say_target_is_batching(ray_rb2target(self)) ? Qtrue : Qfalse;
+}
+
+/*
+ * @overload batching=(val)
+ *   Enables or disables sprite batching. It is enabled by default.
+ *   @param [true, false] val
+ */
+static
+VALUE ray_target_set_batching(VALUE self, VALUE val) {
+  say_target_set_batching(ray_rb2target(self), RTEST(val));
+  return val;
+}
+
 /*
  * @overload clear(color)
  *   Clears the target in a given color
@@ -142,8 +179,97 @@ VALUE ray_target_draw(VALUE self, VALUE obj) {
     say_target_draw_buffer(ray_rb2target(self),
                            ray_rb2buf_renderer(obj));
   }
-  else
-    say_target_draw(ray_rb2target(self), ray_rb2drawable(obj));
+  else {
+    say_target *target = ray_rb2target(self);
+
+    if (say_target_is_queueing(target)) {
+      /*
+       * Queued drawables must not be garbage collected before they are drawn.
+       * Once the queue has been flushed, they aren't needed anymore.
+       */
+      VALUE queued = rb_iv_get(self, "@queued_drawables");
+      if (NIL_P(queued))
+        rb_iv_set(self, "@queued_drawables", queued = rb_ary_new());
+      else if (!say_target_has_queued_drawables(target))
+        rb_ary_clear(queued);
+
+      rb_ary_push(queued, obj);
+    }
+
+    say_target_draw(target, ray_rb2drawable(obj));
+  }
+
+  return self;
+}
+
+/*
+ * @return [true, false] True if drawables are queued and sorted before being
+ *   drawn
+ */
+static
+VALUE ray_target_is_queueing(VALUE self) {
+  return say_target_is_queueing(ray_rb2target(self)) ? Qtrue : Qfalse;
+}
+
+/*
+ * @overload render_queue=(val)
+ *   Enables or disables the render queue. It is disabled by default.
+ *
+ *   When enabled, drawables aren't drawn immediately. They are sorted to
+ *   reduce state changes, and drawn when the target is updated (or whenever
+ *   it is needed, e.g. to read pixels). Opaque drawables (whose blend mode is
+ *   none) are sorted front-to-back, and by shader and image when they have
+ *   the same z order, as long as this doesn't change which one is visible
+ *   where they overlap. Blended drawables are drawn back-to-front, and in the
+ *   order they were drawn when they have the same z order.
+ *
+ *   Like with {Ray::BufferRenderer}, drawables must not be modified until the
+ *   queue is flushed.
+ *
+ *   @param [true, false] val
+ */
+static
+VALUE ray_target_set_queueing(VALUE self, VALUE val) {
+  say_target_set_queueing(ray_rb2target(self), RTEST(val));
+  return val;
+}
+
+/*
+ * Statistics about drawables that went through the render queue since the
+ * last call to {#reset_render_stats}
+ *
+ * @return [Hash] A hash with the following keys:
+ *
+ *   - drawables: amount of drawables that were queued;
+ *   - draw_calls: amount of draw calls used to draw them;
+ *   - saved_draw_calls: amount of draw calls saved by batching;
+ *   - state_changes: amount of state changes (shader, image, vertex buffer,
+ *     blend mode) between consecutive drawables;
+ *   - saved_state_changes: how many more state changes there would have been
+ *     without sorting.
+ */
+static
+VALUE ray_target_render_stats(VALUE self) {
+  say_render_stats stats;
+  say_target_get_render_stats(ray_rb2target(self), &stats);
+
+  VALUE hash = rb_hash_new();
+  rb_hash_aset(hash, RAY_SYM("drawables"), ULONG2NUM(stats.drawables));
+  rb_hash_aset(hash, RAY_SYM("draw_calls"), ULONG2NUM(stats.draw_calls));
+  rb_hash_aset(hash, RAY_SYM("saved_draw_calls"),
+               LONG2NUM((long)stats.drawables - (long)stats.draw_calls));
+  rb_hash_aset(hash, RAY_SYM("state_changes"), ULONG2NUM(stats.state_changes));
+  rb_hash_aset(hash, RAY_SYM("saved_state_changes"),
+               LONG2NUM((long)stats.unsorted_state_changes -
+                        (long)stats.state_changes));
+
+  return hash;
+}
+
+/* Resets the counters returned by {#render_stats} */
+static
+VALUE ray_target_reset_render_stats(VALUE self) {
+  say_target_reset_render_stats(ray_rb2target(self));
   return self;
 }
 
@@ -221,11 +347,21 @@ void Init_ray_target() {
 
   /* @group Low-level access */
   rb_define_method(ray_cTarget, "make_current", ray_target_make_current, 0);
+  rb_define_method(ray_cTarget, "flush", ray_target_flush, 0);
   /* @endgroup */
 
   /* @group Drawing */
   rb_define_method(ray_cTarget, "clear", ray_target_clear, 1);
   rb_define_method(ray_cTarget, "draw", ray_target_draw, 1);
+
+  rb_define_method(ray_cTarget, "batching?", ray_target_is_batching, 0);
+  rb_define_method(ray_cTarget, "batching=", ray_target_set_batching, 1);
+
+  rb_define_method(ray_cTarget, "render_queue?", ray_target_is_queueing, 0);
+  rb_define_method(ray_cTarget, "render_queue=", ray_target_set_queueing, 1);
+  rb_define_method(ray_cTarget, "render_stats", ray_target_render_stats, 0);
+  rb_define_method(ray_cTarget, "reset_render_stats",
+                   ray_target_reset_render_stats, 0);
   /* @endgroup */
 
   /* @group Pixel-level access */
@@ -145,6 +145,41 @@ VALUE ray_window_poll_event(VALUE self, VALUE ev) {
   return ev;
 }
 
+/*
+  @overload vsync=(val)
+    Synchronizes buffer swaps with the refresh rate of the screen, when the
+    driver allows it.
+    @param [true, false] val
+*/
+static
+VALUE ray_window_set_vsync(VALUE self, VALUE val) {
+  say_window_set_vsync(ray_rb2window(self), RTEST(val));
+  return val;
+}
+
+/*
+  @overload poll_events(buffer, coalesce_motion = false)
+    Moves as many pending events as the buffer can hold into it, replacing its
+    previous content.
+
+    @param [Ray::EventBuffer] buffer Buffer to store events into
+    @param [true, false] coalesce_motion If true, consecutive mouse motions
+      are merged into the last one.
+
+    @return [Ray::EventBuffer] buffer
+*/
+static
+VALUE ray_window_poll_events(int argc, VALUE *argv, VALUE self) {
+  VALUE rb_buf, coalesce = Qnil;
+  rb_scan_args(argc, argv, "11", &rb_buf, &coalesce);
+
+  ray_event_buffer *buf = ray_rb2event_buffer(rb_buf);
+  buf->size = say_window_poll_events(ray_rb2window(self), buf->events,
+                                     buf->capacity, RTEST(coalesce));
+
+  return rb_buf;
+}
+
 /*
   @overload wait_event(ev)
     Gets the next event from the event queue. If there's none, waits until
@@ -180,7 +215,10 @@ void Init_ray_window() {
   rb_define_method(ray_cWindow, "title=", ray_window_set_title, 1);
   rb_define_method(ray_cWindow, "resize", ray_window_resize, 1);
 
+  rb_define_method(ray_cWindow, "vsync=", ray_window_set_vsync, 1);
+
   rb_define_method(ray_cWindow, "poll_event", ray_window_poll_event, 1);
+  rb_define_method(ray_cWindow, "poll_events", ray_window_poll_events, -1);
   rb_define_method(ray_cWindow, "wait_event", ray_window_wait_event, 1);
 
   rb_define_method(ray_cWindow, "input", ray_window_input, 0);
@@ -16,6 +16,11 @@ module Ray
   # For instance, in a scene, you'd do:
   #   always { @translation.update }
   #
+  # Animations measure time themselves in that case. When the duration of the
+  # frame is already known, it can be passed instead, so that many animations
+  # don't each need to query the clock:
+  #   @translation.update(delta)
+  #
   # (See also {AnimationList})
   #
   # Animations can be paused (#pause) and resumed (#resume) if needed.
@@ -75,10 +80,11 @@ module Ray
     def initialize
       @duration = 0
 
-      @start_time = nil
-      @pause_time = nil
-      @end_time   = nil
+      @elapsed     = 0.0
+      @last_update = nil
+      @frame_delta = nil
 
+      @paused  = false
       @running = false
 
       @target = nil
@@ -90,8 +96,9 @@ module Ray
     def start(on)
       @target = on
 
-      @start_time = Time.now
-      @end_time   = @start_time + duration
+      @elapsed     = 0.0
+      @last_update = Ray::Clock.now
+      @paused      = false
 
       @running = true
 
@@ -113,21 +120,19 @@ module Ray
 
     # Pauses the animation.
     def pause
-      @pause_time = Time.now
-      @running    = false
+      @paused  = true
+      @running = false
 
       pause_animation
     end
 
     # Resumes from the pause.
-    # The time when the animation should end is also updated.
+    # The time spent paused isn't counted in the progression.
     def resume
-      return unless @pause_time
+      return unless @paused
 
-      # Reset @start_time to compute the progression more easily.
-      @end_time   = Time.now + duration - (@pause_time - @start_time)
-      @start_time = @end_time - duration
-      @pause_time = nil
+      @paused      = false
+      @last_update = Ray::Clock.now
 
       @running = true
 
@@ -136,17 +141,39 @@ module Ray
 
     # Updates the target if the animation is running.
     # May also end the animation.
-    def update
-      if running?
-        update_target
+    #
+    # @param [Float, nil] delta Time elapsed since the last update, in
+    #   seconds. If nil, the animation measures it using {Ray::Clock}.
+    def update(delta = nil)
+      return unless running?
+
+      # Time passed explicitly is accounted for, so that it isn't counted again
+      # by a later update measuring the time itself. It may be more than the
+      # time that actually passed, in which case the clock isn't moved past
+      # the present.
+      if delta
+        @last_update = [@last_update + delta, Ray::Clock.now].min
+      else
+        now = Ray::Clock.now
+
+        if now > @last_update
+          delta = now - @last_update
+          @last_update = now
+        else
+          delta = 0.0
+        end
+      end
 
-        if Time.now >= @end_time
-          @running  = false
-          @end_time = nil
+      @elapsed    += delta
+      @frame_delta = delta
 
-          end_animation
-          raise_event :animation_end, self if raiser_runner
-        end
+      update_target
+
+      if @elapsed >= duration
+        @running = false
+
+        end_animation
+        raise_event :animation_end, self if raiser_runner
       end
     end
 
@@ -203,7 +230,7 @@ module Ray
         if @duration.zero?
           1.0
         else
-          ret = (Time.now - @start_time) / duration
+          ret = @elapsed / duration
           ret > 1 ? 1.0 : ret
         end
       end
@@ -225,7 +252,7 @@ module Ray
     def running?; @running ; end
 
     # @return [true, false] True if the animation is paused
-    def paused?; not @pause_time.nil?; end
+    def paused?; @paused; end
 
     # @return [Object] The target of the animation.
     attr_reader :target
@@ -233,8 +260,18 @@ module Ray
     # @return [Float] Duration of the animation, in seconds.
     attr_accessor :duration
 
-    # @return [Time] Time when the animation should end.
-    attr_reader :end_time
+    # @return [Time, nil] Time when the animation should end if it keeps
+    #   running. Nil if the animation isn't running.
+    def end_time
+      Time.now + (duration - @elapsed) if running?
+    end
+
+    # @return [Float] Time the animation has been running for, in seconds.
+    attr_reader :elapsed
+
+    # @return [Float, nil] Duration of the last update, in seconds. Animations
+    #   that drive other animations pass it along to them.
+    attr_reader :frame_delta
   end
 end
 
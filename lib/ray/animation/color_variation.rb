@@ -26,6 +26,7 @@ module Ray
         end
 
         @attribute = opts[:attribute] || :color
+        @setter    = :"#{@attribute}="
 
         self.duration = opts[:duration]
       end
@@ -59,8 +60,8 @@ module Ray
       end
 
       def update_target
-        @animations.each { |anim| anim.update }
-        target.send("#{@attribute}=", @current_value)
+        @animations.each { |anim| anim.update(frame_delta) }
+        target.send(@setter, @current_value)
       end
 
       # @return [ColorVariation] Opposite color variation.
@@ -26,7 +26,7 @@ module Ray
       end
 
       def update_target
-        @animations.each { |anim| anim.update }
+        @animations.each { |anim| anim.update(frame_delta) }
       end
 
       def pause_animation
@@ -21,6 +21,7 @@ module Ray
         end
 
         @attribute = opts[:attribute]
+        @setter    = :"#{@attribute}="
 
         self.duration = opts[:duration]
       end
@@ -35,11 +36,11 @@ module Ray
 
       def update_target
         increase = progression * @variation
-        target.send("#{@attribute}=", @current_value + increase)
+        target.send(@setter, @current_value + increase)
       end
 
       def end_animation
-        target.send("#{@attribute}=", @current_value + @variation)
+        target.send(@setter, @current_value + @variation)
       end
 
       # @return [FloatVariation] The opposite variation.
@@ -30,7 +30,7 @@ module Ray
       end
 
       def update_target
-        @current_anim.update
+        @current_anim.update(frame_delta)
       end
 
       def pause_animation
@@ -34,6 +34,7 @@ module Ray
         end
 
         @attribute = opts[:attribute]
+        @setter    = :"#{@attribute}="
 
         self.duration = opts[:duration]
       end
@@ -68,8 +69,8 @@ module Ray
       end
 
       def update_target
-        @animations.each { |anim| anim.update }
-        target.send("#{@attribute}=", @current_value)
+        @animations.each { |anim| anim.update(frame_delta) }
+        target.send(@setter, @current_value)
       end
 
       # @return [VectorVariation] The opposite vector variation.
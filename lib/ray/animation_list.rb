@@ -28,8 +28,30 @@ module Ray
     end
 
     # Updates all the animations
-    def update
-      @animations.each(&:update)
+    # @param [Float, nil] delta Time elapsed since the last update, passed to
+    #   every animation (see {Animation#update}).
+    def update(delta = nil)
+      @animations.each { |anim| anim.update(delta) }
+      self
+    end
+
+    # Removes animations that are no more in use, and updates the other ones,
+    # going over the list only once.
+    #
+    # Animations that end during this call are only removed by the next one,
+    # giving :animation_end handlers a chance to restart them.
+    #
+    # @param [Float, nil] delta Time elapsed since the last step.
+    def step(delta = nil)
+      @animations.reject! do |anim|
+        if anim.running?
+          anim.update(delta)
+          false
+        else
+          !anim.paused?
+        end
+      end
+
       self
     end
 
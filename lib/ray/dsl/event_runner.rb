@@ -4,13 +4,21 @@ module Ray
     # makes everything work. You may want to create one by yourself if you don't
     # want to use the other classes that use it. You just have to call run every
     # time you need the events to be processed.
+    #
+    # Handlers are indexed by event type and, when possible, by their first
+    # argument (symbols, strings, and keys), so that each event is only checked
+    # against the handlers that may match it.
     class EventRunner
       def initialize
         @handlers    = []
         @next_events = []
 
+        @handler_index = nil
+
         @event_groups = Hash.new { |h, k| h[k] = true }
         @event_groups[:default] = true
+
+        @disabled_groups = {}
       end
 
       # Sends all the known events to our listeners.
@@ -18,15 +26,20 @@ module Ray
         event_list   = @next_events
         @next_events = []
 
-        handlers = @handlers.select { |o| group_enabled?(o.group) }
+        # Changes made by handlers only apply to the next run
+        index    = handler_index
+        disabled = @disabled_groups
 
         event_list.each do |ev|
-          handlers.each { |o| o.call(ev) if o.match?(ev) }
+          handlers_for(index, ev).each do |o|
+            o.call(ev) if !disabled[o.group] && o.match?(ev)
+          end
         end
       end
 
       def add_handler(type, group, args, block)
         @handlers << Ray::DSL::Handler.new(type, group, args, block)
+        @handler_index = nil
       end
 
       def add_event(type, args)
@@ -36,27 +49,77 @@ module Ray
       # Disables an event group
       def disable_group(group)
         @event_groups[group] = false
+        @disabled_groups = @disabled_groups.merge(group => true)
       end
 
       # Enables an event group
       def enable_group(group)
         @event_groups[group] = true
+
+        if @disabled_groups.has_key? group
+          @disabled_groups = @disabled_groups.dup
+          @disabled_groups.delete group
+        end
       end
 
       # Removes all the handlers belonging to a given group
       def remove_group(name)
         @handlers.delete_if { |o| o.group == name }
+        @handler_index = nil
       end
 
       # Removes all the registered handlers
       def clear
         @handlers.clear
+        @handler_index = nil
       end
 
       # @return Whether an event group is enabled
       def group_enabled?(group)
         @event_groups[group]
       end
+
+      private
+      # @return [Hash] Maps event types to a list of handlers that need to be
+      #   checked against any event, and a hash mapping first arguments to the
+      #   handlers that can only match events with that argument.
+      def handler_index
+        @handler_index ||= build_handler_index
+      end
+
+      def build_handler_index
+        index = {}
+
+        @handlers.each_with_index do |handler, i|
+          handler.order = i
+
+          generic, keyed = (index[handler.type] ||= [[], {}])
+
+          if keys = handler.index_keys
+            keys.uniq.each { |key| (keyed[key] ||= []) << handler }
+          else
+            generic << handler
+          end
+        end
+
+        index
+      end
+
+      def handlers_for(index, ev)
+        generic, keyed = index[ev.type]
+        return [] unless generic
+
+        specific = keyed[ev.args.first] unless keyed.empty? || ev.args.empty?
+
+        if !specific
+          generic
+        elsif generic.empty?
+          specific
+        else
+          # Handlers are still called in the order they were registered in
+          (generic + specific).sort_by(&:order)
+        end
+      end
     end
   end
 end
@@ -22,10 +22,24 @@ module Ray
         end
       end
 
+      # @return [Array, nil] Values the first argument of an event must be equal
+      #   to for this handler to match it, or nil if it can't be known.
+      def index_keys
+        return nil if @args.empty?
+
+        case first = @args.first
+        when Ray::Key       then first.to_a
+        when Symbol, String then [first]
+        end
+      end
+
       attr_reader :type
       attr_reader :group
       attr_reader :args
 
+      # Position of the handler in the list of its runner
+      attr_accessor :order
+
       private
       def match_args?(args)
         return false if @args.size > args.size
@@ -0,0 +1,28 @@
+module Ray
+  class EventBuffer
+    include Enumerable
+
+    # Yields each event of the buffer. The same Ray::Event object is reused for
+    # every event, and must thus be copied if it needs to be kept.
+    #
+    # @yieldparam [Ray::Event] event
+    def each
+      return Enumerator.new(self, :each) unless block_given?
+
+      ev = Ray::Event.new
+      size.times { |i| yield event_at(i, ev) }
+
+      self
+    end
+
+    # @return [Ray::Event, nil] A new event object copied from the one at the
+    #   given index.
+    def [](id)
+      event_at(id, Ray::Event.new) if id >= 0
+    end
+
+    def empty?
+      size == 0
+    end
+  end
+end
@@ -4,5 +4,47 @@ module Ray
 
     extend Ray::ResourceSet
     add_set(/^(.*)$/) { |filename| new(filename) }
+
+    # Loads glyphs ahead of time, so that they don't need to be rendered while
+    # drawing a text for the first time.
+    #
+    # Glyphs are rendered first and then packed, tallest first, which uses less
+    # space than loading them one by one. Their images are only uploaded the
+    # next time they are used.
+    #
+    # @param [Integer] size Size of the font
+    # @param [String, Range, Integer, Array] chars Characters to load. Strings
+    #   are split into characters; ranges and integers are codepoints (or
+    #   one-character strings, for ranges).
+    # @param [true, false] bold True to load bold glyphs
+    #
+    # @return [Integer] Amount of glyphs that were loaded
+    #
+    # @example
+    #   font.preload 20, 32..126
+    #   font.preload 20, "àéèêëîïôùûüç"
+    def preload(size, chars, bold = false)
+      preload_ranges(size, codepoint_ranges(chars), bold)
+    end
+
+    private
+    def codepoint_ranges(chars)
+      case chars
+      when Array
+        chars.inject([]) { |ary, obj| ary.concat codepoint_ranges(obj) }
+      when Range
+        first, last = [chars.first, chars.last].map do |c|
+          c.is_a?(String) ? c.unpack("U").first : c.to_int
+        end
+
+        last -= 1 if chars.exclude_end?
+        last >= first ? [[first, last]] : []
+      when String
+        chars = chars.encode("UTF-8") if chars.respond_to? :encode
+        chars.unpack("U*").map { |c| [c, c] }
+      else
+        [[chars.to_int, chars.to_int]]
+      end
+    end
   end
 end
@@ -4,7 +4,112 @@ module Ray
     include Ray::PP
 
     extend Ray::ResourceSet
-    add_set(/^(.*)$/) { |filename| new(filename) }
+    add_set(/^(.*)$/) do |filename|
+      if job = prefetched.delete(filename)
+        job.load_into(new([1, 1]))
+      else
+        new(filename)
+      end
+    end
+
+    class AsyncLoad
+      # @return [String] Name of the file being loaded
+      attr_reader :filename
+
+      # @return [Ray::Image] The loaded image, waiting for it if needed.
+      # @raise [RuntimeError] If the file couldn't be decoded.
+      def image
+        @image ||= load_into(Ray::Image.new([1, 1]))
+      end
+
+      def inspect
+        "#<#{self.class} filename=#{filename.inspect} done=#{done?}>"
+      end
+    end
+
+    class << self
+      # @group Loading images in the background
+
+      # Starts decoding an image file in a background thread.
+      #
+      # The image is created when {process_async} notices the file has been
+      # decoded, and passed to the block then. {AsyncLoad#image} can also be
+      # used to wait for it.
+      #
+      # @param [String] filename
+      # @yield [image] Called from {process_async} once the image is loaded
+      # @yieldparam [Ray::Image] image
+      #
+      # @return [Ray::Image::AsyncLoad]
+      def load_async(filename, &block)
+        job = AsyncLoad.new(filename)
+        pending_loads << [job, block]
+        job
+      end
+
+      # Creates the images whose files have been decoded since the last call
+      # and uploads them to the GPU. This should be called once per frame, from
+      # the thread running the game.
+      #
+      # @param [Integer, nil] budget Maximum amount of pixel data to upload, in
+      #   bytes. At least one image is processed if one is ready. No limit if
+      #   nil.
+      #
+      # @return [Integer] Amount of images that were processed
+      def process_async(budget = nil)
+        count = 0
+
+        pending_loads.delete_if do |job, block|
+          next false if budget && budget <= 0
+          next false unless job.done?
+
+          budget -= job.byte_size if budget
+          count  += 1
+
+          img = begin
+                  job.image
+                rescue RuntimeError
+                  nil
+                end
+
+          block.call(img) if block
+
+          true
+        end
+
+        count
+      end
+
+      # @return [Integer] Amount of images passed to {load_async} that haven't
+      #   been processed yet
+      def pending_async_count
+        pending_loads.size
+      end
+
+      # Starts decoding files in the background so that using {Ray::Image.[]}
+      # on them later doesn't have to wait for them to be decoded.
+      #
+      # @param [Array<String>] filenames
+      def prefetch(*filenames)
+        filenames.flatten.each do |filename|
+          next if prefetched.has_key?(filename)
+          prefetched[filename] = AsyncLoad.new(filename)
+        end
+
+        self
+      end
+
+      # @endgroup
+
+      private
+      def pending_loads
+        @pending_loads ||= []
+      end
+
+      def prefetched
+        @prefetched ||= {}
+      end
+    end
 
     # @group Iterating over an image
 
@@ -111,7 +216,7 @@ module Ray
     end
 
     def pretty_print(q)
-      pretty_print_attributes q, ["size", "smooth?"]
+      pretty_print_attributes q, ["size", "smooth?", "mipmapped?"]
     end
 
     alias w width
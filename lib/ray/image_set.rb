@@ -11,6 +11,13 @@ module Ray
         super(&block)
         Ray::Image.select!(&block)
       end
+
+      # Starts decoding image files in the background.
+      # @see Ray::Image.prefetch
+      def prefetch(*filenames)
+        Ray::Image.prefetch(*filenames)
+        self
+      end
     end
   end
 
@@ -42,10 +42,12 @@ require 'ray/window'
 require 'ray/image_target'
 
 require 'ray/event'
+require 'ray/event_buffer'
 
 require 'ray/drawable'
 require 'ray/polygon'
 require 'ray/sprite'
+require 'ray/sprite_batch'
 require 'ray/text'
 require 'ray/turtle'
 
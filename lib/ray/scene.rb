@@ -65,10 +65,32 @@ module Ray
   #   self.loops_per_second = 30 # will sleep some time after each loop
   # This defaults to 60.
   #
+  # The way the scene waits between frames is set by #frame_pacing=. By
+  # default, it sleeps (see Ray::Clock.sleep). It may also rely on vertical
+  # synchronization, or not wait at all.
+  #
+  # == Fixed timestep
+  # By default, the always block runs once per frame. Setting a fixed timestep
+  # makes it run at a constant rate instead, as many times as needed to catch
+  # up with the time spent rendering:
+  #   self.fixed_timestep = 1.0 / 120
+  # #interpolation_alpha then tells how far the rendered frame is between the
+  # last two updates.
+  #
+  # Timing of the last frame is available through #frame_stats.
+  #
   # @see Ray::DSL::EventTranslator
   class Scene
     include Ray::Helper
 
+    # Durations, in seconds, measured during the last frame.
+    FrameStats = Struct.new(:frame_time, :update_time, :render_time,
+                            :sleep_time, :update_steps)
+
+    # Time that is simulated at most per frame when using a fixed timestep,
+    # so that a slow frame doesn't cause even more updates on the next one.
+    MaxFrameTime = 0.25
+
     class << self
       # Registers a scene to a game object, used for subclasses.
       def bind(game)
@@ -106,6 +128,12 @@ module Ray
       @scene_loops_per_second = 60
       @scene_animations       = Ray::AnimationList.new
       @scene_arguments        = []
+      @scene_coalesce_motion  = false
+      @scene_fixed_timestep   = nil
+      @scene_alpha            = 0.0
+      @scene_frame_pacing     = :sleep
+      @scene_frame_pacing_set = false
+      @scene_frame_stats      = FrameStats.new(0.0, 0.0, 0.0, 0.0, 0)
     end
 
     def register_events
@@ -131,17 +159,50 @@ module Ray
     # This will also raise events if the mouse moves, ... allowing you
     # to directly listen to a such event.
     def run
+      # The window's own vsync setting is kept unless a pacing mode was chosen
+      if @scene_frame_pacing_set
+        @scene_window.vsync = (@scene_frame_pacing == :vsync)
+      end
+
+      stats       = @scene_frame_stats
+      last_frame  = Ray::Clock.now
+      accumulator = 0.0
+
       until @scene_exit
-        loop_start = Time.now
+        frame_start = Ray::Clock.now
+        delta       = frame_start - last_frame
+        last_frame  = frame_start
+
+        collect_events
+
+        if step = @scene_fixed_timestep
+          accumulator += delta
+          accumulator  = MaxFrameTime if accumulator > MaxFrameTime
+
+          steps = 0
+          while accumulator >= step
+            update_tick(step)
+            accumulator -= step
+            steps += 1
+          end
+
+          @scene_alpha = accumulator / step
+        else
+          update_tick(delta)
+          steps = 1
+        end
 
-        run_tick
+        render_start = Ray::Clock.now
+        render_tick
+        render_end = Ray::Clock.now
 
-        if @scene_loops_per_second
-          ellapsed_time = Time.now - loop_start
-          time_per_loop = 1.0 / @scene_loops_per_second
+        pace_frame(frame_start)
 
-          sleep(time_per_loop - ellapsed_time) if ellapsed_time < time_per_loop
-        end
+        stats.frame_time   = delta
+        stats.update_time  = render_start - frame_start
+        stats.render_time  = render_end - render_start
+        stats.sleep_time   = Ray::Clock.now - render_end
+        stats.update_steps = steps
       end
 
       clean_up
@@ -151,19 +212,12 @@ module Ray
     # and drawing on the window.
     #
     # @param [true, false] check_events True to check for events
-    def run_tick(check_events = true)
+    # @param [Float, nil] delta Duration of the tick, used to advance
+    #   animations. If nil, animations measure it themselves.
+    def run_tick(check_events = true, delta = nil)
       collect_events if check_events
-
-      @scene_animations.update
-      @scene_always_block.call if @scene_always_block
-
-      listener_runner.run
-
-      @scene_animations.remove_unused
-
-      @scene_window.clear Ray::Color.none
-      render @scene_window
-      @scene_window.update
+      update_tick(delta)
+      render_tick
     end
 
     # Runs another scene over the current one.
@@ -288,9 +342,72 @@ module Ray
     alias :frames_per_second :loops_per_second
     alias :frames_per_second= :loops_per_second=
 
+    # @return [Float, nil] Time simulated by each update, or nil if the scene
+    #   is updated once per frame.
+    def fixed_timestep
+      @scene_fixed_timestep
+    end
+
+    # @param [Float, nil] val New timestep in seconds, or nil to update once
+    #   per frame.
+    def fixed_timestep=(val)
+      @scene_fixed_timestep = val
+    end
+
+    # @return [Float] Fraction of a timestep elapsed since the last update,
+    #   between 0 and 1. Used to interpolate between states when rendering.
+    #   Always 0 when no fixed timestep is used.
+    def interpolation_alpha
+      @scene_alpha
+    end
+
+    # @return [Symbol] How the scene waits between frames.
+    def frame_pacing
+      @scene_frame_pacing
+    end
+
+    # Setting this also enables or disables vertical synchronization on the
+    # window when the scene runs; otherwise, the window's setting is kept.
+    #
+    # @param [Symbol] val :sleep to wait until the next frame according to
+    #   #loops_per_second, :vsync to rely on vertical synchronization, or :none
+    #   not to wait at all.
+    def frame_pacing=(val)
+      unless [:sleep, :vsync, :none].include? val
+        raise ArgumentError, "unknown frame pacing mode: #{val.inspect}"
+      end
+
+      @scene_frame_pacing     = val
+      @scene_frame_pacing_set = true
+    end
+
+    # @return [FrameStats] Timing of the last frame. The same object is
+    #   updated after each frame.
+    def frame_stats
+      @scene_frame_stats
+    end
+
+    # @return [Float] Frames per second, based on the duration of the last
+    #   frame.
+    def fps
+      time = @scene_frame_stats.frame_time
+      time > 0 ? 1 / time : 0.0
+    end
+
     # The arguments passed to the scene with push_scene
     attr_accessor :scene_arguments
 
+    # @return [true, false] True if consecutive mouse motions received during a
+    #   frame are merged into a single mouse_motion event. False by default.
+    def coalesce_mouse_motion?
+      @scene_coalesce_motion
+    end
+
+    # @param [true, false] val
+    def coalesce_mouse_motion=(val)
+      @scene_coalesce_motion = val
+    end
+
     # @return [Ray::AnimationList] An animation list automatically updated by
     #   the scene.
     def animations
@@ -298,8 +415,33 @@ module Ray
     end
 
     private
+    # Runs the simulation once: animations, the always block, and event
+    # handlers. All the animations are advanced by the same delta.
+    def update_tick(delta)
+      @scene_animations.step(delta)
+      @scene_always_block.call if @scene_always_block
+
+      listener_runner.run
+    end
+
+    def render_tick
+      # Images loaded in the background are uploaded a few at a time
+      Ray::Image.process_async(4 * 1024 * 1024)
+
+      @scene_window.clear Ray::Color.none
+      render @scene_window
+      @scene_window.update
+    end
+
+    def pace_frame(frame_start)
+      return unless @scene_frame_pacing == :sleep && @scene_loops_per_second
+
+      remaining = 1.0 / @scene_loops_per_second - (Ray::Clock.now - frame_start)
+      Ray::Clock.sleep(remaining) if remaining > 0
+    end
+
     def collect_events
-      window.each_event do |ev|
+      window.each_event(@scene_coalesce_motion) do |ev|
         raise_event(*DSL::EventTranslator.translate_event(ev))
       end
     end
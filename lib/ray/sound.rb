@@ -1,5 +1,34 @@
 module Ray
   class Sound
+    # Files longer than this (in seconds) are streamed by {Sound.load}.
+    StreamThreshold = 10
+
+    # Loads a sound effect, streaming it from disk if it is long enough that
+    # decoding it entirely would waste memory.
+    #
+    # @param [String] filename
+    # @param [Hash] opts
+    # @option opts [Float] :stream_above (StreamThreshold) Duration above which
+    #   the file is streamed.
+    #
+    # Other options are passed to {SoundBuffer#initialize} when the file is
+    # fully decoded.
+    #
+    # @return [Ray::Sound, Ray::Music] A music for long files, a sound
+    #   otherwise.
+    def self.load(filename, opts = {})
+      buffer_opts = opts.dup
+      threshold   = buffer_opts.delete(:stream_above) || StreamThreshold
+
+      if SoundBuffer.duration_of(filename) > threshold
+        Ray::Music.new(filename)
+      elsif buffer_opts.empty?
+        new filename
+      else
+        new SoundBuffer.new(filename, buffer_opts)
+      end
+    end
+
     def initialize(arg = nil)
       case arg
       when String      then self.buffer = SoundBufferSet[arg]
@@ -11,7 +40,7 @@ module Ray
     end
 
     def pretty_print(q)
-      super q, ["time", "duration", "looping?", "buffer"]
+      super q, ["time", "duration", "looping?", "priority", "buffer"]
     end
 
     alias time= seek
@@ -0,0 +1,86 @@
+module Ray
+  class SpriteBatch < Drawable
+    include Enumerable
+
+    # Creates a sprite batch.
+    #
+    # @param [String, Ray::Image] img The image shared by all the sprites.
+    def initialize(img = nil)
+      self.image = img.is_a?(String) ? Ray::ImageSet[img] : img
+    end
+
+    # Adds a sprite to the batch.
+    #
+    # @option opts [Ray::Vector2, #to_vector2] :at ((0, 0)) Position of the
+    #   sprite
+    # @option opts [Ray::Rect, Array<Integer>] :rect Rect of the image which
+    #   will be drawn. Defaults to the whole image.
+    # @option opts [Float] :angle (0) Rotation of the sprite, in degrees
+    # @option opts [Ray::Vector2] :zoom ((1, 1)) Scale of the sprite
+    # @option opts [Ray::Vector2] :scale Alias for :zoom
+    # @option opts [Ray::Vector2] :origin ((0, 0)) The origin of
+    #   transformations
+    # @option opts [Ray::Color] :color (Ray::Color.white) Color multiplying
+    #   each pixel of the sprite.
+    #
+    # @return [Integer] Index of the new sprite
+    def add(opts = {})
+      add_sprite(*sprite_args(default_sprite.merge(opts)))
+    end
+
+    # Same as {#add}, but returns self.
+    def push(opts = {})
+      add opts
+      self
+    end
+
+    alias << push
+
+    # @param [Integer] id
+    # @return [Hash] Attributes of the id-th sprite (see {#add})
+    def [](id)
+      pos, rect, scale, origin, angle, color = sprite_at(id)
+      {:at => pos, :rect => rect, :scale => scale, :origin => origin,
+        :angle => angle, :color => color}
+    end
+
+    # Changes some attributes of a sprite.
+    #
+    # @param [Integer] id
+    # @param [Hash] opts Attributes to change (see {#add})
+    def []=(id, opts)
+      opts = opts.merge(:scale => opts[:zoom]) if opts[:zoom] && !opts[:scale]
+      set_sprite(id, *sprite_args(self[id].merge(opts)))
+    end
+
+    # Yields the attributes of each sprite.
+    def each
+      return to_enum(:each) unless block_given?
+
+      size.times { |i| yield self[i] }
+      self
+    end
+
+    def pretty_print(q, other_attr = [])
+      super q, ["image", "size"] + other_attr
+    end
+
+    private
+    def default_sprite
+      img = image
+      {
+        :at     => Ray::Vector2[0, 0],
+        :rect   => img ? Ray::Rect[0, 0, img.w, img.h] : Ray::Rect[0, 0, 0, 0],
+        :angle  => 0,
+        :zoom   => Ray::Vector2[1, 1],
+        :color  => Ray::Color.white,
+        :origin => Ray::Vector2[0, 0]
+      }
+    end
+
+    def sprite_args(opts)
+      [opts[:at], opts[:rect], opts[:scale] || opts[:zoom], opts[:origin],
+       opts[:angle], opts[:color]]
+    end
+  end
+end
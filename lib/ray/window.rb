@@ -9,15 +9,18 @@ module Ray
 
     alias size= resize
 
+    # Events are retrieved in batches, see {#poll_events}.
+    #
+    # @param [true, false] coalesce_motion (see #poll_events)
     # @yieldparam [Ray::Event] event Each event to be processed
-    def each_event
-      return Enumerator.new(self, :each_event) unless block_given?
+    def each_event(coalesce_motion = false)
+      return Enumerator.new(self, :each_event, coalesce_motion) unless block_given?
 
-      ev = Ray::Event.new
+      buffer = (@event_buffer ||= Ray::EventBuffer.new)
 
-      until poll_event(ev).type == Ray::Event::TypeNone
-        yield ev
-      end
+      begin
+        poll_events(buffer, coalesce_motion).each { |ev| yield ev }
+      end while buffer.size == buffer.capacity
     end
   end
 end
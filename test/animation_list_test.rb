@@ -96,6 +96,25 @@ context "an animation list" do
     end
   end
 
+  context "with an animation ending during #step" do
+    hookup do
+      @anim = float_variation(:of => 10, :duration => 1,
+                              :attribute => :r).start(Ray::Color.red)
+      topic << @anim
+      topic.step 2
+    end
+
+    denies :empty?
+    asserts(:to_a).equals { [@anim] }
+    denies("animation running") { @anim.running? }
+
+    context "and another #step" do
+      hookup { topic.step 1 }
+
+      asserts :empty?
+    end
+  end
+
   context "with several animations" do
     hookup do
       @anims = Array.new(5) do
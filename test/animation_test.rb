@@ -78,6 +78,56 @@ context "a random animation" do
       asserts_topic.received :update_target
     end
   end
+
+  context "running for 10 seconds" do
+    hookup do
+      topic.duration = 10
+      topic.start Object.new
+    end
+
+    context "updated with a delta" do
+      hookup { topic.update 4 }
+
+      asserts(:elapsed).equals 4
+      asserts(:progression).equals 0.4
+      asserts :running?
+
+      asserts("end time") {
+        topic.end_time - Time.now
+      }.almost_equals 6, 0.1
+
+      context "and then without a delta" do
+        hookup { topic.update }
+
+        asserts("elapsed time") { topic.elapsed }.almost_equals 4, 0.1
+      end
+
+      context "and then without a delta a bit later" do
+        hookup do
+          sleep 0.05
+          topic.update
+        end
+
+        # The delta was more than the time that passed, which isn't lost
+        asserts("elapsed time") { topic.elapsed > 4 }
+      end
+
+      context "paused and updated again" do
+        hookup do
+          topic.pause
+          topic.update 4
+        end
+
+        asserts(:elapsed).equals 4
+      end
+
+      context "until the end" do
+        hookup { topic.update 6 }
+
+        denies :running?
+      end
+    end
+  end
 end
 
 run_tests if __FILE__ == $0
@@ -0,0 +1,91 @@
+require File.expand_path(File.dirname(__FILE__)) + '/helpers.rb'
+require 'weakref'
+
+context "an atlas" do
+  green = Ray::Image.new [10, 10]
+  green.map! { Ray::Color.green }
+
+  blue = Ray::Image.new [10, 10]
+  blue.map! { Ray::Color.blue }
+
+  setup { Ray::Atlas.new [256, 256] }
+
+  asserts(:size).equals 0
+  asserts(:page_count).equals 0
+
+  asserts("adding an image larger than a page") {
+    topic.add Ray::Image.new([512, 16])
+  }.raises_kind_of RuntimeError
+
+  context "with images" do
+    hookup { topic << green << blue }
+
+    asserts(:size).equals 2
+    asserts(:page_count).equals 1
+
+    asserts("first image is packed") { topic.include? green }
+    asserts("second image is packed") { topic.include? blue }
+
+    asserts("size of the page") { topic.page(0).size }.equals Ray::Vector2[256, 256]
+
+    asserts("pixels of the images") {
+      [green[5, 5], blue[5, 5]]
+    }.equals [Ray::Color.green, Ray::Color.blue]
+
+    context "drawn with sprites" do
+      img = Ray::Image.new [50, 50]
+      target = Ray::ImageTarget.new img
+
+      hookup do
+        # Render stats are only counted by the render queue
+        target.render_queue = true
+        target.reset_render_stats
+        target.clear Ray::Color.red
+
+        target.draw Ray::Sprite.new(green, :at => [0, 0])
+        target.draw Ray::Sprite.new(blue,  :at => [10, 0])
+        target.draw Ray::Sprite.new(green, :at => [20, 0])
+
+        target.update
+      end
+
+      asserts("colors of sprites") {
+        [img[5, 5], img[15, 5], img[25, 5]]
+      }.equals [Ray::Color.green, Ray::Color.blue, Ray::Color.green]
+
+      asserts("color outside of sprites") { img[5, 15] }.equals Ray::Color.red
+      asserts("draw calls") { target.render_stats[:draw_calls] }.equals 1
+    end
+
+    context "after removing an image" do
+      hookup { topic.remove blue }
+
+      asserts(:size).equals 1
+      denies("removed image is packed") { topic.include? blue }
+    end
+  end
+
+  context "after filling a page" do
+    hookup do
+      5.times { topic << Ray::Image.new([200, 200]) }
+    end
+
+    asserts(:size).equals 5
+    asserts(:page_count).equals 5
+  end
+end if Ray::ImageTarget.available?
+
+context "an image packed in an atlas that isn't referenced anymore" do
+  setup do
+    image = Ray::Image.new [10, 10]
+    atlas = WeakRef.new(Ray::Atlas.new.add(image))
+    GC.start
+
+    [image, atlas]
+  end
+
+  asserts("atlas is still alive") { topic[1].weakref_alive? }
+  asserts("image is packed") { topic[1].include? topic[0] }
+end if Ray::ImageTarget.available?
+
+run_tests if __FILE__ == $0
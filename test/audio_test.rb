@@ -41,6 +41,84 @@ context Ray::SoundBuffer do
   }.raises_kind_of Exception
 end
 
+context "a sound buffer without samples" do
+  setup { Ray::SoundBuffer.new(path_of("pop.wav"), :keep_samples => false) }
+
+  denies(:keep_samples?)
+  asserts(:duration).equals Ray::SoundBuffer[path_of("pop.wav")].duration
+  asserts(:channel_count).equals Ray::SoundBuffer[path_of("pop.wav")].channel_count
+
+  asserts "is shared with buffers loaded from the same file" do
+    other = Ray::SoundBuffer.new(path_of("pop.wav"), :keep_samples => false)
+    topic.shared? && other.shared?
+  end
+
+  asserts("duration read from the header") {
+    Ray::SoundBuffer.duration_of(path_of("pop.wav"))
+  }.almost_equals Ray::SoundBuffer[path_of("pop.wav")].duration, 1e-3
+end
+
+context "a converted sound buffer" do
+  setup do
+    Ray::SoundBuffer.new(path_of("pop.wav"), :channels => 2, :gain => 0.5)
+  end
+
+  asserts(:channel_count).equals 2
+  asserts(:duration).equals Ray::SoundBuffer[path_of("pop.wav")].duration
+
+  asserts("sample rate without resampling") {
+    Ray::SoundBuffer.new(path_of("pop.wav")).sample_rate
+  }.equals 44100
+end
+
+context "a sound buffer converted from known samples" do
+  # One second of a stereo sound at 11025 Hz
+  wav = wav_data([1000, -200] * 11025, 2, 11025)
+
+  setup do
+    Ray::SoundBuffer.new(StringIO.new(wav), :channels => 1, :gain => 0.5)
+  end
+
+  asserts(:sample_rate).equals 11025
+  asserts("sample count") { topic.samples.size }.equals 11025
+  asserts("mixed down samples with gain") { topic.samples.uniq }.equals [200]
+
+  context "and resampled" do
+    setup do
+      Ray::SoundBuffer.new(StringIO.new(wav), :channels => 1, :gain => 0.5,
+                           :resample => true)
+    end
+
+    asserts("duration at the new rate") {
+      topic.samples.size.to_f / topic.sample_rate
+    }.almost_equals 1.0, 1e-3
+
+    asserts("constant samples are kept") {
+      topic.samples[10...-10].uniq
+    }.equals [200]
+  end
+end
+
+context "a 5.1 sound buffer at a low sample rate" do
+  setup do
+    wav = wav_data([0, 1000, -1000, 0, 500, -500] * 11025, 6, 11025)
+    Ray::SoundBuffer.new(StringIO.new(wav))
+  end
+
+  asserts(:duration).almost_equals 1.0, 1e-3
+  asserts("channel count") { [2, 6].include? topic.channel_count }
+end
+
+context "a sound loaded with Sound.load" do
+  asserts("short files are fully decoded") {
+    Ray::Sound.load(path_of("pop.wav"))
+  }.kind_of Ray::Sound
+
+  asserts("long files are streamed") {
+    Ray::Sound.load(path_of("pop.wav"), :stream_above => 0)
+  }.kind_of Ray::Music
+end
+
 context "an audio source" do
   setup { Ray::Sound.new path_of("pop.wav") }
 
@@ -100,6 +178,49 @@ context "a sound" do
     hookup { topic.looping = true }
     asserts(:looping?)
   end
+
+  asserts(:priority).equals 0
+  denies(:voice?)
+
+  context "after changing priority" do
+    hookup { topic.priority = 5 }
+    asserts(:priority).equals 5
+  end
+end
+
+context "the voice pool" do
+  setup do
+    Ray::Audio.voice_count = 2
+
+    sounds = Array.new(3) do |i|
+      sound = Ray::Sound.new path_of("pop.wav")
+      sound.volume   = 0
+      sound.looping  = true
+      sound.priority = i
+      sound
+    end
+
+    sounds.each(&:play)
+    sounds
+  end
+
+  teardown do
+    topic.each(&:stop)
+    Ray::Audio.voice_count = 32
+  end
+
+  asserts("active voices") { Ray::Audio.active_voice_count }.equals 2
+  denies("lowest priority sound has a voice") { topic[0].voice? }
+  asserts("highest priority sounds have a voice") {
+    topic[1].voice? && topic[2].voice?
+  }
+
+  asserts "a sound with a lower priority can't steal a voice" do
+    sound = Ray::Sound.new path_of("pop.wav")
+    sound.priority = -1
+    sound.play
+    !sound.voice?
+  end
 end
 
 context "a music" do
@@ -119,6 +240,40 @@ context "a music" do
     hookup { topic.looping = true }
     asserts(:looping?)
   end
+
+  asserts(:buffer_count).equals 3
+  asserts(:buffer_size).equals 44100
+
+  context "after changing buffer settings" do
+    hookup do
+      topic.buffer_count = 4
+      topic.buffer_size  = 4096
+    end
+
+    asserts(:buffer_count).equals 4
+    asserts(:buffer_size).equals 4096
+    asserts(:time).equals 0
+  end
+
+  context "with too few buffers" do
+    hookup { topic.buffer_count = 1 }
+    asserts(:buffer_count).equals 2
+  end
+end
+
+context "a music at a low sample rate" do
+  path = File.join(Dir.tmpdir, "ray_test_music.wav")
+
+  setup do
+    File.open(path, "wb") { |io| io.write wav_data([0] * 11025, 1, 11025) }
+    Ray::Music.new path
+  end
+
+  asserts(:buffer_size).equals 11025
+
+  teardown do
+    File.delete path if File.exist? path
+  end
 end
 
 run_tests if __FILE__ == $0
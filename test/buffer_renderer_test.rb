@@ -17,6 +17,7 @@ context "a buffer renderer" do
   end
 
   asserts(:drawables).empty
+  denies(:streaming?)
 
   context "after adding drawables" do
     obj = Ray::Polygon.circle([100,100], 50)
@@ -35,4 +36,46 @@ context "a buffer renderer" do
   }.raises_kind_of Exception
 end
 
+context "a stream buffer renderer" do
+  img = Ray::Image.new [100, 100]
+
+  setup do
+    renderer = Ray::BufferRenderer.new :stream, Ray::Vertex
+
+    # Enough drawables to grow the buffers more than once
+    300.times do |i|
+      renderer << Ray::Polygon.rect([i % 100, 0, 1, 50], Ray::Color.green)
+    end
+
+    renderer.update
+    renderer
+  end
+
+  asserts("drawn pixels") do
+    target = Ray::ImageTarget.new img
+    target.clear Ray::Color.red
+    target.draw topic
+    target.update
+
+    [img[10, 10], img[90, 40], img[50, 75]]
+  end.equals [Ray::Color.green, Ray::Color.green, Ray::Color.red]
+
+  context "after being cleared and filled again" do
+    hookup do
+      topic.clear
+      topic << Ray::Polygon.rect([0, 50, 100, 50], Ray::Color.blue)
+      topic.update
+    end
+
+    asserts("drawn pixels") do
+      target = Ray::ImageTarget.new img
+      target.clear Ray::Color.red
+      target.draw topic
+      target.update
+
+      [img[10, 10], img[50, 75]]
+    end.equals [Ray::Color.red, Ray::Color.blue]
+  end
+end if Ray::ImageTarget.available?
+
 run_tests if __FILE__ == $0
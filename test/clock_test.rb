@@ -0,0 +1,26 @@
+require File.expand_path(File.dirname(__FILE__)) + '/helpers.rb'
+
+context "a clock" do
+  setup { Ray::Clock.new }
+
+  asserts(:elapsed).kind_of Float
+  asserts("elapsed time after sleeping is at least the sleep time") {
+    Ray::Clock.sleep 0.01
+    topic.elapsed >= 0.01
+  }
+
+  asserts("restarting returns the elapsed time and resets it") {
+    Ray::Clock.sleep 0.01
+    topic.restart >= 0.01 && topic.elapsed < 0.01
+  }
+end
+
+context "the current time" do
+  asserts("never goes backwards") {
+    a = Ray::Clock.now
+    b = Ray::Clock.now
+    b >= a
+  }
+end
+
+run_tests if __FILE__ == $0
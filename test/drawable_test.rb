@@ -110,12 +110,24 @@ context "a drawable" do
       asserts(:scale).equals Ray::Vector2[2, 0.5]
       asserts(:z).equals 9
 
+      asserts(:matrix).equals transformation_matrix
+
       asserts(:shader_attributes).equals attr
       asserts("shader_attributes are copied") do
         !(topic.shader_attributes.equal? attr)
       end
     end
 
+    context "after rotating it back and forth" do
+      hookup do
+        topic.angle = 45
+        topic.matrix
+        topic.angle = 90
+      end
+
+      asserts(:matrix).equals transformation_matrix
+    end
+
     context "and a custom matrix" do
       hookup do
         topic.matrix = Ray::Matrix.new
@@ -203,6 +215,44 @@ class CustomDrawable < Ray::Drawable
   end
 end
 
+context "several drawables" do
+  setup { Array.new(3) { Ray::Drawable.new } }
+
+  context "updated with packed positions" do
+    hookup do
+      Ray::Drawable.update_many(topic, [1, 2, 3, 4, 5, 6].pack("f*"))
+    end
+
+    asserts("positions") { topic.map(&:pos) }.equals {
+      [Ray::Vector2[1, 2], Ray::Vector2[3, 4], Ray::Vector2[5, 6]]
+    }
+
+    asserts("matrices") { topic.map(&:matrix) }.equals {
+      topic.map(&:default_matrix)
+    }
+  end
+
+  context "updated with arrays of angles and scales" do
+    hookup do
+      Ray::Drawable.update_many(topic, [0, 0, 10, 10, 20, 20],
+                                [0, 45, 90], [1, 1, 2, 2, 3, 3])
+    end
+
+    asserts("angles") { topic.map(&:angle) }.equals [0, 45, 90]
+    asserts("scales") { topic.map(&:scale) }.equals {
+      [Ray::Vector2[1, 1], Ray::Vector2[2, 2], Ray::Vector2[3, 3]]
+    }
+
+    asserts("matrices") { topic.map(&:matrix) }.equals {
+      topic.map(&:default_matrix)
+    }
+  end
+
+  asserts("a buffer that is too short") {
+    Ray::Drawable.update_many(topic, [1, 2])
+  }.raises ArgumentError
+end
+
 context "a custom drawable" do
   setup { CustomDrawable.new }
 
@@ -90,6 +90,36 @@ context "an event runner" do
 
     raise_event :event
   }.received(:event)
+
+  runner_asserts("sending an event matching a key") {
+    register_for :key_press, Ray::Key.new(:a)
+    raise_event :key_press, Ray::Event::KeyA
+  }.received(:key_press, Ray::Event::KeyA)
+
+  runner_denies("sending an event matching another key") {
+    register_for :key_press, Ray::Key.new(:a)
+    raise_event :key_press, Ray::Event::KeyB
+  }.received(:key_press, Ray::Event::KeyB)
+
+  runner_denies("sending an event with a different symbol argument") {
+    register_for :event, :foo
+    raise_event :event, :bar
+  }.received(:event, :bar)
+
+  asserts "handlers are called in the order they were registered in" do
+    [:default, :test].each { |o| @obj.remove_event_group o }
+    order = []
+
+    @obj.on(:event, :foo) { order << 1 }
+    @obj.on(:event)       { order << 2 }
+    @obj.on(:event, :foo) { order << 3 }
+    @obj.on(:event, /f/)  { order << 4 }
+
+    @obj.raise_event :event, :foo
+    topic.run
+
+    order == [1, 2, 3, 4]
+  end
 end
 
 context "an object with no raiser runner" do
@@ -0,0 +1,19 @@
+require File.expand_path(File.dirname(__FILE__)) + '/helpers.rb'
+
+context "an event buffer" do
+  setup { Ray::EventBuffer.new(16) }
+
+  asserts(:capacity).equals 16
+  asserts(:size).equals 0
+  asserts(:empty?)
+
+  asserts(:to_a).equals []
+  asserts(:[], 0).nil
+  asserts(:type_at, 0).nil
+  asserts(:event_at, 0, Ray::Event.new).nil
+
+  asserts("default capacity") { Ray::EventBuffer.new.capacity }.equals 256
+  asserts("empty buffer") { Ray::EventBuffer.new(0) }.raises_kind_of ArgumentError
+end
+
+run_tests if __FILE__ == $0
@@ -20,4 +20,31 @@ context Ray::Font do
   }.raises_kind_of RuntimeError
 end
 
+context "a font" do
+  setup { Ray::Font.new(path_of("VeraMono.ttf")) }
+
+  asserts("page count before loading glyphs") { topic.page_count(200) }.equals 0
+
+  context "after loading many large glyphs" do
+    hookup do
+      @first = Ray::Text.new("A", :size => 200, :font => topic).rect
+      Ray::Text.new(("B".."Z").to_a.join, :size => 200, :font => topic).rect
+    end
+
+    asserts("page count") { topic.page_count(200) > 1 }
+    asserts("preloading loaded glyphs") { topic.preload(200, "ABC") }.equals 0
+    asserts("size of the first glyph") {
+      Ray::Text.new("A", :size => 200, :font => topic).rect
+    }.equals { @first }
+  end
+
+  context "after preloading glyphs" do
+    hookup { @loaded = topic.preload(20, [32..126, "é"]) }
+
+    asserts("amount of loaded glyphs") { @loaded }.equals 96
+    asserts("preloading them again") { topic.preload(20, "a".."z") }.equals 0
+    asserts("page count") { topic.page_count(20) }.equals 1
+  end
+end if Ray::ImageTarget.available?
+
 run_tests if __FILE__ == $0
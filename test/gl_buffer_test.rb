@@ -65,4 +65,118 @@ context "a buffer with per-instance data" do
   end
 end
 
+context "global buffer statistics" do
+  setup do
+    img = Ray::Image.new [50, 50]
+    Ray::ImageTarget.new(img).draw Ray::Polygon.rect([0, 0, 10, 10])
+
+    Ray::GL.buffer_stats
+  end
+
+  asserts("number of buffers") { topic[:buffers] >= 1 }
+  asserts("allocated vertices") { topic[:allocated] >= topic[:used] }
+  asserts("capacity") { topic[:capacity] >= topic[:allocated] }
+
+  asserts("largest free block") {
+    topic[:largest_free_block] <= topic[:capacity] - topic[:allocated]
+  }
+
+  asserts("fragmentation") { (0..1).include? topic[:fragmentation] }
+end if Ray::ImageTarget.available?
+
+context "global buffers after updating disjoint slices" do
+  setup do
+    img    = Ray::Image.new [100, 1]
+    target = Ray::ImageTarget.new img
+    target.render_queue = true
+
+    polygons = (0...100).map do |i|
+      Ray::Polygon.rect([i, 0, 1, 1], Ray::Color.red)
+    end
+
+    polygons.each { |p| target.draw p }
+    target.update
+
+    # Every other slice gets updated, more than the amount of ranges kept
+    polygons.each_with_index do |p, i|
+      p.color = Ray::Color.green if i.even?
+      target.draw p
+    end
+    target.update
+
+    (0...100).map { |x| img[x, 0] }
+  end
+
+  asserts("updated slices") {
+    topic.each_slice(2).map(&:first).uniq
+  }.equals [Ray::Color.green]
+
+  asserts("untouched slices") {
+    topic.each_slice(2).map(&:last).uniq
+  }.equals [Ray::Color.red]
+end if Ray::ImageTarget.available?
+
+class BuddyDrawable < Ray::Drawable
+  # Big vertices, so that a buffer only holds a few thousands of them
+  Vertex = Ray::GL::Vertex.make((0...8).map { |i|
+    [:"attr#{i}", "attr#{i}", :vector3]
+  })
+
+  def initialize(count)
+    super Vertex
+    self.vertex_count = count
+  end
+
+  def fill_vertices
+    [Vertex.new] * vertex_count
+  end
+
+  def render(first, index)
+  end
+end
+
+context "global buffer statistics after freeing buddies" do
+  setup do
+    target = Ray::ImageTarget.new Ray::Image.new([10, 10])
+
+    a = BuddyDrawable.new 1
+    target.draw a
+
+    half = Ray::GL.buffer_stats(BuddyDrawable::Vertex)[:capacity] / 2
+    a.vertex_count = half
+    b = BuddyDrawable.new half
+    target.draw a
+    target.draw b
+
+    # Only keep the first vertex of each half, splitting them into small blocks
+    a.vertex_count = b.vertex_count = 1
+    target.draw a
+    target.draw b
+    split = Ray::GL.buffer_stats BuddyDrawable::Vertex
+
+    # Moving a to another buffer frees its block, which merges with its buddies
+    a.vertex_count = 2 * half
+    target.draw a
+    merged = Ray::GL.buffer_stats BuddyDrawable::Vertex
+
+    [half, split, merged]
+  end
+
+  asserts("largest free block once split") {
+    topic[1][:largest_free_block] == topic[0] / 2
+  }
+
+  asserts("largest free block once merged") {
+    topic[2][:largest_free_block] == topic[0]
+  }
+
+  asserts("free blocks decrease") {
+    topic[2][:free_blocks] < topic[1][:free_blocks]
+  }
+
+  asserts("fragmentation decreases") {
+    topic[2][:fragmentation] < topic[1][:fragmentation]
+  }
+end if Ray::ImageTarget.available?
+
 run_tests if __FILE__ == $0
@@ -8,6 +8,7 @@ require 'ray'
 
 require 'ostruct'
 require 'stringio'
+require 'tmpdir'
 
 include Math
 
@@ -19,6 +20,15 @@ def run_tests
   exit Riot.run.success?
 end
 
+# Builds a 16-bit PCM WAV file from interleaved samples
+def wav_data(samples, channels, rate)
+  data = samples.pack("s<*")
+
+  ["RIFF", 36 + data.bytesize, "WAVE",
+   "fmt ", 16, 1, channels, rate, rate * channels * 2, channels * 2, 16,
+   "data", data.bytesize].pack("a4Va4a4VvvVVvva4V") + data
+end
+
 def deg_to_rad(deg)
   deg * PI / 180
 end
@@ -14,6 +14,131 @@ context "an image target" do
 
     asserts("color of image") { img[0, 0] }.equals Ray::Color.red
   end
+
+  asserts(:batching?)
+
+  context "after drawing batched sprites" do
+    hookup do
+      green = Ray::Image.new [10, 10]
+      green.map! { Ray::Color.green }
+
+      topic.clear Ray::Color.red
+      topic.draw Ray::Sprite.new(green, :at => [0, 0])
+      topic.draw Ray::Sprite.new(green, :at => [20, 20])
+      topic.update
+    end
+
+    asserts("color of first sprite")  { img[5, 5] }.equals Ray::Color.green
+    asserts("color of second sprite") { img[25, 25] }.equals Ray::Color.green
+    asserts("color between sprites")  { img[15, 15] }.equals Ray::Color.red
+  end
+
+  context "after changing an image between two batched sprites" do
+    hookup do
+      image = Ray::Image.new [10, 10]
+      image.map! { Ray::Color.green }
+
+      topic.clear Ray::Color.red
+      topic.draw Ray::Sprite.new(image, :at => [0, 0])
+
+      image.map! { Ray::Color.blue }
+      topic.draw Ray::Sprite.new(image, :at => [20, 20])
+      topic.update
+    end
+
+    asserts("color of first sprite")  { img[5, 5] }.equals Ray::Color.green
+    asserts("color of second sprite") { img[25, 25] }.equals Ray::Color.blue
+  end
+
+  context "after changing a few pixels of a drawn image" do
+    hookup do
+      green = Ray::Image.new [10, 10]
+      green.map! { Ray::Color.green }
+
+      topic.clear Ray::Color.red
+      topic.draw Ray::Sprite.new(green)
+      topic.update
+
+      green[3, 4] = Ray::Color.blue
+      green[6, 7] = Ray::Color.blue
+
+      topic.draw Ray::Sprite.new(green)
+      topic.update
+    end
+
+    asserts("changed pixels") { [img[3, 4], img[6, 7]] }.equals [Ray::Color.blue] * 2
+    asserts("pixel in the changed region") { img[5, 5] }.equals Ray::Color.green
+    asserts("pixel out of the changed region") { img[8, 8] }.equals Ray::Color.green
+  end
+
+  denies(:render_queue?)
+
+  context "with a render queue" do
+    hookup do
+      topic.render_queue = true
+      topic.reset_render_stats
+
+      green = Ray::Image.new [10, 10]
+      green.map! { Ray::Color.green }
+
+      blue = Ray::Image.new [10, 10]
+      blue.map! { Ray::Color.blue }
+
+      topic.clear Ray::Color.red
+
+      4.times do |i|
+        image = i.even? ? green : blue
+        sprite = Ray::Sprite.new(image, :at => [i * 10, 0])
+        sprite.blend_mode = :none
+
+        topic.draw sprite
+      end
+
+      topic.update
+    end
+
+    asserts("colors of sprites") do
+      [img[5, 5], img[15, 5], img[25, 5], img[35, 5]]
+    end.equals [Ray::Color.green, Ray::Color.blue,
+                Ray::Color.green, Ray::Color.blue]
+
+    asserts("color outside of sprites") { img[5, 15] }.equals Ray::Color.red
+
+    asserts("drawables") { topic.render_stats[:drawables] }.equals 4
+    asserts("draw calls") { topic.render_stats[:draw_calls] }.equals 2
+    asserts("saved state changes") {
+      topic.render_stats[:saved_state_changes]
+    }.equals 2
+  end
+
+  context "with a render queue and overlapping sprites" do
+    hookup do
+      topic.render_queue = true
+
+      green = Ray::Image.new [10, 10]
+      green.map! { Ray::Color.green }
+
+      blue = Ray::Image.new [10, 10]
+      blue.map! { Ray::Color.blue }
+
+      topic.clear Ray::Color.red
+
+      3.times do |i|
+        image = i.even? ? green : blue
+        sprite = Ray::Sprite.new(image, :at => [i * 5, 0])
+        sprite.blend_mode = :none
+
+        topic.draw sprite
+      end
+
+      topic.update
+    end
+
+    asserts("colors of sprites") do
+      [img[2, 5], img[7, 5], img[12, 5], img[17, 5]]
+    end.equals [Ray::Color.green, Ray::Color.blue,
+                Ray::Color.green, Ray::Color.green]
+  end
 end if Ray::ImageTarget.available?
 
 run_tests if __FILE__ == $0
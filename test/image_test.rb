@@ -36,6 +36,36 @@ context "an image loaded from a file" do
   end
 end
 
+context "an empty image" do
+  setup { Ray::Image.new [10, 10] }
+
+  context "after filling a rect" do
+    hookup do
+      topic.fill_rect [0, 0, 10, 10], Ray::Color.red
+      topic.fill_rect [-2, 3, 4, 2], Ray::Color.green
+    end
+
+    asserts(:[], 0, 3).equals Ray::Color.green
+    asserts(:[], 1, 4).equals Ray::Color.green
+    asserts(:[], 2, 4).equals Ray::Color.red
+    asserts(:[], 0, 5).equals Ray::Color.red
+
+    context "and blitting an image" do
+      hookup do
+        src = Ray::Image.new [4, 4]
+        src.fill_rect [0, 0, 4, 4], Ray::Color.blue
+        src[1, 1] = Ray::Color.white
+
+        topic.blit src, [8, 8], [1, 1, 3, 3]
+      end
+
+      asserts(:[], 8, 8).equals Ray::Color.white
+      asserts(:[], 9, 9).equals Ray::Color.blue
+      asserts(:[], 7, 7).equals Ray::Color.red
+    end
+  end
+end
+
 context "an image loaded from an IO" do
   setup { open(path_of("sprite.png"), "rb") { |io| Ray::Image.new(io) } }
 
@@ -51,10 +81,10 @@ context "an image created from a size" do
   asserts(:height).equals 128
   asserts(:size).equals Ray::Vector2[64, 128]
 
-  asserts(:tex_rect, [0, 0, 64, 128]).equals Ray::Rect[0, 1, 1, -1]
-  asserts(:tex_rect, [0, 0, 32, 128]).equals Ray::Rect[0, 1, 0.5, -1]
-  asserts(:tex_rect, [0, 0, 64, 64]).equals Ray::Rect[0, 1, 1, -0.5]
-  asserts(:tex_rect, [32, 32, 32, 32]).equals Ray::Rect[0.5, 0.75, 0.5, -0.25]
+  asserts(:tex_rect, [0, 0, 64, 128]).equals Ray::Rect[0, 0, 1, 1]
+  asserts(:tex_rect, [0, 0, 32, 128]).equals Ray::Rect[0, 0, 0.5, 1]
+  asserts(:tex_rect, [0, 0, 64, 64]).equals Ray::Rect[0, 0, 1, 0.5]
+  asserts(:tex_rect, [32, 32, 32, 32]).equals Ray::Rect[0.5, 0.25, 0.5, 0.25]
 
   denies :smooth?
 
@@ -62,8 +92,63 @@ context "an image created from a size" do
     hookup { topic.smooth = true }
     asserts :smooth?
   end
+
+  denies :mipmapped?
+  asserts(:anisotropy).equals 1
+
+  context "after enabling mipmapping" do
+    hookup do
+      topic.mipmapped = true
+      topic[0, 0] = Ray::Color.red
+      topic.bind
+    end
+
+    asserts :mipmapped?
+    asserts(:[], 0, 0).equals Ray::Color.red
+  end
+
+  context "after setting an invalid anisotropy" do
+    hookup { topic.anisotropy = 0 }
+    asserts(:anisotropy).equals 1
+  end
+
+  context "after enabling anisotropic filtering" do
+    hookup { topic.anisotropy = 4 }
+    asserts("anisotropy") { topic.anisotropy > 1 }
+  end if Ray::Image.anisotropy_available?
 end
 
+context "a mipmapped image drawn scaled down" do
+  setup do
+    # Alternating columns of red and blue pixels
+    stripes = Ray::Image.new [64, 64]
+    stripes.map_with_pos! { |_, x, _| x.even? ? Ray::Color.red : Ray::Color.blue }
+    stripes.mipmapped = true
+
+    img    = Ray::Image.new [16, 16]
+    target = Ray::ImageTarget.new img
+    target.clear Ray::Color.none
+    target.draw Ray::Sprite.new(stripes, :scale => [1.0 / 8, 1.0 / 8])
+    target.update
+
+    img[4, 4]
+  end
+
+  # Only the smaller levels, which average the stripes, look purple
+  asserts("red component")  { (96..160).include? topic.r }
+  asserts("blue component") { (96..160).include? topic.b }
+end if Ray::ImageTarget.available?
+
+context "an image packed in an atlas" do
+  setup do
+    img = Ray::Image.new [4, 4]
+    Ray::Atlas.new << img
+    img
+  end
+
+  asserts(:mipmapped=, true).raises_kind_of RuntimeError
+end if Ray::ImageTarget.available?
+
 context "an image copy" do
   setup do
     img = Ray::Image.new [2, 2]
@@ -103,4 +188,110 @@ context "an image copy" do
   end
 end
 
+context "a compressed image" do
+  setup do
+    header = "DDS " + [124, 0x81007, 4, 4, 8, 0, 1].pack("V7") +
+      ([0] * 11).pack("V11") + [32, 4].pack("V2") + "DXT1" +
+      ([0] * 5).pack("V5") + [0x1000, 0, 0, 0, 0].pack("V5")
+
+    # Red block, with a blue second row
+    block = [0xF800, 0x001F].pack("v2") + [0x00, 0x55, 0x00, 0x00].pack("C4")
+
+    Ray::Image.new StringIO.new(header + block)
+  end
+
+  asserts(:size).equals Ray::Vector2[4, 4]
+
+  asserts(:[], 0, 0).equals Ray::Color.red
+  asserts(:[], 3, 0).equals Ray::Color.red
+  asserts(:[], 0, 1).equals Ray::Color.blue
+  asserts(:[], 3, 3).equals Ray::Color.red
+
+  context "after being modified" do
+    hookup { topic[0, 0] = Ray::Color.green }
+
+    denies :compressed?
+    asserts(:[], 0, 0).equals Ray::Color.green
+    asserts(:[], 0, 1).equals Ray::Color.blue
+  end
+end
+
+context "a truncated compressed image" do
+  setup { Ray::Image }
+
+  asserts(:new, StringIO.new("DDS " + [124].pack("V"))).raises_kind_of RuntimeError
+
+  asserts("new with huge dimensions") {
+    header = "DDS " + [124, 0x81007, 0xFFFFFFFF, 0xFFFFFFFF, 8, 0, 1].pack("V7") +
+      ([0] * 11).pack("V11") + [32, 4].pack("V2") + "DXT1" +
+      ([0] * 5).pack("V5") + [0x1000, 0, 0, 0, 0].pack("V5")
+
+    topic.new StringIO.new(header + "\0" * 8)
+  }.raises_kind_of RuntimeError
+end
+
+context "an image loaded in the background" do
+  setup { Ray::Image::AsyncLoad.new path_of("sprite.png") }
+
+  asserts(:filename).equals path_of("sprite.png")
+
+  context "once waited for" do
+    setup { topic.wait }
+
+    asserts(:done?)
+    denies(:failed?)
+    asserts(:byte_size).equals 128 * 192 * 4
+
+    asserts("image size") { topic.image.size }.equals Ray::Vector2[128, 192]
+    asserts("loaded pixels") {
+      img = Ray::Image.new path_of("sprite.png")
+      (0...img.h).step(16).all? { |y| topic.image[17, y] == img[17, y] }
+    }
+  end
+end
+
+context "an image that can't be loaded in the background" do
+  setup { Ray::Image::AsyncLoad.new path_of("pop.wav") }
+
+  asserts(:wait).equals { topic }
+  asserts(:failed?)
+  asserts(:image).raises_kind_of RuntimeError
+end
+
+context "a compressed image loaded in the background" do
+  setup do
+    header = "DDS " + [124, 0x81007, 4, 4, 8, 0, 1].pack("V7") +
+      ([0] * 11).pack("V11") + [32, 4].pack("V2") + "DXT1" +
+      ([0] * 5).pack("V5") + [0x1000, 0, 0, 0, 0].pack("V5")
+    block = [0xF800, 0x001F].pack("v2") + [0x00, 0x55, 0x00, 0x00].pack("C4")
+
+    @path = File.join(Dir.tmpdir, "ray_async_test.dds")
+    File.open(@path, "wb") { |io| io.write header + block }
+
+    Ray::Image::AsyncLoad.new(@path).wait
+  end
+
+  teardown { File.delete @path if File.exist? @path }
+
+  denies(:failed?)
+  asserts(:byte_size).equals 128 + 8
+
+  asserts("image size") { topic.image.size }.equals Ray::Vector2[4, 4]
+  asserts("first pixel") { topic.image[0, 0] }.equals Ray::Color.red
+end
+
+context "an image loaded through Image.load_async" do
+  setup do
+    @loaded = nil
+    job = Ray::Image.load_async(path_of("sprite.png")) { |img| @loaded = img }
+    job.wait
+
+    Ray::Image.process_async
+  end
+
+  asserts_topic.equals 1
+  asserts("loaded image") { @loaded.size }.equals Ray::Vector2[128, 192]
+  asserts("pending count") { Ray::Image.pending_async_count }.equals 0
+end
+
 run_tests if __FILE__ == $0
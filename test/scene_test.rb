@@ -18,6 +18,12 @@ context "a scene" do
   asserts(:animations).kind_of Ray::AnimationList
   asserts(:frames_per_second).equals 60
 
+  asserts(:fixed_timestep).nil
+  asserts(:interpolation_alpha).equals 0.0
+  asserts(:frame_pacing).equals :sleep
+  asserts(:frame_stats).kind_of Ray::Scene::FrameStats
+  asserts(:frame_pacing=, :blocking).raises_kind_of ArgumentError
+
   context "rendered with a custom rendering block" do
     hookup do
       @render_proc = proc { |win| }
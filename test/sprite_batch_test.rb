@@ -0,0 +1,65 @@
+require File.expand_path(File.dirname(__FILE__)) + '/helpers.rb'
+
+context "a sprite batch" do
+  img = Ray::Image.new [10, 10]
+  setup { Ray::SpriteBatch.new(img) }
+
+  asserts(:image).equals img
+  asserts(:size).equals 0
+
+  context "after adding sprites" do
+    hookup do
+      topic.add :at => [10, 20]
+      topic << {:at => [5, 5], :rect => [2, 2, 4, 4], :angle => 30}
+    end
+
+    asserts(:size).equals 2
+    asserts("position of the first sprite") { topic[0][:at] }.equals Ray::Vector2[10, 20]
+    asserts("rect of the first sprite") { topic[0][:rect] }.equals Ray::Rect[0, 0, 10, 10]
+    asserts("rect of the second sprite") { topic[1][:rect] }.equals Ray::Rect[2, 2, 4, 4]
+    asserts("angle of the second sprite") { topic[1][:angle] }.equals 30.0
+
+    context "and changing one" do
+      hookup { topic[0] = {:zoom => [2, 3]} }
+
+      asserts("scale of the first sprite") { topic[0][:scale] }.equals Ray::Vector2[2, 3]
+      asserts("position of the first sprite") { topic[0][:at] }.equals Ray::Vector2[10, 20]
+    end
+
+    asserts("accessing an unknown sprite") { topic[2] }.raises_kind_of IndexError
+
+    context "and clearing" do
+      hookup { topic.clear }
+      asserts(:size).equals 0
+    end
+  end
+end if Ray::ImageTarget.available? && Ray::SpriteBatch.available?
+
+context "an image target" do
+  img = Ray::Image.new [50, 50]
+  setup { Ray::ImageTarget.new img }
+
+  context "after drawing a sprite batch" do
+    hookup do
+      green = Ray::Image.new [10, 10]
+      green.map! { Ray::Color.green }
+
+      batch = Ray::SpriteBatch.new green
+      batch.add :at => [0, 0]
+      batch.add :at => [20, 20]
+      batch.add :at => [40, 0], :origin => [5, 5], :scale => [0.5, 0.5]
+
+      topic.clear Ray::Color.red
+      topic.draw batch
+      topic.update
+    end
+
+    asserts("color of first sprite")  { img[5, 5] }.equals Ray::Color.green
+    asserts("color of second sprite") { img[25, 25] }.equals Ray::Color.green
+    asserts("color between sprites")  { img[15, 15] }.equals Ray::Color.red
+    asserts("color in scaled sprite") { img[39, 1] }.equals Ray::Color.green
+    asserts("color out of scaled sprite") { img[44, 1] }.equals Ray::Color.red
+  end
+end if Ray::ImageTarget.available? && Ray::SpriteBatch.available?
+
+run_tests if __FILE__ == $0